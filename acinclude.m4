@@ -4,7 +4,29 @@ dnl Version: 20240520
 
 dnl Function to detect if libfdata dependencies are available
 AC_DEFUN([AX_LIBFDATA_CHECK_LOCAL],
-  [dnl No additional checks.
+  [dnl Headers included in libfdata/libfdata_latency_histogram.c
+  AC_CHECK_HEADERS([sys/time.h])
+
+  dnl Date and time functions used in libfdata/libfdata_latency_histogram.c
+  AC_CHECK_FUNCS([clock_gettime])
+  ])
+
+dnl Function to detect whether IO statistics should be enabled
+AC_DEFUN([AX_LIBFDATA_CHECK_ENABLE_IO_STATISTICS],
+  [AX_COMMON_ARG_ENABLE(
+    [io-statistics],
+    [io_statistics],
+    [enable stream IO statistics],
+    [no])
+
+  AS_IF(
+    [test "x$ac_cv_enable_io_statistics" != xno ],
+    [AC_DEFINE(
+      [HAVE_IO_STATISTICS],
+      [1],
+      [Define to 1 if stream IO statistics should be maintained.])
+
+    ac_cv_enable_io_statistics=yes])
   ])
 
 dnl Function to check if DLL support is needed
@@ -0,0 +1,183 @@
+/*
+ * The allocator functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_allocator.h"
+#include "libfdata_libcerror.h"
+
+/* The allocate function or NULL if not set
+ */
+void *(*libfdata_allocator_allocate_function)(
+         intptr_t *allocator_data,
+         size_t size ) = NULL;
+
+/* The reallocate function or NULL if not set
+ */
+void *(*libfdata_allocator_reallocate_function)(
+         intptr_t *allocator_data,
+         void *memory,
+         size_t size ) = NULL;
+
+/* The free function or NULL if not set
+ */
+void (*libfdata_allocator_free_function)(
+       intptr_t *allocator_data,
+       void *memory ) = NULL;
+
+/* The allocator data passed to the allocator functions
+ */
+intptr_t *libfdata_allocator_data = NULL;
+
+/* Sets the allocator functions
+ * The allocator functions are used for all memory allocated by the library,
+ * either all functions must be set or none, in which case the system allocator is used
+ * The functions should be set before any library object is created and not changed
+ * while library objects exist, since memory must be freed by the allocator that allocated it
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_allocator_set_functions(
+     void *(*allocate_function)(
+              intptr_t *allocator_data,
+              size_t size ),
+     void *(*reallocate_function)(
+              intptr_t *allocator_data,
+              void *memory,
+              size_t size ),
+     void (*free_function)(
+            intptr_t *allocator_data,
+            void *memory ),
+     intptr_t *allocator_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_allocator_set_functions";
+
+	if( ( allocate_function == NULL )
+	 && ( reallocate_function == NULL )
+	 && ( free_function == NULL ) )
+	{
+		libfdata_allocator_allocate_function   = NULL;
+		libfdata_allocator_reallocate_function = NULL;
+		libfdata_allocator_free_function       = NULL;
+		libfdata_allocator_data                = NULL;
+
+		return( 1 );
+	}
+	if( allocate_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocate function.",
+		 function );
+
+		return( -1 );
+	}
+	if( reallocate_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reallocate function.",
+		 function );
+
+		return( -1 );
+	}
+	if( free_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid free function.",
+		 function );
+
+		return( -1 );
+	}
+	libfdata_allocator_allocate_function   = allocate_function;
+	libfdata_allocator_reallocate_function = reallocate_function;
+	libfdata_allocator_free_function       = free_function;
+	libfdata_allocator_data                = allocator_data;
+
+	return( 1 );
+}
+
+/* Allocates memory
+ * Returns a pointer to the allocated memory or NULL on error
+ */
+void *libfdata_allocator_allocate(
+       size_t size )
+{
+	if( libfdata_allocator_allocate_function != NULL )
+	{
+		return( libfdata_allocator_allocate_function(
+		         libfdata_allocator_data,
+		         size ) );
+	}
+	return( memory_allocate(
+	         size ) );
+}
+
+/* Reallocates memory
+ * Returns a pointer to the reallocated memory or NULL on error
+ */
+void *libfdata_allocator_reallocate(
+       void *memory,
+       size_t size )
+{
+	if( libfdata_allocator_reallocate_function != NULL )
+	{
+		return( libfdata_allocator_reallocate_function(
+		         libfdata_allocator_data,
+		         memory,
+		         size ) );
+	}
+	return( memory_reallocate(
+	         memory,
+	         size ) );
+}
+
+/* Frees memory
+ */
+void libfdata_allocator_free(
+      void *memory )
+{
+	if( memory == NULL )
+	{
+		return;
+	}
+	if( libfdata_allocator_free_function != NULL )
+	{
+		libfdata_allocator_free_function(
+		 libfdata_allocator_data,
+		 memory );
+	}
+	else
+	{
+		memory_free(
+		 memory );
+	}
+}
+
@@ -0,0 +1,83 @@
+/*
+ * The allocator functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFDATA_ALLOCATOR_H )
+#define _LIBFDATA_ALLOCATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_extern.h"
+#include "libfdata_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define libfdata_allocator_allocate_structure( type ) \
+	(type *) libfdata_allocator_allocate( sizeof( type ) )
+
+extern void *(*libfdata_allocator_allocate_function)(
+               intptr_t *allocator_data,
+               size_t size );
+
+extern void *(*libfdata_allocator_reallocate_function)(
+               intptr_t *allocator_data,
+               void *memory,
+               size_t size );
+
+extern void (*libfdata_allocator_free_function)(
+             intptr_t *allocator_data,
+             void *memory );
+
+extern intptr_t *libfdata_allocator_data;
+
+LIBFDATA_EXTERN \
+int libfdata_allocator_set_functions(
+     void *(*allocate_function)(
+              intptr_t *allocator_data,
+              size_t size ),
+     void *(*reallocate_function)(
+              intptr_t *allocator_data,
+              void *memory,
+              size_t size ),
+     void (*free_function)(
+            intptr_t *allocator_data,
+            void *memory ),
+     intptr_t *allocator_data,
+     libcerror_error_t **error );
+
+void *libfdata_allocator_allocate(
+       size_t size );
+
+void *libfdata_allocator_reallocate(
+       void *memory,
+       size_t size );
+
+void libfdata_allocator_free(
+      void *memory );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_ALLOCATOR_H ) */
+
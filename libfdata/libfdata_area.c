@@ -23,17 +23,23 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_allocator.h"
 #include "libfdata_area.h"
+#include "libfdata_cache.h"
 #include "libfdata_definitions.h"
+#include "libfdata_latency_histogram.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_mapped_range.h"
+#include "libfdata_notify.h"
 #include "libfdata_range.h"
 #include "libfdata_segments_array.h"
+#include "libfdata_segments_table.h"
 #include "libfdata_types.h"
 #include "libfdata_unused.h"
+#include "libfdata_value_pool.h"
 
 /* Creates an area
  * Make sure the value area is referencing, is set to NULL
@@ -118,7 +124,7 @@ int libfdata_area_initialize(
 
 		return( -1 );
 	}
-	internal_area = memory_allocate_structure(
+	internal_area = libfdata_allocator_allocate_structure(
 	                 libfdata_internal_area_t );
 
 	if( internal_area == NULL )
@@ -144,40 +150,25 @@ int libfdata_area_initialize(
 		 "%s: unable to clear area.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_area );
 
 		return( -1 );
 	}
-	if( libcdata_array_initialize(
-	     &( internal_area->segments_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segments array.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcdata_array_initialize(
-	     &( internal_area->mapped_ranges_array ),
-	     0,
+	if( libfdata_segments_table_initialize(
+	     &( internal_area->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create mapped ranges array.",
+		 "%s: unable to create segments table.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_date_time_get_timestamp(
+	if( libfdata_cache_get_timestamp(
 	     &( internal_area->timestamp ),
 	     error ) != 1 )
 	{
@@ -205,14 +196,13 @@ int libfdata_area_initialize(
 on_error:
 	if( internal_area != NULL )
 	{
-		if( internal_area->segments_array != NULL )
+		if( internal_area->segments_table != NULL )
 		{
-			libcdata_array_free(
-			 &( internal_area->segments_array ),
-			 NULL,
+			libfdata_segments_table_free(
+			 &( internal_area->segments_table ),
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_area );
 	}
 	return( -1 );
@@ -245,33 +235,34 @@ int libfdata_area_free(
 		internal_area = (libfdata_internal_area_t *) *area;
 		*area         = NULL;
 
-		if( libcdata_array_free(
-		     &( internal_area->segments_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
+		if( libfdata_segments_table_free(
+		     &( internal_area->segments_table ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segments array.",
+			 "%s: unable to free segments table.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_array_free(
-		     &( internal_area->mapped_ranges_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-		     error ) != 1 )
+		if( internal_area->element_value_pool != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free mapped ranges array.",
-			 function );
+			if( libfdata_value_pool_free(
+			     &( internal_area->element_value_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free element value pool.",
+				 function );
 
-			result = -1;
+				result = -1;
+			}
 		}
 		if( ( internal_area->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
 		{
@@ -303,7 +294,7 @@ int libfdata_area_free(
 				}
 			}
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_area );
 	}
 	return( result );
@@ -352,7 +343,7 @@ int libfdata_area_clone(
 	internal_source_area = (libfdata_internal_area_t *) source_area;
 
 /* TODO refactor to use libfdata_area_initialize this requires libcdata_array_copy_elements function */
-	internal_destination_area = memory_allocate_structure(
+	internal_destination_area = libfdata_allocator_allocate_structure(
 	                             libfdata_internal_area_t );
 
 	if( internal_destination_area == NULL )
@@ -378,7 +369,7 @@ int libfdata_area_clone(
 		 "%s: unable to clear destination area.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_destination_area );
 
 		return( -1 );
@@ -422,38 +413,70 @@ int libfdata_area_clone(
 			goto on_error;
 		}
 	}
-	if( libcdata_array_clone(
-	     &( internal_destination_area->segments_array ),
-	     internal_source_area->segments_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_range_clone,
-	     error ) != 1 )
+	if( ( internal_source_area->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination segments array.",
-		 function );
+		/* Calculate the mapped ranges before the segments table is shared
+		 */
+		if( libfdata_segments_table_make_writable(
+		     &( internal_source_area->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( libfdata_segments_array_calculate_mapped_ranges(
+		     internal_source_area->segments_table->segments_array,
+		     internal_source_area->segments_table->mapped_ranges_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate mapped ranges.",
+			 function );
+
+			goto on_error;
+		}
+		internal_source_area->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
 	}
-	if( libcdata_array_clone(
-	     &( internal_destination_area->mapped_ranges_array ),
-	     internal_source_area->mapped_ranges_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_mapped_range_clone,
+	if( libfdata_segments_table_reference(
+	     &( internal_destination_area->segments_table ),
+	     internal_source_area->segments_table,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination mapped ranges array.",
+		 "%s: unable to reference source segments table.",
 		 function );
 
 		goto on_error;
 	}
+	if( internal_source_area->element_value_pool != NULL )
+	{
+		if( libfdata_value_pool_initialize(
+		     &( internal_destination_area->element_value_pool ),
+		     internal_source_area->element_value_pool->maximum_number_of_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination element value pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	internal_destination_area->element_data_size  = internal_source_area->element_data_size;
 	internal_destination_area->timestamp          = internal_source_area->timestamp;
 	internal_destination_area->flags              = internal_source_area->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
@@ -470,13 +493,6 @@ int libfdata_area_clone(
 on_error:
 	if( internal_destination_area != NULL )
 	{
-		if( internal_destination_area->segments_array != NULL )
-		{
-			libcdata_array_free(
-			 &( internal_destination_area->segments_array ),
-			 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
-			 NULL );
-		}
 		if( ( internal_destination_area->data_handle != NULL )
 		 && ( internal_source_area->free_data_handle != NULL ) )
 		{
@@ -484,7 +500,13 @@ on_error:
 			 &( internal_destination_area->data_handle ),
 			 NULL );
 		}
-		memory_free(
+		if( internal_destination_area->segments_table != NULL )
+		{
+			libfdata_segments_table_free(
+			 &( internal_destination_area->segments_table ),
+			 NULL );
+		}
+		libfdata_allocator_free(
 		 internal_destination_area );
 	}
 	return( -1 );
@@ -516,30 +538,28 @@ int libfdata_area_empty(
 	}
 	internal_area = (libfdata_internal_area_t *) area;
 
-	if( libcdata_array_empty(
-	     internal_area->segments_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
+	if( libfdata_segments_table_make_writable(
+	     &( internal_area->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty segments array.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_area->mapped_ranges_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
+	if( libfdata_segments_table_empty(
+	     internal_area->segments_table,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty mapped ranges array.",
+		 "%s: unable to empty segments table.",
 		 function );
 
 		return( -1 );
@@ -573,32 +593,29 @@ int libfdata_area_resize(
 	}
 	internal_area = (libfdata_internal_area_t *) area;
 
-	if( libcdata_array_resize(
-	     internal_area->segments_array,
-	     number_of_segments,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
+	if( libfdata_segments_table_make_writable(
+	     &( internal_area->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize segments array.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_resize(
-	     internal_area->mapped_ranges_array,
+	if( libfdata_segments_table_resize(
+	     internal_area->segments_table,
 	     number_of_segments,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize mapped ranges array.",
+		 "%s: unable to resize segments table.",
 		 function );
 
 		return( -1 );
@@ -633,7 +650,7 @@ int libfdata_area_get_number_of_segments(
 	internal_area = (libfdata_internal_area_t *) area;
 
 	if( libcdata_array_get_number_of_entries(
-	     internal_area->segments_array,
+	     internal_area->segments_table->segments_array,
 	     number_of_segments,
 	     error ) != 1 )
 	{
@@ -678,7 +695,7 @@ int libfdata_area_get_segment_by_index(
 	internal_area = (libfdata_internal_area_t *) area;
 
 	if( libfdata_segments_array_get_segment_by_index(
-	     internal_area->segments_array,
+	     internal_area->segments_table->segments_array,
 	     segment_index,
 	     segment_file_index,
 	     segment_offset,
@@ -727,9 +744,24 @@ int libfdata_area_set_segment_by_index(
 	}
 	internal_area = (libfdata_internal_area_t *) area;
 
+	if( libfdata_segments_table_make_writable(
+	     &( internal_area->segments_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_segments_array_set_segment_by_index(
-	     internal_area->segments_array,
-	     internal_area->mapped_ranges_array,
+	     internal_area->segments_table->segments_array,
+	     internal_area->segments_table->mapped_ranges_array,
+	     internal_area->segments_table->segments_arena,
+	     internal_area->segments_table->mapped_ranges_arena,
 	     &( internal_area->size ),
 	     segment_index,
 	     segment_file_index,
@@ -780,9 +812,24 @@ int libfdata_area_prepend_segment(
 	}
 	internal_area = (libfdata_internal_area_t *) area;
 
+	if( libfdata_segments_table_make_writable(
+	     &( internal_area->segments_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_segments_array_prepend_segment(
-	     internal_area->segments_array,
-	     internal_area->mapped_ranges_array,
+	     internal_area->segments_table->segments_array,
+	     internal_area->segments_table->mapped_ranges_array,
+	     internal_area->segments_table->segments_arena,
+	     internal_area->segments_table->mapped_ranges_arena,
 	     &( internal_area->size ),
 	     segment_file_index,
 	     segment_offset,
@@ -832,9 +879,24 @@ int libfdata_area_append_segment(
 	}
 	internal_area = (libfdata_internal_area_t *) area;
 
+	if( libfdata_segments_table_make_writable(
+	     &( internal_area->segments_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_segments_array_append_segment(
-	     internal_area->segments_array,
-	     internal_area->mapped_ranges_array,
+	     internal_area->segments_table->segments_array,
+	     internal_area->segments_table->mapped_ranges_array,
+	     internal_area->segments_table->segments_arena,
+	     internal_area->segments_table->mapped_ranges_arena,
 	     &( internal_area->size ),
 	     segment_index,
 	     segment_file_index,
@@ -916,20 +978,30 @@ int libfdata_area_get_element_value_at_offset(
      libcerror_error_t **error )
 {
 	libfcache_cache_value_t *cache_value    = NULL;
+	libfdata_cache_t *parent_read_cache     = NULL;
 	libfdata_internal_area_t *internal_area = NULL;
 	libfdata_range_t *segment_data_range    = NULL;
+	intptr_t *read_element_value            = NULL;
 	static char *function                   = "libfdata_area_get_element_value_at_offset";
 	off64_t cache_value_offset              = (off64_t) -1;
 	off64_t element_data_offset             = (off64_t) -1;
+	off64_t parent_read_value_offset        = 0;
 	int64_t cache_value_timestamp           = 0;
+	int64_t store_sequence_number           = 0;
+	int64_t trace_timestamp                 = 0;
 	uint32_t element_data_flags             = 0;
 	int cache_entry_index                   = -1;
 	int cache_value_file_index              = -1;
 	int element_data_file_index             = -1;
 	int element_index                       = -1;
 	int number_of_cache_entries             = 0;
+	int read_result                         = 0;
 	int result                              = 0;
 
+#if defined( HAVE_IO_STATISTICS )
+	int64_t read_timestamp                  = 0;
+#endif
+
 	if( area == NULL )
 	{
 		libcerror_error_set(
@@ -977,6 +1049,17 @@ int libfdata_area_get_element_value_at_offset(
 
 		return( -1 );
 	}
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( (size64_t) element_value_offset > internal_area->size )
 	 || ( (size64_t) element_value_offset > ( internal_area->size - internal_area->element_data_size ) ) )
 	{
@@ -990,7 +1073,7 @@ int libfdata_area_get_element_value_at_offset(
 		return( -1 );
 	}
 	if( libfdata_segments_array_get_data_range_at_offset(
-	     internal_area->segments_array,
+	     internal_area->segments_table->segments_array,
 	     element_value_offset,
 	     &element_data_offset,
 	     &segment_data_range,
@@ -1129,6 +1212,19 @@ int libfdata_area_get_element_value_at_offset(
 		}
 #endif
 	}
+	if( ( result != 0 )
+	 && ( libfdata_notify_trace_function != NULL ) )
+	{
+		libfdata_notify_trace(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_AREA,
+		 LIBFDATA_TRACE_OPERATION_READ,
+		 element_index,
+		 element_data_file_index,
+		 element_data_offset,
+		 internal_area->element_data_size,
+		 LIBFDATA_TRACE_RECORD_FLAG_CACHE_HIT,
+		 0 );
+	}
 	if( result == 0 )
 	{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -1142,18 +1238,67 @@ int libfdata_area_get_element_value_at_offset(
 			 internal_area->element_data_size );
 		}
 #endif
-		if( internal_area->read_element_data(
-		     internal_area->data_handle,
-		     file_io_handle,
-		     area,
-		     cache,
-		     element_value_offset,
-		     element_data_file_index,
-		     element_data_offset,
-		     internal_area->element_data_size,
-		     element_data_flags,
-		     read_flags,
-		     error ) != 1 )
+		/* Track the element that is being read so that the value stored
+		 * by the read element data function can be returned directly
+		 */
+		parent_read_cache        = internal_area->read_cache;
+		parent_read_value_offset = internal_area->read_element_value_offset;
+
+		internal_area->read_cache                = cache;
+		internal_area->read_element_value_offset = element_value_offset;
+		internal_area->read_element_value        = NULL;
+
+		if( libfdata_notify_trace_function != NULL )
+		{
+			libfdata_notify_trace_get_timestamp(
+			 &trace_timestamp );
+		}
+#if defined( HAVE_IO_STATISTICS )
+		libfdata_latency_histogram_get_timestamp(
+		 &read_timestamp );
+#endif
+		read_result = internal_area->read_element_data(
+		               internal_area->data_handle,
+		               file_io_handle,
+		               area,
+		               cache,
+		               element_value_offset,
+		               element_data_file_index,
+		               element_data_offset,
+		               internal_area->element_data_size,
+		               element_data_flags,
+		               read_flags,
+		               error );
+
+#if defined( HAVE_IO_STATISTICS )
+		libfdata_latency_histogram_record(
+		 internal_area->read_latency_histogram,
+		 read_timestamp );
+#endif
+
+		read_element_value = internal_area->read_element_value;
+
+		/* Any value stored in or cleared from a cache after the value of the element,
+		 * including by another container that shares the cache, could have evicted it
+		 */
+		if( read_element_value != NULL )
+		{
+			libfdata_cache_get_store_sequence_number(
+			 &store_sequence_number );
+
+			if( store_sequence_number != internal_area->read_element_store_sequence_number )
+			{
+				read_element_value = NULL;
+			}
+		}
+
+		/* A nested read could have evicted the value of the parent read
+		 */
+		internal_area->read_cache                = parent_read_cache;
+		internal_area->read_element_value_offset = parent_read_value_offset;
+		internal_area->read_element_value        = NULL;
+
+		if( read_result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1165,6 +1310,24 @@ int libfdata_area_get_element_value_at_offset(
 
 			return( -1 );
 		}
+		if( libfdata_notify_trace_function != NULL )
+		{
+			libfdata_notify_trace(
+			 LIBFDATA_TRACE_CONTAINER_TYPE_AREA,
+			 LIBFDATA_TRACE_OPERATION_READ,
+			 element_index,
+			 element_data_file_index,
+			 element_data_offset,
+			 internal_area->element_data_size,
+			 0,
+			 trace_timestamp );
+		}
+		if( read_element_value != NULL )
+		{
+			*element_value = read_element_value;
+
+			return( 1 );
+		}
 		if( internal_area->calculate_cache_entry_index == NULL )
 		{
 			cache_entry_index = element_index % number_of_cache_entries;
@@ -1242,6 +1405,23 @@ int libfdata_area_get_element_value_at_offset(
 
 		return( -1 );
 	}
+	if( internal_area->element_value_pool != NULL )
+	{
+		if( libfdata_pooled_value_get_value(
+		     (libfdata_pooled_value_t *) *element_value,
+		     element_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element value from pooled value.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -1266,9 +1446,11 @@ int libfdata_area_set_element_value_at_offset(
      libcerror_error_t **error )
 {
 	libfdata_internal_area_t *internal_area = NULL;
+	libfdata_pooled_value_t *pooled_value   = NULL;
 	libfdata_range_t *segment_data_range    = NULL;
 	static char *function                   = "libfdata_area_set_element_value_at_offset";
 	off64_t element_data_offset             = (off64_t) -1;
+	int64_t store_sequence_number           = 0;
 	uint32_t element_data_flags             = 0;
 	int cache_entry_index                   = -1;
 	int element_data_file_index             = -1;
@@ -1326,7 +1508,7 @@ int libfdata_area_set_element_value_at_offset(
 		return( -1 );
 	}
 	if( libfdata_segments_array_get_data_range_at_offset(
-	     internal_area->segments_array,
+	     internal_area->segments_table->segments_array,
 	     element_value_offset,
 	     &element_data_offset,
 	     &segment_data_range,
@@ -1398,27 +1580,291 @@ int libfdata_area_set_element_value_at_offset(
 		                     element_data_flags,
 		                     number_of_cache_entries );
 	}
-	if( libfcache_cache_set_value_by_index(
-	     (libfcache_cache_t *) cache,
-	     cache_entry_index,
-	     element_data_file_index,
-	     element_data_offset,
+	if( internal_area->element_value_pool == NULL )
+	{
+		if( libfcache_cache_set_value_by_index(
+		     (libfcache_cache_t *) cache,
+		     cache_entry_index,
+		     element_data_file_index,
+		     element_data_offset,
+		     internal_area->timestamp,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache entry: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libfdata_value_pool_wrap_value(
+		     internal_area->element_value_pool,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     &pooled_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create pooled value.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfcache_cache_set_value_by_index(
+		     (libfcache_cache_t *) cache,
+		     cache_entry_index,
+		     element_data_file_index,
+		     element_data_offset,
+		     internal_area->timestamp,
+		     (intptr_t *) pooled_value,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_pooled_value_free,
+		     LIBFDATA_AREA_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache entry: %d.",
+			 function,
+			 cache_entry_index );
+
+			/* The caller retains management of the element value on error
+			 */
+			pooled_value->free_value = NULL;
+
+			libfdata_pooled_value_free(
+			 &pooled_value,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	libfdata_cache_increment_store_sequence_number(
+	 &store_sequence_number );
+
+	/* Any other value stored in the cache while an element is being read
+	 * could evict the value of the element that is being read
+	 */
+	if( ( internal_area->read_cache == cache )
+	 && ( internal_area->read_element_value_offset == element_value_offset ) )
+	{
+		internal_area->read_element_value                 = element_value;
+		internal_area->read_element_store_sequence_number = store_sequence_number;
+	}
+	else
+	{
+		internal_area->read_element_value = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the element value pool
+ *
+ * Managed element values that are removed from the cache are kept in the pool,
+ * up to the maximum number of values, and can be reused by the read element
+ * data function, see libfdata_area_get_recycled_element_value.
+ *
+ * Element values cached before the pool was set are no longer used.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_area_set_element_value_pool(
+     libfdata_area_t *area,
+     int maximum_number_of_values,
+     libcerror_error_t **error )
+{
+	libfdata_internal_area_t *internal_area = NULL;
+	static char *function                   = "libfdata_area_set_element_value_pool";
+
+	if( area == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid area.",
+		 function );
+
+		return( -1 );
+	}
+	internal_area = (libfdata_internal_area_t *) area;
+
+	if( internal_area->element_value_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid area - element value pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_value_pool_initialize(
+	     &( internal_area->element_value_pool ),
+	     maximum_number_of_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create element value pool.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure element values cached without the pool are not retrieved
+	 */
+	if( libfdata_cache_get_timestamp(
+	     &( internal_area->timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
+		 function );
+
+		libfdata_value_pool_free(
+		 &( internal_area->element_value_pool ),
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a recycled element value
+ * The caller takes over management of the element value, which is normally
+ * passed back to libfdata_area_set_element_value_at_offset
+ * Returns 1 if successful, 0 if no recycled element value is available or -1 on error
+ */
+int libfdata_area_get_recycled_element_value(
+     libfdata_area_t *area,
+     intptr_t **element_value,
+     libcerror_error_t **error )
+{
+	libfdata_internal_area_t *internal_area = NULL;
+	static char *function                   = "libfdata_area_get_recycled_element_value";
+	int result                              = 0;
+
+	if( area == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid area.",
+		 function );
+
+		return( -1 );
+	}
+	internal_area = (libfdata_internal_area_t *) area;
+
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_area->element_value_pool == NULL )
+	{
+		return( 0 );
+	}
+	result = libfdata_value_pool_get_recycled_value(
+	          internal_area->element_value_pool,
+	          element_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve recycled element value.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Invalidates the cached element values that overlap with a specific range
+ * This allows to retain the other cached element values after the data
+ * in the range was changed
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_area_invalidate_cached_range(
+     libfdata_area_t *area,
+     libfdata_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_area_t *internal_area = NULL;
+	static char *function                   = "libfdata_area_invalidate_cached_range";
+	size64_t value_data_size                = 0;
+
+	if( area == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid area.",
+		 function );
+
+		return( -1 );
+	}
+	internal_area = (libfdata_internal_area_t *) area;
+
+	value_data_size = internal_area->element_data_size;
+
+	if( libfdata_cache_clear_values_in_range(
+	     cache,
+	     file_index,
+	     offset,
+	     size,
 	     internal_area->timestamp,
-	     element_value,
-	     free_element_value,
-	     write_flags,
+	     value_data_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set value in cache entry: %d.",
-		 function,
-		 cache_entry_index );
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to clear cached element values in range.",
+		 function );
 
 		return( -1 );
 	}
+	/* The value of an element that is being read could have been cleared
+	 */
+	internal_area->read_element_value = NULL;
+
 	return( 1 );
 }
 
@@ -1459,9 +1905,22 @@ int libfdata_area_get_size(
 	}
 	if( ( internal_area->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
+		if( libfdata_segments_table_make_writable(
+		     &( internal_area->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
+
+			return( -1 );
+		}
 		if( libfdata_segments_array_calculate_mapped_ranges(
-		     internal_area->segments_array,
-		     internal_area->mapped_ranges_array,
+		     internal_area->segments_table->segments_array,
+		     internal_area->segments_table->mapped_ranges_array,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1480,3 +1939,202 @@ int libfdata_area_get_size(
 	return( 1 );
 }
 
+/* Memory usage functions
+ */
+
+/* Retrieves the memory usage
+ * The structure size contains the size of the area, its segments, mapped ranges
+ * and element value pool. The cached values size contains an estimate of the size
+ * of the element values of the area stored in the cache, based on the element data size.
+ * The cache is optional, without a cache the cached values size is 0
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_area_get_memory_usage(
+     libfdata_area_t *area,
+     libfdata_cache_t *cache,
+     size64_t *structure_size,
+     size64_t *cached_values_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_area_t *internal_area = NULL;
+	static char *function                   = "libfdata_area_get_memory_usage";
+	size64_t memory_usage                   = 0;
+	size64_t safe_cached_values_size        = 0;
+	size64_t safe_structure_size            = 0;
+	size64_t value_size                     = 0;
+	int number_of_values                    = 0;
+
+	if( area == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid area.",
+		 function );
+
+		return( -1 );
+	}
+	if( structure_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid structure size.",
+		 function );
+
+		return( -1 );
+	}
+	if( cached_values_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cached values size.",
+		 function );
+
+		return( -1 );
+	}
+	internal_area = (libfdata_internal_area_t *) area;
+
+	if( libfdata_segments_table_get_memory_usage(
+	     internal_area->segments_table,
+	     &memory_usage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory usage of segments.",
+		 function );
+
+		return( -1 );
+	}
+	safe_structure_size = sizeof( libfdata_internal_area_t ) + memory_usage;
+
+	if( internal_area->element_value_pool != NULL )
+	{
+		if( libfdata_value_pool_get_memory_usage(
+		     internal_area->element_value_pool,
+		     &memory_usage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve memory usage of element value pool.",
+			 function );
+
+			return( -1 );
+		}
+		safe_structure_size += memory_usage;
+	}
+	if( cache != NULL )
+	{
+		if( libfdata_cache_get_number_of_values_by_timestamp(
+		     cache,
+		     internal_area->timestamp,
+		     &number_of_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of cached values.",
+			 function );
+
+			return( -1 );
+		}
+		value_size = internal_area->element_data_size;
+
+		safe_cached_values_size = (size64_t) number_of_values * value_size;
+	}
+	*structure_size     = safe_structure_size;
+	*cached_values_size = safe_cached_values_size;
+
+	return( 1 );
+}
+
+/* IO statistics functions
+ */
+
+/* Retrieves the read latency histogram
+ * The histogram contains the number of read element data function calls per latency bucket,
+ * where bucket N contains the latencies of at least 2^(N-1) and less than 2^N nanoseconds
+ * and bucket 0 the latencies of 0. The latencies are measured with a monotonic clock.
+ * The histogram is only maintained when the library was built with IO statistics support
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_area_get_read_latency_histogram(
+     libfdata_area_t *area,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_IO_STATISTICS )
+	libfdata_internal_area_t *internal_area = NULL;
+#endif
+	static char *function                   = "libfdata_area_get_read_latency_histogram";
+
+	if( area == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid area.",
+		 function );
+
+		return( -1 );
+	}
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of buckets value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	internal_area = (libfdata_internal_area_t *) area;
+
+	if( libfdata_latency_histogram_get_buckets(
+	     internal_area->read_latency_histogram,
+	     histogram,
+	     number_of_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read latency histogram.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
@@ -0,0 +1,554 @@
+/*
+ * The object arena functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_allocator.h"
+#include "libfdata_arena.h"
+#include "libfdata_definitions.h"
+#include "libfdata_libcdata.h"
+#include "libfdata_libcerror.h"
+
+/* Creates an arena
+ * An arena allocates objects of a fixed size from slabs that are only released in bulk,
+ * which avoids an allocation per object
+ * Make sure the value arena is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_arena_initialize(
+     libfdata_arena_t **arena,
+     size_t object_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_arena_initialize";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *arena != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid arena value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( object_size == 0 )
+	 || ( object_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / LIBFDATA_ARENA_MAXIMUM_NUMBER_OF_OBJECTS ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid object size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*arena = libfdata_allocator_allocate_structure(
+	          libfdata_arena_t );
+
+	if( *arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *arena,
+	     0,
+	     sizeof( libfdata_arena_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear arena.",
+		 function );
+
+		goto on_error;
+	}
+	/* Keep the objects 64-bit aligned
+	 */
+	( *arena )->object_size = ( object_size + 7 ) & ~( (size_t) 7 );
+
+	return( 1 );
+
+on_error:
+	if( *arena != NULL )
+	{
+		libfdata_allocator_free(
+		 *arena );
+
+		*arena = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an arena
+ * All objects allocated from the arena are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_arena_free(
+     libfdata_arena_t **arena,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_arena_free";
+	int result            = 1;
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *arena != NULL )
+	{
+		if( libfdata_arena_empty(
+		     *arena,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty arena.",
+			 function );
+
+			result = -1;
+		}
+		libfdata_allocator_free(
+		 *arena );
+
+		*arena = NULL;
+	}
+	return( result );
+}
+
+/* Empties an arena
+ * All objects allocated from the arena are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_arena_empty(
+     libfdata_arena_t *arena,
+     libcerror_error_t **error )
+{
+	libfdata_arena_slab_t *slab = NULL;
+	static char *function       = "libfdata_arena_empty";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	while( arena->current_slab != NULL )
+	{
+		slab = arena->current_slab;
+
+		arena->current_slab = slab->previous_slab;
+
+		libfdata_allocator_free(
+		 slab->objects_data );
+
+		libfdata_allocator_free(
+		 slab );
+	}
+	arena->number_of_used_objects      = 0;
+	arena->number_of_allocated_objects = 0;
+
+	return( 1 );
+}
+
+/* Allocates an object from the arena
+ * The object is cleared and remains owned by the arena, it cannot be freed individually
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_arena_allocate_object(
+     libfdata_arena_t *arena,
+     intptr_t **object,
+     libcerror_error_t **error )
+{
+	libfdata_arena_slab_t *slab = NULL;
+	static char *function       = "libfdata_arena_allocate_object";
+	int number_of_objects       = LIBFDATA_ARENA_INITIAL_NUMBER_OF_OBJECTS;
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( arena->current_slab == NULL )
+	 || ( arena->number_of_used_objects >= arena->current_slab->number_of_objects ) )
+	{
+		/* Grow the slabs geometrically so that small containers stay small
+		 */
+		if( arena->current_slab != NULL )
+		{
+			number_of_objects = arena->current_slab->number_of_objects * 2;
+
+			if( number_of_objects > LIBFDATA_ARENA_MAXIMUM_NUMBER_OF_OBJECTS )
+			{
+				number_of_objects = LIBFDATA_ARENA_MAXIMUM_NUMBER_OF_OBJECTS;
+			}
+		}
+		slab = libfdata_allocator_allocate_structure(
+		        libfdata_arena_slab_t );
+
+		if( slab == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create slab.",
+			 function );
+
+			return( -1 );
+		}
+		slab->objects_data = (uint8_t *) libfdata_allocator_allocate(
+		                                  arena->object_size * number_of_objects );
+
+		if( slab->objects_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create slab objects data.",
+			 function );
+
+			libfdata_allocator_free(
+			 slab );
+
+			return( -1 );
+		}
+		slab->number_of_objects = number_of_objects;
+		slab->previous_slab     = arena->current_slab;
+
+		arena->current_slab           = slab;
+		arena->number_of_used_objects = 0;
+	}
+	*object = (intptr_t *) &( arena->current_slab->objects_data[ arena->object_size * arena->number_of_used_objects ] );
+
+	if( memory_set(
+	     *object,
+	     0,
+	     arena->object_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear object.",
+		 function );
+
+		*object = NULL;
+
+		return( -1 );
+	}
+	arena->number_of_used_objects      += 1;
+	arena->number_of_allocated_objects += 1;
+
+	return( 1 );
+}
+
+/* Frees an object allocated from an arena
+ * The object memory is only released when the arena is emptied or freed,
+ * this function can be used as the entry free function of an array
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_arena_free_object(
+     intptr_t **object,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_arena_free_object";
+
+	if( object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object.",
+		 function );
+
+		return( -1 );
+	}
+	*object = NULL;
+
+	return( 1 );
+}
+
+/* Clones an array of objects allocated from an arena
+ * The objects of the destination array are allocated from the arena
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_arena_clone_array(
+     libfdata_arena_t *arena,
+     libcdata_array_t **destination_array,
+     libcdata_array_t *source_array,
+     libcerror_error_t **error )
+{
+	intptr_t *destination_object = NULL;
+	intptr_t *source_object      = NULL;
+	static char *function        = "libfdata_arena_clone_array";
+	int entry_index              = 0;
+	int number_of_entries        = 0;
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( destination_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination array.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_array != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination array value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     source_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from source array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     destination_array,
+	     number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination array.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     source_array,
+		     entry_index,
+		     &source_object,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from source array.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( source_object == NULL )
+		{
+			continue;
+		}
+		if( libfdata_arena_allocate_object(
+		     arena,
+		     &destination_object,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination object: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     destination_object,
+		     source_object,
+		     arena->object_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy object: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_set_entry_by_index(
+		     *destination_array,
+		     entry_index,
+		     destination_object,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set entry: %d in destination array.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_array != NULL )
+	{
+		libcdata_array_free(
+		 destination_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the memory usage of the arena
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_arena_get_memory_usage(
+     libfdata_arena_t *arena,
+     size64_t *memory_usage,
+     libcerror_error_t **error )
+{
+	libfdata_arena_slab_t *slab = NULL;
+	static char *function       = "libfdata_arena_get_memory_usage";
+	size64_t safe_memory_usage  = 0;
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_usage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory usage.",
+		 function );
+
+		return( -1 );
+	}
+	safe_memory_usage = sizeof( libfdata_arena_t );
+
+	for( slab = arena->current_slab;
+	     slab != NULL;
+	     slab = slab->previous_slab )
+	{
+		safe_memory_usage += sizeof( libfdata_arena_slab_t )
+		                   + ( (size64_t) arena->object_size * slab->number_of_objects );
+	}
+	*memory_usage = safe_memory_usage;
+
+	return( 1 );
+}
+
@@ -0,0 +1,110 @@
+/*
+ * The object arena functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFDATA_ARENA_H )
+#define _LIBFDATA_ARENA_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_libcdata.h"
+#include "libfdata_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfdata_arena libfdata_arena_t;
+typedef struct libfdata_arena_slab libfdata_arena_slab_t;
+
+struct libfdata_arena_slab
+{
+	/* The previous (filled) slab
+	 */
+	libfdata_arena_slab_t *previous_slab;
+
+	/* The objects data
+	 */
+	uint8_t *objects_data;
+
+	/* The number of objects
+	 */
+	int number_of_objects;
+};
+
+struct libfdata_arena
+{
+	/* The object size
+	 */
+	size_t object_size;
+
+	/* The current slab
+	 */
+	libfdata_arena_slab_t *current_slab;
+
+	/* The number of objects used in the current slab
+	 */
+	int number_of_used_objects;
+
+	/* The number of allocated objects
+	 */
+	int number_of_allocated_objects;
+};
+
+int libfdata_arena_initialize(
+     libfdata_arena_t **arena,
+     size_t object_size,
+     libcerror_error_t **error );
+
+int libfdata_arena_free(
+     libfdata_arena_t **arena,
+     libcerror_error_t **error );
+
+int libfdata_arena_empty(
+     libfdata_arena_t *arena,
+     libcerror_error_t **error );
+
+int libfdata_arena_allocate_object(
+     libfdata_arena_t *arena,
+     intptr_t **object,
+     libcerror_error_t **error );
+
+int libfdata_arena_free_object(
+     intptr_t **object,
+     libcerror_error_t **error );
+
+int libfdata_arena_clone_array(
+     libfdata_arena_t *arena,
+     libcdata_array_t **destination_array,
+     libcdata_array_t *source_array,
+     libcerror_error_t **error );
+
+int libfdata_arena_get_memory_usage(
+     libfdata_arena_t *arena,
+     size64_t *memory_usage,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_ARENA_H ) */
+
@@ -20,12 +20,59 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
+#include "libfdata_allocator.h"
 #include "libfdata_cache.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libfcache.h"
 
+/* The last cache timestamp that was handed out
+ */
+static int64_t libfdata_cache_last_timestamp = 0;
+
+/* The store sequence number, that changes every time a container stores
+ * a value in or clears a value from a cache
+ */
+static int64_t libfdata_cache_store_sequence_number = 0;
+
+/* Replaces a value with a new value if it equals the expected value
+ * The compare and swap is atomic when multi-threading support is enabled
+ * Returns the value before the operation
+ */
+static int64_t libfdata_cache_compare_and_swap(
+                volatile int64_t *value,
+                int64_t expected_value,
+                int64_t new_value )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+	return( (int64_t) InterlockedCompareExchange64(
+	                   (LONGLONG volatile *) value,
+	                   (LONGLONG) new_value,
+	                   (LONGLONG) expected_value ) );
+
+#elif defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ )
+	return( __sync_val_compare_and_swap(
+	         value,
+	         expected_value,
+	         new_value ) );
+
+#elif defined( HAVE_MULTI_THREAD_SUPPORT )
+#error Missing atomic compare and swap function
+
+#else
+	int64_t previous_value = *value;
+
+	if( previous_value == expected_value )
+	{
+		*value = new_value;
+	}
+	return( previous_value );
+
+#endif
+}
+
 #if !defined( HAVE_LOCAL_LIBFDATA )
 
 /* Creates a cache
@@ -57,3 +104,590 @@ int libfdata_cache_free(
 
 #endif /* !defined( HAVE_LOCAL_LIBFDATA ) */
 
+/* Retrieves a cache timestamp
+ * The timestamp is part of the cache value identifier and functions as the cache
+ * namespace of a container. Unlike the date and time it is based on, it is unique
+ * within the process, so that containers created within the same clock tick can
+ * share a cache without their values aliasing each other. The last timestamp
+ * is updated atomically when multi-threading support is enabled, so that containers
+ * created by different threads also get unique timestamps
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_cache_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfdata_cache_get_timestamp";
+	int64_t date_time_timestamp = 0;
+	int64_t last_timestamp      = 0;
+	int64_t previous_timestamp  = 0;
+	int64_t safe_timestamp      = 0;
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_date_time_get_timestamp(
+	     &date_time_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve date and time timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	previous_timestamp = libfdata_cache_compare_and_swap(
+	                      &libfdata_cache_last_timestamp,
+	                      0,
+	                      0 );
+
+	do
+	{
+		last_timestamp = previous_timestamp;
+		safe_timestamp = date_time_timestamp;
+
+		if( safe_timestamp <= last_timestamp )
+		{
+			if( last_timestamp == INT64_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid last timestamp value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			safe_timestamp = last_timestamp + 1;
+		}
+		/* Another thread could have handed out a timestamp since the last
+		 * timestamp was read, in which case the comparison is repeated
+		 */
+		previous_timestamp = libfdata_cache_compare_and_swap(
+		                      &libfdata_cache_last_timestamp,
+		                      last_timestamp,
+		                      safe_timestamp );
+	}
+	while( previous_timestamp != last_timestamp );
+
+	*timestamp = safe_timestamp;
+
+	return( 1 );
+}
+
+/* Retrieves the store sequence number
+ * A container that stored a value compares the store sequence number after
+ * storing it with the current one to determine if any value was stored in
+ * or cleared from a cache since, including by other containers that share
+ * the cache, which could have evicted the value
+ */
+void libfdata_cache_get_store_sequence_number(
+      int64_t *store_sequence_number )
+{
+	if( store_sequence_number == NULL )
+	{
+		return;
+	}
+	*store_sequence_number = libfdata_cache_compare_and_swap(
+	                          &libfdata_cache_store_sequence_number,
+	                          0,
+	                          0 );
+}
+
+/* Increments the store sequence number
+ * This function must be called every time a value is stored in or cleared from a cache
+ */
+void libfdata_cache_increment_store_sequence_number(
+      int64_t *store_sequence_number )
+{
+	int64_t current_sequence_number  = 0;
+	int64_t next_sequence_number     = 0;
+	int64_t previous_sequence_number = 0;
+
+	previous_sequence_number = libfdata_cache_compare_and_swap(
+	                            &libfdata_cache_store_sequence_number,
+	                            0,
+	                            0 );
+
+	do
+	{
+		current_sequence_number = previous_sequence_number;
+
+		if( current_sequence_number == INT64_MAX )
+		{
+			next_sequence_number = 0;
+		}
+		else
+		{
+			next_sequence_number = current_sequence_number + 1;
+		}
+		previous_sequence_number = libfdata_cache_compare_and_swap(
+		                            &libfdata_cache_store_sequence_number,
+		                            current_sequence_number,
+		                            next_sequence_number );
+	}
+	while( previous_sequence_number != current_sequence_number );
+
+	if( store_sequence_number != NULL )
+	{
+		*store_sequence_number = next_sequence_number;
+	}
+}
+
+/* Clears the cached values of a container that overlap with a specific range
+ * Only values with the timestamp of the container are cleared, where each value
+ * is considered to contain value data size bytes of data starting at its offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_cache_clear_values_in_range(
+     libfdata_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     size64_t size,
+     int64_t timestamp,
+     size64_t value_data_size,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libfdata_cache_clear_values_in_range";
+	off64_t cache_value_offset           = (off64_t) -1;
+	int64_t cache_value_timestamp        = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = -1;
+	int number_of_cache_entries          = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) ( INT64_MAX - offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( value_data_size == 0 ) )
+	{
+		return( 1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     (libfcache_cache_t *) cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( cache_entry_index = 0;
+	     cache_entry_index < number_of_cache_entries;
+	     cache_entry_index++ )
+	{
+		if( libfcache_cache_get_value_by_index(
+		     (libfcache_cache_t *) cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache entry: %d from cache.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( cache_value == NULL )
+		{
+			continue;
+		}
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value identifier.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( cache_value_file_index != file_index )
+		 || ( cache_value_timestamp != timestamp ) )
+		{
+			continue;
+		}
+		/* The value data overlaps if it starts before the end of the range
+		 * and ends after the start of the range
+		 */
+		if( cache_value_offset >= (off64_t) ( offset + size ) )
+		{
+			continue;
+		}
+		if( ( cache_value_offset < offset )
+		 && ( (size64_t) ( offset - cache_value_offset ) >= value_data_size ) )
+		{
+			continue;
+		}
+		if( libfcache_cache_clear_value_by_index(
+		     (libfcache_cache_t *) cache,
+		     cache_entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to clear cache entry: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		libfdata_cache_increment_store_sequence_number(
+		 NULL );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of cached values of a container
+ * Only values with the timestamp of the container are counted
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_cache_get_number_of_values_by_timestamp(
+     libfdata_cache_t *cache,
+     int64_t timestamp,
+     int *number_of_values,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libfdata_cache_get_number_of_values_by_timestamp";
+	off64_t cache_value_offset           = (off64_t) -1;
+	int64_t cache_value_timestamp        = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = -1;
+	int number_of_cache_entries          = 0;
+	int safe_number_of_values            = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     (libfcache_cache_t *) cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( cache_entry_index = 0;
+	     cache_entry_index < number_of_cache_entries;
+	     cache_entry_index++ )
+	{
+		if( libfcache_cache_get_value_by_index(
+		     (libfcache_cache_t *) cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache entry: %d from cache.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( cache_value == NULL )
+		{
+			continue;
+		}
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value identifier.",
+			 function );
+
+			return( -1 );
+		}
+		if( cache_value_timestamp == timestamp )
+		{
+			safe_number_of_values++;
+		}
+	}
+	*number_of_values = safe_number_of_values;
+
+	return( 1 );
+}
+
+/* Compares two timestamps
+ * Returns -1 if the first timestamp is smaller, 1 if it is larger or 0 if both are equal
+ */
+int libfdata_cache_compare_timestamps(
+     const int64_t *first_timestamp,
+     const int64_t *second_timestamp )
+{
+	if( *first_timestamp < *second_timestamp )
+	{
+		return( -1 );
+	}
+	else if( *first_timestamp > *second_timestamp )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the timestamps of the cached values sorted in ascending order
+ * The cache is scanned once. The timestamps array is NULL if the cache contains no values,
+ * otherwise it must be freed with libfdata_allocator_free
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_cache_get_sorted_value_timestamps(
+     libfdata_cache_t *cache,
+     int64_t **timestamps,
+     int *number_of_timestamps,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	int64_t *safe_timestamps             = NULL;
+	static char *function                = "libfdata_cache_get_sorted_value_timestamps";
+	off64_t cache_value_offset           = (off64_t) -1;
+	int64_t cache_value_timestamp        = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = -1;
+	int number_of_cache_entries          = 0;
+	int safe_number_of_timestamps        = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( timestamps == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamps.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_timestamps == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of timestamps.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     (libfcache_cache_t *) cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries > 0 )
+	{
+		if( (size_t) number_of_cache_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( int64_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of cache entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_timestamps = (int64_t *) libfdata_allocator_allocate(
+		                               sizeof( int64_t ) * number_of_cache_entries );
+
+		if( safe_timestamps == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create timestamps.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( cache_entry_index = 0;
+	     cache_entry_index < number_of_cache_entries;
+	     cache_entry_index++ )
+	{
+		if( libfcache_cache_get_value_by_index(
+		     (libfcache_cache_t *) cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache entry: %d from cache.",
+			 function,
+			 cache_entry_index );
+
+			goto on_error;
+		}
+		if( cache_value == NULL )
+		{
+			continue;
+		}
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value identifier.",
+			 function );
+
+			goto on_error;
+		}
+		safe_timestamps[ safe_number_of_timestamps++ ] = cache_value_timestamp;
+	}
+	if( safe_number_of_timestamps == 0 )
+	{
+		if( safe_timestamps != NULL )
+		{
+			libfdata_allocator_free(
+			 safe_timestamps );
+
+			safe_timestamps = NULL;
+		}
+	}
+	else
+	{
+		qsort(
+		 safe_timestamps,
+		 (size_t) safe_number_of_timestamps,
+		 sizeof( int64_t ),
+		 (int (*)(const void *, const void *)) &libfdata_cache_compare_timestamps );
+	}
+	*timestamps           = safe_timestamps;
+	*number_of_timestamps = safe_number_of_timestamps;
+
+	return( 1 );
+
+on_error:
+	if( safe_timestamps != NULL )
+	{
+		libfdata_allocator_free(
+		 safe_timestamps );
+	}
+	return( -1 );
+}
+
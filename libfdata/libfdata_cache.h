@@ -48,6 +48,41 @@ int libfdata_cache_free(
 
 #endif /* !defined( HAVE_LOCAL_LIBFDATA ) */
 
+int libfdata_cache_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error );
+
+void libfdata_cache_get_store_sequence_number(
+      int64_t *store_sequence_number );
+
+void libfdata_cache_increment_store_sequence_number(
+      int64_t *store_sequence_number );
+
+int libfdata_cache_clear_values_in_range(
+     libfdata_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     size64_t size,
+     int64_t timestamp,
+     size64_t value_data_size,
+     libcerror_error_t **error );
+
+int libfdata_cache_get_number_of_values_by_timestamp(
+     libfdata_cache_t *cache,
+     int64_t timestamp,
+     int *number_of_values,
+     libcerror_error_t **error );
+
+int libfdata_cache_compare_timestamps(
+     const int64_t *first_timestamp,
+     const int64_t *second_timestamp );
+
+int libfdata_cache_get_sorted_value_timestamps(
+     libfdata_cache_t *cache,
+     int64_t **timestamps,
+     int *number_of_timestamps,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
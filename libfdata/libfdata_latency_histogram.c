@@ -0,0 +1,195 @@
+/*
+ * The latency histogram functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "libfdata_definitions.h"
+#include "libfdata_latency_histogram.h"
+#include "libfdata_libcerror.h"
+
+/* Retrieves the timestamp used to determine the latency
+ * The timestamp is a monotonic clock value in nanoseconds, so that latencies
+ * are not affected by changes of the system date and time and have the same
+ * unit on every platform
+ * The timestamp is 0 if it could not be retrieved
+ */
+void libfdata_latency_histogram_get_timestamp(
+      int64_t *timestamp )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_specification;
+
+#endif
+
+	if( timestamp == NULL )
+	{
+		return;
+	}
+	*timestamp = 0;
+
+#if defined( WINAPI )
+	if( QueryPerformanceFrequency(
+	     &frequency ) == 0 )
+	{
+		return;
+	}
+	if( frequency.QuadPart <= 0 )
+	{
+		return;
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return;
+	}
+	/* The seconds and the remainder are converted separately to prevent
+	 * the conversion to nanoseconds from overflowing
+	 */
+	*timestamp = ( ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( ( ( counter.QuadPart % frequency.QuadPart ) * 1000000000 ) / frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_specification ) != 0 )
+	{
+		return;
+	}
+	*timestamp = ( (int64_t) time_specification.tv_sec * 1000000000 )
+	           + (int64_t) time_specification.tv_nsec;
+
+#endif
+}
+
+/* Records the latency since the start timestamp in a histogram
+ * The histogram consists of LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS buckets
+ * where bucket N contains the number of latencies of at least 2^(N-1) and less than 2^N
+ * and bucket 0 the number of latencies of 0
+ */
+void libfdata_latency_histogram_record(
+      uint64_t *histogram,
+      int64_t start_timestamp )
+{
+	int64_t end_timestamp = 0;
+	uint64_t latency      = 0;
+	int bucket_index      = 0;
+
+	if( ( histogram == NULL )
+	 || ( start_timestamp == 0 ) )
+	{
+		return;
+	}
+	libfdata_latency_histogram_get_timestamp(
+	 &end_timestamp );
+
+	if( end_timestamp > start_timestamp )
+	{
+		latency = (uint64_t) ( end_timestamp - start_timestamp );
+	}
+	while( latency != 0 )
+	{
+		bucket_index++;
+
+		latency >>= 1;
+	}
+	if( bucket_index >= LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		bucket_index = LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1;
+	}
+	histogram[ bucket_index ] += 1;
+}
+
+/* Retrieves the buckets of a histogram
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_latency_histogram_get_buckets(
+     const uint64_t *histogram,
+     uint64_t *buckets,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_latency_histogram_get_buckets";
+
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of buckets value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buckets,
+	     histogram,
+	     sizeof( uint64_t ) * LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy histogram.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
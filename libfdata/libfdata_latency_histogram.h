@@ -0,0 +1,52 @@
+/*
+ * The latency histogram functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFDATA_LATENCY_HISTOGRAM_H )
+#define _LIBFDATA_LATENCY_HISTOGRAM_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+void libfdata_latency_histogram_get_timestamp(
+      int64_t *timestamp );
+
+void libfdata_latency_histogram_record(
+      uint64_t *histogram,
+      int64_t start_timestamp );
+
+int libfdata_latency_histogram_get_buckets(
+     const uint64_t *histogram,
+     uint64_t *buckets,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_LATENCY_HISTOGRAM_H ) */
+
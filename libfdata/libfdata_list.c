@@ -23,7 +23,10 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_allocator.h"
+#include "libfdata_cache.h"
 #include "libfdata_definitions.h"
+#include "libfdata_latency_histogram.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
@@ -31,9 +34,11 @@
 #include "libfdata_list.h"
 #include "libfdata_list_element.h"
 #include "libfdata_mapped_range.h"
+#include "libfdata_notify.h"
 #include "libfdata_range.h"
 #include "libfdata_types.h"
 #include "libfdata_unused.h"
+#include "libfdata_value_pool.h"
 
 /* Creates a list
  * Make sure the value list is referencing, is set to NULL
@@ -115,7 +120,7 @@ int libfdata_list_initialize(
 
 		return( -1 );
 	}
-	internal_list = memory_allocate_structure(
+	internal_list = libfdata_allocator_allocate_structure(
 	                 libfdata_internal_list_t );
 
 	if( internal_list == NULL )
@@ -141,7 +146,7 @@ int libfdata_list_initialize(
 		 "%s: unable to clear list.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_list );
 
 		return( -1 );
@@ -181,6 +186,19 @@ int libfdata_list_initialize(
 	internal_list->read_element_data  = read_element_data;
 	internal_list->write_element_data = write_element_data;
 
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+		 LIBFDATA_WORKLOAD_CALL_INITIALIZE,
+		 (intptr_t *) internal_list,
+		 0,
+		 0,
+		 0,
+		 0,
+		 0 );
+	}
+
 	*list = (libfdata_list_t *) internal_list;
 
 	return( 1 );
@@ -195,7 +213,7 @@ on_error:
 			 NULL,
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_list );
 	}
 	return( -1 );
@@ -228,6 +246,19 @@ int libfdata_list_free(
 		internal_list = (libfdata_internal_list_t *) *list;
 		*list         = NULL;
 
+		if( libfdata_notify_workload_function != NULL )
+		{
+			libfdata_notify_workload(
+			 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+			 LIBFDATA_WORKLOAD_CALL_FREE,
+			 (intptr_t *) internal_list,
+			 0,
+			 0,
+			 0,
+			 0,
+			 0 );
+		}
+
 		if( libcdata_array_free(
 		     &( internal_list->elements_array ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_element_free,
@@ -256,6 +287,22 @@ int libfdata_list_free(
 
 			result = -1;
 		}
+		if( internal_list->element_value_pool != NULL )
+		{
+			if( libfdata_value_pool_free(
+			     &( internal_list->element_value_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free element value pool.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( internal_list->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
 		{
 			if( internal_list->data_handle != NULL )
@@ -286,7 +333,7 @@ int libfdata_list_free(
 				}
 			}
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_list );
 	}
 	return( result );
@@ -334,7 +381,7 @@ int libfdata_list_clone(
 	}
 	internal_source_list = (libfdata_internal_list_t *) source_list;
 
-	internal_destination_list = memory_allocate_structure(
+	internal_destination_list = libfdata_allocator_allocate_structure(
 	                             libfdata_internal_list_t );
 
 	if( internal_destination_list == NULL )
@@ -360,7 +407,7 @@ int libfdata_list_clone(
 		 "%s: unable to clear destination list.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_destination_list );
 
 		return( -1 );
@@ -437,12 +484,42 @@ int libfdata_list_clone(
 
 		goto on_error;
 	}
+	if( internal_source_list->element_value_pool != NULL )
+	{
+		if( libfdata_value_pool_initialize(
+		     &( internal_destination_list->element_value_pool ),
+		     internal_source_list->element_value_pool->maximum_number_of_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination element value pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	internal_destination_list->flags              = internal_source_list->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
 	internal_destination_list->free_data_handle   = internal_source_list->free_data_handle;
 	internal_destination_list->clone_data_handle  = internal_source_list->clone_data_handle;
 	internal_destination_list->read_element_data  = internal_source_list->read_element_data;
 	internal_destination_list->write_element_data = internal_source_list->write_element_data;
 
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+		 LIBFDATA_WORKLOAD_CALL_CLONE,
+		 (intptr_t *) internal_destination_list,
+		 0,
+		 0,
+		 (off64_t) (intptr_t) source_list,
+		 0,
+		 0 );
+	}
+
 	*destination_list = (libfdata_list_t *) internal_destination_list;
 
 	return( 1 );
@@ -457,6 +534,13 @@ on_error:
 			 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_list_element_free,
 			 NULL );
 		}
+		if( internal_destination_list->mapped_ranges_array != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_destination_list->mapped_ranges_array ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
+			 NULL );
+		}
 		if( ( internal_destination_list->data_handle != NULL )
 		 && ( internal_source_list->free_data_handle != NULL ) )
 		{
@@ -464,7 +548,7 @@ on_error:
 			 &( internal_destination_list->data_handle ),
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_destination_list );
 	}
 	return( -1 );
@@ -1531,6 +1615,19 @@ int libfdata_list_append_element(
 	}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+		 LIBFDATA_WORKLOAD_CALL_APPEND_ELEMENT,
+		 (intptr_t *) internal_list,
+		 *element_index,
+		 element_file_index,
+		 element_offset,
+		 element_size,
+		 0 );
+	}
+
 	internal_list->current_element_index = *element_index;
 	internal_list->size                 += element_size;
 
@@ -2883,6 +2980,19 @@ int libfdata_list_append_element_with_mapped_size(
 	}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+		 LIBFDATA_WORKLOAD_CALL_APPEND_ELEMENT,
+		 (intptr_t *) internal_list,
+		 *element_index,
+		 element_file_index,
+		 element_offset,
+		 element_size,
+		 0 );
+	}
+
 	internal_list->current_element_index = *element_index;
 	internal_list->size                 += mapped_size;
 
@@ -3700,6 +3810,55 @@ int libfdata_list_get_element_at_offset(
 /* List element value functions
  */
 
+/* Sets the element value stored in the cache while an element is being read
+ * Any other value stored in the cache could evict the value of the element
+ * that is being read, hence the read element value is reset
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_set_read_element_value(
+     libfdata_list_t *list,
+     libfdata_cache_t *cache,
+     int element_file_index,
+     off64_t element_data_offset,
+     int64_t element_timestamp,
+     intptr_t *element_value,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_set_read_element_value";
+	int64_t store_sequence_number           = 0;
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	libfdata_cache_increment_store_sequence_number(
+	 &store_sequence_number );
+
+	if( ( internal_list->read_cache == cache )
+	 && ( internal_list->read_element_file_index == element_file_index )
+	 && ( internal_list->read_element_data_offset == element_data_offset )
+	 && ( internal_list->read_element_timestamp == element_timestamp ) )
+	{
+		internal_list->read_element_value                 = element_value;
+		internal_list->read_element_store_sequence_number = store_sequence_number;
+	}
+	else
+	{
+		internal_list->read_element_value = NULL;
+	}
+	return( 1 );
+}
+
 /* Caches the element value
  * Returns 1 if successful or -1 on error
  */
@@ -3719,7 +3878,9 @@ int libfdata_list_cache_element_value(
      uint8_t write_flags,
      libcerror_error_t **error )
 {
-	static char *function = "libfdata_list_cache_element_value";
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_pooled_value_t *pooled_value   = NULL;
+	static char *function                   = "libfdata_list_cache_element_value";
 
 	LIBFDATA_UNREFERENCED_PARAMETER( element_index )
 	LIBFDATA_UNREFERENCED_PARAMETER( element_data_size )
@@ -3736,25 +3897,96 @@ int libfdata_list_cache_element_value(
 
 		return( -1 );
 	}
-	if( libfcache_cache_set_value_by_identifier(
-	     (libfcache_cache_t *) cache,
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( internal_list->element_value_pool == NULL )
+	{
+		if( libfcache_cache_set_value_by_identifier(
+		     (libfcache_cache_t *) cache,
+		     element_file_index,
+		     element_data_offset,
+		     element_timestamp,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libfdata_value_pool_wrap_value(
+		     internal_list->element_value_pool,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     &pooled_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create pooled value.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfcache_cache_set_value_by_identifier(
+		     (libfcache_cache_t *) cache,
+		     element_file_index,
+		     element_data_offset,
+		     element_timestamp,
+		     (intptr_t *) pooled_value,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_pooled_value_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache.",
+			 function );
+
+			/* The caller retains management of the element value on error
+			 */
+			pooled_value->free_value = NULL;
+
+			libfdata_pooled_value_free(
+			 &pooled_value,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_list_set_read_element_value(
+	     list,
+	     cache,
 	     element_file_index,
 	     element_data_offset,
 	     element_timestamp,
 	     element_value,
-	     free_element_value,
-	     write_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set value in cache.",
+		 "%s: unable to set read element value.",
 		 function );
 
 		return( -1 );
 	}
+
 	return( 1 );
 }
 
@@ -3771,18 +4003,30 @@ int libfdata_list_get_element_value(
      libcerror_error_t **error )
 {
 	libfcache_cache_value_t *cache_value    = NULL;
+	libfdata_cache_t *parent_read_cache     = NULL;
 	libfdata_internal_list_t *internal_list = NULL;
+	intptr_t *read_element_value            = NULL;
 	static char *function                   = "libfdata_list_get_element_value";
 	size64_t element_data_size              = 0;
         off64_t cache_value_offset              = (off64_t) -1;
 	off64_t element_data_offset             = 0;
+	off64_t parent_read_data_offset         = 0;
 	int64_t cache_value_timestamp           = 0;
 	int64_t element_timestamp               = 0;
+	int64_t parent_read_timestamp           = 0;
+	int64_t store_sequence_number           = 0;
+	int64_t trace_timestamp                 = 0;
 	uint32_t element_data_flags             = 0;
 	int cache_value_file_index              = -1;
 	int element_file_index                  = -1;
+	int parent_read_file_index              = -1;
+	int read_result                         = 0;
 	int result                              = 0;
 
+#if defined( HAVE_IO_STATISTICS )
+	int64_t read_timestamp                  = 0;
+#endif
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	const char *hit_or_miss                 = NULL;
 #endif
@@ -3811,6 +4055,17 @@ int libfdata_list_get_element_value(
 
 		return( -1 );
 	}
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_list_element_get_data_range(
 	     element,
 	     &element_file_index,
@@ -3882,6 +4137,19 @@ int libfdata_list_get_element_value(
 		}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 	}
+	if( ( result != 0 )
+	 && ( libfdata_notify_trace_function != NULL ) )
+	{
+		libfdata_notify_trace(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+		 LIBFDATA_TRACE_OPERATION_READ,
+		 ( (libfdata_internal_list_element_t *) element )->element_index,
+		 element_file_index,
+		 element_data_offset,
+		 element_data_size,
+		 LIBFDATA_TRACE_RECORD_FLAG_CACHE_HIT,
+		 0 );
+	}
 	if( result == 0 )
 	{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -3895,17 +4163,72 @@ int libfdata_list_get_element_value(
 			 element_data_size );
 		}
 #endif
-		if( internal_list->read_element_data(
-		     internal_list->data_handle,
-		     file_io_handle,
-		     element,
-		     cache,
-		     element_file_index,
-		     element_data_offset,
-		     element_data_size,
-		     element_data_flags,
-		     read_flags,
-		     error ) != 1 )
+		/* Track the element that is being read so that the value stored
+		 * by the read element data function can be returned directly
+		 */
+		parent_read_cache       = internal_list->read_cache;
+		parent_read_file_index  = internal_list->read_element_file_index;
+		parent_read_data_offset = internal_list->read_element_data_offset;
+		parent_read_timestamp   = internal_list->read_element_timestamp;
+
+		internal_list->read_cache               = cache;
+		internal_list->read_element_file_index  = element_file_index;
+		internal_list->read_element_data_offset = element_data_offset;
+		internal_list->read_element_timestamp   = element_timestamp;
+		internal_list->read_element_value       = NULL;
+
+		if( libfdata_notify_trace_function != NULL )
+		{
+			libfdata_notify_trace_get_timestamp(
+			 &trace_timestamp );
+		}
+#if defined( HAVE_IO_STATISTICS )
+		libfdata_latency_histogram_get_timestamp(
+		 &read_timestamp );
+#endif
+		read_result = internal_list->read_element_data(
+		               internal_list->data_handle,
+		               file_io_handle,
+		               element,
+		               cache,
+		               element_file_index,
+		               element_data_offset,
+		               element_data_size,
+		               element_data_flags,
+		               read_flags,
+		               error );
+
+#if defined( HAVE_IO_STATISTICS )
+		libfdata_latency_histogram_record(
+		 internal_list->read_latency_histogram,
+		 read_timestamp );
+#endif
+
+		read_element_value = internal_list->read_element_value;
+
+		/* Any value stored in or cleared from a cache after the value of the element,
+		 * including by another container that shares the cache, could have evicted it
+		 */
+		if( read_element_value != NULL )
+		{
+			libfdata_cache_get_store_sequence_number(
+			 &store_sequence_number );
+
+			if( store_sequence_number != internal_list->read_element_store_sequence_number )
+			{
+				read_element_value = NULL;
+			}
+		}
+
+		/* A nested read could have evicted the value of the parent read
+		 */
+		internal_list->read_cache               = parent_read_cache;
+		internal_list->read_element_file_index  = parent_read_file_index;
+		internal_list->read_element_data_offset = parent_read_data_offset;
+		internal_list->read_element_timestamp   = parent_read_timestamp;
+		internal_list->read_element_value       = NULL;
+
+		if( read_result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -3918,6 +4241,24 @@ int libfdata_list_get_element_value(
 
 			return( -1 );
 		}
+		if( libfdata_notify_trace_function != NULL )
+		{
+			libfdata_notify_trace(
+			 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+			 LIBFDATA_TRACE_OPERATION_READ,
+			 ( (libfdata_internal_list_element_t *) element )->element_index,
+			 element_file_index,
+			 element_data_offset,
+			 element_data_size,
+			 0,
+			 trace_timestamp );
+		}
+		if( read_element_value != NULL )
+		{
+			*element_value = read_element_value;
+
+			return( 1 );
+		}
 		if( libfcache_cache_get_value_by_identifier(
 		     (libfcache_cache_t *) cache,
 		     element_file_index,
@@ -3979,6 +4320,23 @@ int libfdata_list_get_element_value(
 
 		return( -1 );
 	}
+	if( internal_list->element_value_pool != NULL )
+	{
+		if( libfdata_pooled_value_get_value(
+		     (libfdata_pooled_value_t *) *element_value,
+		     element_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element value from pooled value.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -4011,6 +4369,18 @@ int libfdata_list_get_element_value_by_index(
 	}
 	internal_list = (libfdata_internal_list_t *) list;
 
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+		 LIBFDATA_WORKLOAD_CALL_GET_ELEMENT_VALUE_BY_INDEX,
+		 (intptr_t *) internal_list,
+		 element_index,
+		 0,
+		 0,
+		 0,
+		 read_flags );
+	}
 	if( libcdata_array_get_entry_by_index(
 	     internal_list->elements_array,
 	     element_index,
@@ -4079,6 +4449,18 @@ int libfdata_list_get_element_value_at_offset(
 
 		return( -1 );
 	}
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_LIST,
+		 LIBFDATA_WORKLOAD_CALL_GET_ELEMENT_VALUE_AT_OFFSET,
+		 (intptr_t *) list,
+		 0,
+		 0,
+		 offset,
+		 0,
+		 read_flags );
+	}
 	result = libfdata_list_get_list_element_at_offset(
 	          list,
 	          offset,
@@ -4145,12 +4527,14 @@ int libfdata_list_set_element_value(
      uint8_t write_flags,
      libcerror_error_t **error )
 {
-	static char *function       = "libfdata_list_set_element_value";
-	size64_t element_data_size  = 0;
-	off64_t element_data_offset = 0;
-	int64_t element_timestamp   = 0;
-	uint32_t element_data_flags = 0;
-	int element_file_index      = -1;
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_pooled_value_t *pooled_value   = NULL;
+	static char *function                   = "libfdata_list_set_element_value";
+	size64_t element_data_size              = 0;
+	off64_t element_data_offset             = 0;
+	int64_t element_timestamp               = 0;
+	uint32_t element_data_flags             = 0;
+	int element_file_index                  = -1;
 
 	LIBFDATA_UNREFERENCED_PARAMETER( file_io_handle )
 
@@ -4165,6 +4549,8 @@ int libfdata_list_set_element_value(
 
 		return( -1 );
 	}
+	internal_list = (libfdata_internal_list_t *) list;
+
 	if( libfdata_list_element_get_data_range(
 	     element,
 	     &element_file_index,
@@ -4196,30 +4582,99 @@ int libfdata_list_set_element_value(
 
 		return( -1 );
 	}
-	if( libfcache_cache_set_value_by_identifier(
-	     (libfcache_cache_t *) cache,
-	     element_file_index,
-	     element_data_offset,
-	     element_timestamp,
-	     element_value,
-	     free_element_value,
-	     write_flags,
-	     error ) != 1 )
+	if( internal_list->element_value_pool == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set value in cache.",
-		 function );
+		if( libfcache_cache_set_value_by_identifier(
+		     (libfcache_cache_t *) cache,
+		     element_file_index,
+		     element_data_offset,
+		     element_timestamp,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
-	return( 1 );
-}
+	else
+	{
+		if( libfdata_value_pool_wrap_value(
+		     internal_list->element_value_pool,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     &pooled_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create pooled value.",
+			 function );
 
-/* Sets the value of a specific element
- *
+			return( -1 );
+		}
+		if( libfcache_cache_set_value_by_identifier(
+		     (libfcache_cache_t *) cache,
+		     element_file_index,
+		     element_data_offset,
+		     element_timestamp,
+		     (intptr_t *) pooled_value,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_pooled_value_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache.",
+			 function );
+
+			/* The caller retains management of the element value on error
+			 */
+			pooled_value->free_value = NULL;
+
+			libfdata_pooled_value_free(
+			 &pooled_value,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_list_set_read_element_value(
+	     list,
+	     cache,
+	     element_file_index,
+	     element_data_offset,
+	     element_timestamp,
+	     element_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read element value.",
+		 function );
+
+		return( -1 );
+	}
+
+	return( 1 );
+}
+
+/* Sets the value of a specific element
+ *
  * If the flag LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED is set the list
  * takes over management of the value and the value is freed when
  * no longer needed.
@@ -4368,6 +4823,152 @@ int libfdata_list_set_element_value_at_offset(
 	return( result );
 }
 
+/* Sets the element value pool
+ *
+ * Managed element values that are removed from the cache are kept in the pool,
+ * up to the maximum number of values, and can be reused by the read element
+ * data function, see libfdata_list_get_recycled_element_value.
+ *
+ * The element value pool must be set before elements are added.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_set_element_value_pool(
+     libfdata_list_t *list,
+     int maximum_number_of_values,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_set_element_value_pool";
+	int number_of_elements                  = 0;
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( internal_list->element_value_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid list - element value pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_list->elements_array,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from elements array.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_elements != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid list - elements already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_value_pool_initialize(
+	     &( internal_list->element_value_pool ),
+	     maximum_number_of_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create element value pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a recycled element value
+ * The caller takes over management of the element value, which is normally
+ * passed back to libfdata_list_set_element_value
+ * Returns 1 if successful, 0 if no recycled element value is available or -1 on error
+ */
+int libfdata_list_get_recycled_element_value(
+     libfdata_list_t *list,
+     intptr_t **element_value,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	static char *function                   = "libfdata_list_get_recycled_element_value";
+	int result                              = 0;
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_list->element_value_pool == NULL )
+	{
+		return( 0 );
+	}
+	result = libfdata_value_pool_get_recycled_value(
+	          internal_list->element_value_pool,
+	          element_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve recycled element value.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Retrieves the size of the list
  * Returns 1 if successful or -1 on error
  */
@@ -4424,3 +5025,311 @@ int libfdata_list_get_size(
 	return( 1 );
 }
 
+/* Memory usage functions
+ */
+
+/* Retrieves the memory usage
+ * The structure size contains the size of the list, its elements, mapped ranges
+ * and element value pool. The cached values size contains an estimate of the size
+ * of the element values of the list stored in the cache, based on the element data size.
+ * The cache is scanned once and its value timestamps are matched against those of the elements.
+ * The cache is optional, without a cache the cached values size is 0
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_list_get_memory_usage(
+     libfdata_list_t *list,
+     libfdata_cache_t *cache,
+     size64_t *structure_size,
+     size64_t *cached_values_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_t *internal_list = NULL;
+	libfdata_list_element_t *list_element   = NULL;
+	static char *function                   = "libfdata_list_get_memory_usage";
+	size64_t element_data_size              = 0;
+	size64_t safe_cached_values_size        = 0;
+	size64_t safe_structure_size            = 0;
+	off64_t element_data_offset             = 0;
+	size64_t memory_usage                   = 0;
+	int64_t *cache_value_timestamps         = NULL;
+	int64_t element_timestamp               = 0;
+	uint32_t element_data_flags             = 0;
+	int element_file_index                  = -1;
+	int element_index                       = 0;
+	int number_of_cache_value_timestamps    = 0;
+	int number_of_elements                  = 0;
+	int number_of_mapped_ranges             = 0;
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	if( structure_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid structure size.",
+		 function );
+
+		return( -1 );
+	}
+	if( cached_values_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cached values size.",
+		 function );
+
+		return( -1 );
+	}
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_list->elements_array,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from elements array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_list->mapped_ranges_array,
+	     &number_of_mapped_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of mapped ranges from mapped ranges array.",
+		 function );
+
+		return( -1 );
+	}
+	safe_structure_size = sizeof( libfdata_internal_list_t )
+	                    + (size64_t) number_of_elements * sizeof( intptr_t * )
+	                    + (size64_t) number_of_mapped_ranges * ( sizeof( intptr_t * ) + sizeof( libfdata_mapped_range_t ) );
+
+	if( internal_list->element_value_pool != NULL )
+	{
+		if( libfdata_value_pool_get_memory_usage(
+		     internal_list->element_value_pool,
+		     &memory_usage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve memory usage of element value pool.",
+			 function );
+
+			return( -1 );
+		}
+		safe_structure_size += memory_usage;
+	}
+	if( cache != NULL )
+	{
+		if( libfdata_cache_get_sorted_value_timestamps(
+		     cache,
+		     &cache_value_timestamps,
+		     &number_of_cache_value_timestamps,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value timestamps.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_list->elements_array,
+		     element_index,
+		     (intptr_t **) &list_element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from elements array.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		if( list_element == NULL )
+		{
+			continue;
+		}
+		safe_structure_size += sizeof( libfdata_internal_list_element_t ) + sizeof( libfdata_range_t );
+
+		if( cache_value_timestamps == NULL )
+		{
+			continue;
+		}
+		if( libfdata_list_element_get_data_range(
+		     list_element,
+		     &element_file_index,
+		     &element_data_offset,
+		     &element_data_size,
+		     &element_data_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range from list element: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_element_get_timestamp(
+		     list_element,
+		     &element_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve time stamp from list element: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		if( bsearch(
+		     &element_timestamp,
+		     cache_value_timestamps,
+		     (size_t) number_of_cache_value_timestamps,
+		     sizeof( int64_t ),
+		     (int (*)(const void *, const void *)) &libfdata_cache_compare_timestamps ) != NULL )
+		{
+			safe_cached_values_size += element_data_size;
+		}
+	}
+	if( cache_value_timestamps != NULL )
+	{
+		libfdata_allocator_free(
+		 cache_value_timestamps );
+	}
+	*structure_size     = safe_structure_size;
+	*cached_values_size = safe_cached_values_size;
+
+	return( 1 );
+
+on_error:
+	if( cache_value_timestamps != NULL )
+	{
+		libfdata_allocator_free(
+		 cache_value_timestamps );
+	}
+	return( -1 );
+}
+
+/* IO statistics functions
+ */
+
+/* Retrieves the read latency histogram
+ * The histogram contains the number of read element data function calls per latency bucket,
+ * where bucket N contains the latencies of at least 2^(N-1) and less than 2^N nanoseconds
+ * and bucket 0 the latencies of 0. The latencies are measured with a monotonic clock.
+ * The histogram is only maintained when the library was built with IO statistics support
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_list_get_read_latency_histogram(
+     libfdata_list_t *list,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_IO_STATISTICS )
+	libfdata_internal_list_t *internal_list = NULL;
+#endif
+	static char *function                   = "libfdata_list_get_read_latency_histogram";
+
+	if( list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid list.",
+		 function );
+
+		return( -1 );
+	}
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of buckets value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	internal_list = (libfdata_internal_list_t *) list;
+
+	if( libfdata_latency_histogram_get_buckets(
+	     internal_list->read_latency_histogram,
+	     histogram,
+	     number_of_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read latency histogram.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
@@ -25,11 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfdata_definitions.h"
 #include "libfdata_extern.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_types.h"
+#include "libfdata_value_pool.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -59,6 +61,41 @@ struct libfdata_internal_list
 	 */
 	libcdata_array_t *mapped_ranges_array;
 
+	/* The cache of the element that is being read
+	 * or NULL if no element is being read
+	 */
+	libfdata_cache_t *read_cache;
+
+	/* The file index of the element that is being read
+	 */
+	int read_element_file_index;
+
+	/* The data offset of the element that is being read
+	 */
+	off64_t read_element_data_offset;
+
+	/* The timestamp of the element that is being read
+	 */
+	int64_t read_element_timestamp;
+
+	/* The element value set by the read element data function
+	 */
+	intptr_t *read_element_value;
+
+	/* The store sequence number after the read element value was stored
+	 */
+	int64_t read_element_store_sequence_number;
+
+	/* The element value pool
+	 */
+	libfdata_value_pool_t *element_value_pool;
+
+#if defined( HAVE_IO_STATISTICS )
+	/* The read latency histogram
+	 */
+	uint64_t read_latency_histogram[ LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+#endif
+
 	/* The flags
 	 */
 	uint8_t flags;
@@ -350,6 +387,15 @@ int libfdata_list_get_element_at_offset(
 
 /* List element value functions
  */
+int libfdata_list_set_read_element_value(
+     libfdata_list_t *list,
+     libfdata_cache_t *cache,
+     int element_file_index,
+     off64_t element_data_offset,
+     int64_t element_timestamp,
+     intptr_t *element_value,
+     libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 int libfdata_list_cache_element_value(
      libfdata_list_t *list,
@@ -436,6 +482,18 @@ int libfdata_list_set_element_value_at_offset(
      uint8_t write_flags,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_list_set_element_value_pool(
+     libfdata_list_t *list,
+     int maximum_number_of_values,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_list_get_recycled_element_value(
+     libfdata_list_t *list,
+     intptr_t **element_value,
+     libcerror_error_t **error );
+
 /* IO functions
  */
 LIBFDATA_EXTERN \
@@ -444,6 +502,25 @@ int libfdata_list_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+/* Memory usage functions
+ */
+LIBFDATA_EXTERN \
+int libfdata_list_get_memory_usage(
+     libfdata_list_t *list,
+     libfdata_cache_t *cache,
+     size64_t *structure_size,
+     size64_t *cached_values_size,
+     libcerror_error_t **error );
+
+/* IO statistics functions
+ */
+LIBFDATA_EXTERN \
+int libfdata_list_get_read_latency_histogram(
+     libfdata_list_t *list,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
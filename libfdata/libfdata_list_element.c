@@ -23,6 +23,8 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_allocator.h"
+#include "libfdata_cache.h"
 #include "libfdata_definitions.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
@@ -89,7 +91,7 @@ int libfdata_list_element_initialize(
 
 		return( -1 );
 	}
-	internal_element = memory_allocate_structure(
+	internal_element = libfdata_allocator_allocate_structure(
 	                    libfdata_internal_list_element_t );
 
 	if( internal_element == NULL )
@@ -115,7 +117,7 @@ int libfdata_list_element_initialize(
 		 "%s: unable to clear element.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_element );
 
 		return( -1 );
@@ -133,7 +135,7 @@ int libfdata_list_element_initialize(
 
 		goto on_error;
 	}
-	if( libfcache_date_time_get_timestamp(
+	if( libfdata_cache_get_timestamp(
 	     &( internal_element->timestamp ),
 	     error ) != 1 )
 	{
@@ -162,7 +164,7 @@ on_error:
 			 &( internal_element->data_range ),
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_element );
 	}
 	return( -1 );
@@ -208,7 +210,7 @@ int libfdata_list_element_free(
 
 			result = -1;
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_element );
 	}
 	return( result );
@@ -256,7 +258,7 @@ int libfdata_list_element_clone(
 	}
 	internal_source_element = (libfdata_internal_list_element_t *) source_element;
 
-	internal_destination_element = memory_allocate_structure(
+	internal_destination_element = libfdata_allocator_allocate_structure(
 	                                libfdata_internal_list_element_t );
 
 	if( internal_destination_element == NULL )
@@ -282,7 +284,7 @@ int libfdata_list_element_clone(
 		 "%s: unable to clear destination element.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_destination_element );
 
 		return( -1 );
@@ -301,7 +303,7 @@ int libfdata_list_element_clone(
 
 		goto on_error;
 	}
-	if( libfcache_date_time_get_timestamp(
+	if( libfdata_cache_get_timestamp(
 	     &( internal_destination_element->timestamp ),
 	     error ) != 1 )
 	{
@@ -331,7 +333,7 @@ on_error:
 			 &( internal_destination_element->data_range ),
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_destination_element );
 	}
 	return( -1 );
@@ -584,7 +586,7 @@ int libfdata_list_element_set_data_range(
 
 		return( -1 );
 	}
-	if( libfcache_date_time_get_timestamp(
+	if( libfdata_cache_get_timestamp(
 	     &( internal_element->timestamp ),
 	     error ) != 1 )
 	{
@@ -822,3 +824,49 @@ int libfdata_list_element_set_element_value(
 	return( 1 );
 }
 
+/* Retrieves a recycled element value
+ * The caller takes over management of the element value, which is normally
+ * passed back to libfdata_list_element_set_element_value
+ * Returns 1 if successful, 0 if no recycled element value is available or -1 on error
+ */
+int libfdata_list_element_get_recycled_element_value(
+     libfdata_list_element_t *element,
+     intptr_t **element_value,
+     libcerror_error_t **error )
+{
+	libfdata_internal_list_element_t *internal_element = NULL;
+	static char *function                              = "libfdata_list_element_get_recycled_element_value";
+	int result                                         = 0;
+
+	if( element == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element.",
+		 function );
+
+		return( -1 );
+	}
+	internal_element = (libfdata_internal_list_element_t *) element;
+
+	result = libfdata_list_get_recycled_element_value(
+	          internal_element->list,
+	          element_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve recycled element value.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
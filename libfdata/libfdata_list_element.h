@@ -151,6 +151,12 @@ int libfdata_list_element_set_element_value(
      uint8_t write_flags,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_list_element_get_recycled_element_value(
+     libfdata_list_element_t *element,
+     intptr_t **element_value,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
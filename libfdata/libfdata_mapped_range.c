@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_allocator.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_mapped_range.h"
 
@@ -58,7 +59,7 @@ int libfdata_mapped_range_initialize(
 
 		return( -1 );
 	}
-	*mapped_range = memory_allocate_structure(
+	*mapped_range = libfdata_allocator_allocate_structure(
 	                 libfdata_mapped_range_t );
 
 	if( *mapped_range == NULL )
@@ -93,7 +94,7 @@ int libfdata_mapped_range_initialize(
 on_error:
 	if( *mapped_range != NULL )
 	{
-		memory_free(
+		libfdata_allocator_free(
 		 *mapped_range );
 
 		*mapped_range = NULL;
@@ -123,7 +124,7 @@ int libfdata_mapped_range_free(
 	}
 	if( *mapped_range != NULL )
 	{
-		memory_free(
+		libfdata_allocator_free(
 		 *mapped_range );
 
 		*mapped_range = NULL;
@@ -169,7 +170,7 @@ int libfdata_mapped_range_clone(
 
 		return( 1 );
 	}
-	*destination_mapped_range = memory_allocate_structure(
+	*destination_mapped_range = libfdata_allocator_allocate_structure(
 	                             libfdata_mapped_range_t );
 
 	if( *destination_mapped_range == NULL )
@@ -202,7 +203,7 @@ int libfdata_mapped_range_clone(
 on_error:
 	if( *destination_mapped_range != NULL )
 	{
-		memory_free(
+		libfdata_allocator_free(
 		 *destination_mapped_range );
 
 		*destination_mapped_range = NULL;
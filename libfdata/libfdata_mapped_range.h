@@ -42,6 +42,10 @@ struct libfdata_mapped_range
 	/* The size
 	 */
 	size64_t size;
+
+	/* The number of sparse segments up to and including this one
+	 */
+	int number_of_sparse_segments;
 };
 
 int libfdata_mapped_range_initialize(
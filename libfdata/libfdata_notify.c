@@ -19,6 +19,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <file_stream.h>
 #include <types.h>
@@ -27,10 +28,38 @@
 #include <stdlib.h>
 #endif
 
+#include "libfdata_definitions.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
+#include "libfdata_libfcache.h"
 #include "libfdata_notify.h"
 
+/* The trace function or NULL if not set
+ */
+void (*libfdata_notify_trace_function)(
+       intptr_t *trace_data,
+       const uint8_t *record_data,
+       size_t record_data_size ) = NULL;
+
+/* The trace data passed to the trace function
+ */
+intptr_t *libfdata_notify_trace_data = NULL;
+
+/* The workload function or NULL if not set
+ */
+void (*libfdata_notify_workload_function)(
+       intptr_t *workload_data,
+       const uint8_t *record_data,
+       size_t record_data_size ) = NULL;
+
+/* The workload data passed to the workload function
+ */
+intptr_t *libfdata_notify_workload_data = NULL;
+
+/* The workload stream if opened using a filename
+ */
+FILE *libfdata_notify_workload_stream = NULL;
+
 #if !defined( HAVE_LOCAL_LIBFDATA )
 
 /* Sets the verbose notification
@@ -116,5 +145,278 @@ int libfdata_notify_stream_close(
 	return( 0 );
 }
 
+/* Sets the trace function
+ * The trace function is called with a trace record of LIBFDATA_TRACE_RECORD_SIZE bytes
+ * for every element or segment data read, a NULL trace function disables tracing
+ */
+void libfdata_notify_set_trace_function(
+      void (*trace_function)(
+             intptr_t *trace_data,
+             const uint8_t *record_data,
+             size_t record_data_size ),
+      intptr_t *trace_data )
+{
+	libfdata_notify_trace_function = trace_function;
+	libfdata_notify_trace_data     = trace_data;
+}
+
+/* Sets the workload function
+ * The workload function is called with a workload record of LIBFDATA_WORKLOAD_RECORD_SIZE bytes
+ * for every recorded stream, vector or list call, a NULL workload function disables recording
+ */
+void libfdata_notify_set_workload_function(
+      void (*workload_function)(
+             intptr_t *workload_data,
+             const uint8_t *record_data,
+             size_t record_data_size ),
+      intptr_t *workload_data )
+{
+	libfdata_notify_workload_function = workload_function;
+	libfdata_notify_workload_data     = workload_data;
+}
+
+/* Opens the workload stream using a filename
+ * The workload records are written to the file, which is truncated
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_notify_workload_open(
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_notify_workload_open";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_notify_workload_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid workload stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	libfdata_notify_workload_stream = file_stream_open(
+	                                   filename,
+	                                   "wb" );
+
+	if( libfdata_notify_workload_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open workload stream.",
+		 function );
+
+		return( -1 );
+	}
+	libfdata_notify_workload_function = &libfdata_notify_workload_write;
+	libfdata_notify_workload_data     = (intptr_t *) libfdata_notify_workload_stream;
+
+	return( 1 );
+}
+
+/* Closes the workload stream if opened using a filename
+ * Returns 0 if successful or -1 on error
+ */
+int libfdata_notify_workload_close(
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_notify_workload_close";
+
+	if( libfdata_notify_workload_stream == NULL )
+	{
+		return( 0 );
+	}
+	if( libfdata_notify_workload_function == &libfdata_notify_workload_write )
+	{
+		libfdata_notify_workload_function = NULL;
+		libfdata_notify_workload_data     = NULL;
+	}
+	if( file_stream_close(
+	     libfdata_notify_workload_stream ) != 0 )
+	{
+		libfdata_notify_workload_stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close workload stream.",
+		 function );
+
+		return( -1 );
+	}
+	libfdata_notify_workload_stream = NULL;
+
+	return( 0 );
+}
+
 #endif /* !defined( HAVE_LOCAL_LIBFDATA ) */
 
+/* Retrieves the timestamp used to determine the duration of a traced operation
+ * The timestamp is 0 if tracing is disabled or the timestamp could not be retrieved
+ */
+void libfdata_notify_trace_get_timestamp(
+      int64_t *timestamp )
+{
+	if( timestamp == NULL )
+	{
+		return;
+	}
+	*timestamp = 0;
+
+	if( libfdata_notify_trace_function != NULL )
+	{
+		if( libfcache_date_time_get_timestamp(
+		     timestamp,
+		     NULL ) != 1 )
+		{
+			*timestamp = 0;
+		}
+	}
+}
+
+/* Passes a trace record to the trace function
+ * The duration is determined from the start timestamp, if set
+ */
+void libfdata_notify_trace(
+      uint8_t container_type,
+      uint8_t operation,
+      int index,
+      int file_index,
+      off64_t offset,
+      size64_t size,
+      uint8_t flags,
+      int64_t start_timestamp )
+{
+	uint8_t record_data[ LIBFDATA_TRACE_RECORD_SIZE ];
+
+	int64_t duration      = 0;
+	int64_t end_timestamp = 0;
+
+	if( libfdata_notify_trace_function == NULL )
+	{
+		return;
+	}
+	if( start_timestamp != 0 )
+	{
+		libfdata_notify_trace_get_timestamp(
+		 &end_timestamp );
+
+		if( end_timestamp > start_timestamp )
+		{
+			duration = end_timestamp - start_timestamp;
+		}
+	}
+	record_data[ 0 ] = container_type;
+	record_data[ 1 ] = operation;
+	record_data[ 2 ] = flags;
+	record_data[ 3 ] = 0;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( record_data[ 4 ] ),
+	 (uint32_t) index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( record_data[ 8 ] ),
+	 (uint32_t) file_index );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 12 ] ),
+	 (uint64_t) offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 20 ] ),
+	 (uint64_t) size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 28 ] ),
+	 (uint64_t) duration );
+
+	libfdata_notify_trace_function(
+	 libfdata_notify_trace_data,
+	 record_data,
+	 LIBFDATA_TRACE_RECORD_SIZE );
+}
+
+/* Writes a workload record to the workload stream
+ * Callback function for the workload
+ */
+void libfdata_notify_workload_write(
+      intptr_t *workload_data,
+      const uint8_t *record_data,
+      size_t record_data_size )
+{
+	if( ( workload_data == NULL )
+	 || ( record_data == NULL ) )
+	{
+		return;
+	}
+	file_stream_write(
+	 (FILE *) workload_data,
+	 record_data,
+	 record_data_size );
+}
+
+/* Passes a workload record to the workload function
+ * The container identifier is derived from the container reference
+ */
+void libfdata_notify_workload(
+      uint8_t container_type,
+      uint8_t call,
+      intptr_t *container,
+      int index,
+      int file_index,
+      off64_t offset,
+      size64_t size,
+      uint8_t flags )
+{
+	uint8_t record_data[ LIBFDATA_WORKLOAD_RECORD_SIZE ];
+
+	if( libfdata_notify_workload_function == NULL )
+	{
+		return;
+	}
+	record_data[ 0 ] = container_type;
+	record_data[ 1 ] = call;
+	record_data[ 2 ] = flags;
+	record_data[ 3 ] = 0;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( record_data[ 4 ] ),
+	 (uint32_t) index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( record_data[ 8 ] ),
+	 (uint32_t) file_index );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 12 ] ),
+	 (uint64_t) offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 20 ] ),
+	 (uint64_t) size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 28 ] ),
+	 (uint64_t) (intptr_t) container );
+
+	libfdata_notify_workload_function(
+	 libfdata_notify_workload_data,
+	 record_data,
+	 LIBFDATA_WORKLOAD_RECORD_SIZE );
+}
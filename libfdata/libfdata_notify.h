@@ -33,6 +33,22 @@
 extern "C" {
 #endif
 
+extern void (*libfdata_notify_trace_function)(
+             intptr_t *trace_data,
+             const uint8_t *record_data,
+             size_t record_data_size );
+
+extern intptr_t *libfdata_notify_trace_data;
+
+extern void (*libfdata_notify_workload_function)(
+             intptr_t *workload_data,
+             const uint8_t *record_data,
+             size_t record_data_size );
+
+extern intptr_t *libfdata_notify_workload_data;
+
+extern FILE *libfdata_notify_workload_stream;
+
 #if !defined( HAVE_LOCAL_LIBFDATA )
 
 LIBFDATA_EXTERN \
@@ -53,8 +69,61 @@ LIBFDATA_EXTERN \
 int libfdata_notify_stream_close(
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+void libfdata_notify_set_trace_function(
+      void (*trace_function)(
+             intptr_t *trace_data,
+             const uint8_t *record_data,
+             size_t record_data_size ),
+      intptr_t *trace_data );
+
+LIBFDATA_EXTERN \
+void libfdata_notify_set_workload_function(
+      void (*workload_function)(
+             intptr_t *workload_data,
+             const uint8_t *record_data,
+             size_t record_data_size ),
+      intptr_t *workload_data );
+
+LIBFDATA_EXTERN \
+int libfdata_notify_workload_open(
+     const char *filename,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_notify_workload_close(
+     libcerror_error_t **error );
+
 #endif /* !defined( HAVE_LOCAL_LIBFDATA ) */
 
+void libfdata_notify_trace_get_timestamp(
+      int64_t *timestamp );
+
+void libfdata_notify_trace(
+      uint8_t container_type,
+      uint8_t operation,
+      int index,
+      int file_index,
+      off64_t offset,
+      size64_t size,
+      uint8_t flags,
+      int64_t start_timestamp );
+
+void libfdata_notify_workload_write(
+      intptr_t *workload_data,
+      const uint8_t *record_data,
+      size_t record_data_size );
+
+void libfdata_notify_workload(
+      uint8_t container_type,
+      uint8_t call,
+      intptr_t *container,
+      int index,
+      int file_index,
+      off64_t offset,
+      size64_t size,
+      uint8_t flags );
+
 #if defined( __cplusplus )
 }
 #endif
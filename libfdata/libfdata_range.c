@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_allocator.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_range.h"
 
@@ -58,7 +59,7 @@ int libfdata_range_initialize(
 
 		return( -1 );
 	}
-	*range = memory_allocate_structure(
+	*range = libfdata_allocator_allocate_structure(
 	          libfdata_range_t );
 
 	if( *range == NULL )
@@ -94,7 +95,7 @@ int libfdata_range_initialize(
 on_error:
 	if( *range != NULL )
 	{
-		memory_free(
+		libfdata_allocator_free(
 		 *range );
 
 		*range = NULL;
@@ -124,7 +125,7 @@ int libfdata_range_free(
 	}
 	if( *range != NULL )
 	{
-		memory_free(
+		libfdata_allocator_free(
 		 *range );
 
 		*range = NULL;
@@ -170,7 +171,7 @@ int libfdata_range_clone(
 
 		return( 1 );
 	}
-	*destination_range = memory_allocate_structure(
+	*destination_range = libfdata_allocator_allocate_structure(
 	                      libfdata_range_t );
 
 	if( *destination_range == NULL )
@@ -203,7 +204,7 @@ int libfdata_range_clone(
 on_error:
 	if( *destination_range != NULL )
 	{
-		memory_free(
+		libfdata_allocator_free(
 		 *destination_range );
 
 		*destination_range = NULL;
@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_allocator.h"
 #include "libfdata_definitions.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
@@ -113,7 +114,7 @@ int libfdata_range_list_initialize(
 
 		return( -1 );
 	}
-	internal_range_list = memory_allocate_structure(
+	internal_range_list = libfdata_allocator_allocate_structure(
 	                       libfdata_internal_range_list_t );
 
 	if( internal_range_list == NULL )
@@ -139,7 +140,7 @@ int libfdata_range_list_initialize(
 		 "%s: unable to clear range list.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_range_list );
 
 		return( -1 );
@@ -178,7 +179,7 @@ on_error:
 			 NULL,
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_range_list );
 	}
 	return( -1 );
@@ -255,7 +256,7 @@ int libfdata_range_list_free(
 				}
 			}
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_range_list );
 	}
 	return( result );
@@ -303,7 +304,7 @@ int libfdata_range_list_clone(
 	}
 	internal_source_range_list = (libfdata_internal_range_list_t *) source_range_list;
 
-	internal_destination_range_list = memory_allocate_structure(
+	internal_destination_range_list = libfdata_allocator_allocate_structure(
 	                                   libfdata_internal_range_list_t );
 
 	if( internal_destination_range_list == NULL )
@@ -329,7 +330,7 @@ int libfdata_range_list_clone(
 		 "%s: unable to clear destination range list.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_destination_range_list );
 
 		return( -1 );
@@ -409,7 +410,7 @@ on_error:
 			 &( internal_destination_range_list->data_handle ),
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_destination_range_list );
 	}
 	return( -1 );
@@ -1194,3 +1195,279 @@ int libfdata_range_list_set_element_value_at_offset(
 	return( result );
 }
 
+/* Memory usage functions
+ */
+
+/* Retrieves the memory usage
+ * The structure size contains the size of the range list, an estimate of the size
+ * of its ranges and the structure size of the lists in the range list.
+ * The cached values size contains the cached values size of the lists in the range list.
+ * The cache is optional, without a cache the cached values size is 0
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_range_list_get_memory_usage(
+     libfdata_range_list_t *range_list,
+     libfdata_cache_t *cache,
+     size64_t *structure_size,
+     size64_t *cached_values_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_range_list_t *internal_range_list = NULL;
+	libfdata_list_t *list                               = NULL;
+	static char *function                               = "libfdata_range_list_get_memory_usage";
+	size64_t list_cached_values_size                    = 0;
+	size64_t list_structure_size                        = 0;
+	size64_t safe_cached_values_size                    = 0;
+	size64_t safe_structure_size                        = 0;
+	uint64_t range_offset                               = 0;
+	uint64_t range_size                                 = 0;
+	int number_of_ranges                                = 0;
+	int range_index                                     = 0;
+
+	if( range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( structure_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid structure size.",
+		 function );
+
+		return( -1 );
+	}
+	if( cached_values_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cached values size.",
+		 function );
+
+		return( -1 );
+	}
+	internal_range_list = (libfdata_internal_range_list_t *) range_list;
+
+	if( libcdata_range_list_get_number_of_elements(
+	     internal_range_list->elements_range_list,
+	     &number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of ranges from elements range list.",
+		 function );
+
+		return( -1 );
+	}
+	/* A range consists of a range list value, containing the start, end and size
+	 * of the range and the value, and the list element that stores it
+	 */
+	safe_structure_size = sizeof( libfdata_internal_range_list_t )
+	                    + (size64_t) number_of_ranges * ( ( 3 * sizeof( uint64_t ) ) + ( 4 * sizeof( intptr_t * ) ) );
+
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( libcdata_range_list_get_range_by_index(
+		     internal_range_list->elements_range_list,
+		     range_index,
+		     &range_offset,
+		     &range_size,
+		     (intptr_t **) &list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range: %d from elements range list.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_get_memory_usage(
+		     list,
+		     cache,
+		     &list_structure_size,
+		     &list_cached_values_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve memory usage of list: %d.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		safe_structure_size     += list_structure_size;
+		safe_cached_values_size += list_cached_values_size;
+	}
+	*structure_size     = safe_structure_size;
+	*cached_values_size = safe_cached_values_size;
+
+	return( 1 );
+}
+
+/* IO statistics functions
+ */
+
+/* Retrieves the read latency histogram
+ * The histogram is the sum of the read latency histograms of the lists
+ * in the range list, where bucket N contains the latencies of at least 2^(N-1)
+ * and less than 2^N nanoseconds. The histogram is only maintained when the library
+ * was built with IO statistics support
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_range_list_get_read_latency_histogram(
+     libfdata_range_list_t *range_list,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_IO_STATISTICS )
+	uint64_t list_histogram[ LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+
+	libfdata_internal_range_list_t *internal_range_list = NULL;
+	libfdata_list_t *list                               = NULL;
+	uint64_t range_offset                               = 0;
+	uint64_t range_size                                 = 0;
+	int bucket_index                                    = 0;
+	int number_of_ranges                                = 0;
+	int range_index                                     = 0;
+#endif
+	static char *function                               = "libfdata_range_list_get_read_latency_histogram";
+
+	if( range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of buckets value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	internal_range_list = (libfdata_internal_range_list_t *) range_list;
+
+	if( libcdata_range_list_get_number_of_elements(
+	     internal_range_list->elements_range_list,
+	     &number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of ranges from elements range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     histogram,
+	     0,
+	     sizeof( uint64_t ) * LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear histogram.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( libcdata_range_list_get_range_by_index(
+		     internal_range_list->elements_range_list,
+		     range_index,
+		     &range_offset,
+		     &range_size,
+		     (intptr_t **) &list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range: %d from elements range list.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_get_read_latency_histogram(
+		     list,
+		     list_histogram,
+		     LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read latency histogram of list: %d.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		for( bucket_index = 0;
+		     bucket_index < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS;
+		     bucket_index++ )
+		{
+			histogram[ bucket_index ] += list_histogram[ bucket_index ];
+		}
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
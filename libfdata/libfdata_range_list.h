@@ -206,6 +206,25 @@ int libfdata_range_list_set_element_value_at_offset(
      uint8_t write_flags,
      libcerror_error_t **error );
 
+/* Memory usage functions
+ */
+LIBFDATA_EXTERN \
+int libfdata_range_list_get_memory_usage(
+     libfdata_range_list_t *range_list,
+     libfdata_cache_t *cache,
+     size64_t *structure_size,
+     size64_t *cached_values_size,
+     libcerror_error_t **error );
+
+/* IO statistics functions
+ */
+LIBFDATA_EXTERN \
+int libfdata_range_list_get_read_latency_histogram(
+     libfdata_range_list_t *range_list,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
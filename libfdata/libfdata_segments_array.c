@@ -23,6 +23,8 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_arena.h"
+#include "libfdata_definitions.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
@@ -88,6 +90,8 @@ int libfdata_segments_array_get_segment_by_index(
 int libfdata_segments_array_set_segment_by_index(
      libcdata_array_t *segments_array,
      libcdata_array_t *mapped_ranges_array,
+     libfdata_arena_t *segments_arena,
+     libfdata_arena_t *mapped_ranges_arena,
      size64_t *data_size,
      int segment_index,
      int segment_file_index,
@@ -155,8 +159,9 @@ int libfdata_segments_array_set_segment_by_index(
 	}
 	if( segment_data_range == NULL )
 	{
-		if( libfdata_range_initialize(
-		     &segment_data_range,
+		if( libfdata_arena_allocate_object(
+		     segments_arena,
+		     (intptr_t **) &segment_data_range,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -182,10 +187,6 @@ int libfdata_segments_array_set_segment_by_index(
 			 function,
 			 segment_index );
 
-			libfdata_range_free(
-			 &segment_data_range,
-			 NULL );
-
 			return( -1 );
 		}
 	}
@@ -248,8 +249,9 @@ int libfdata_segments_array_set_segment_by_index(
 	}
 	if( mapped_range == NULL )
 	{
-		if( libfdata_mapped_range_initialize(
-		     &mapped_range,
+		if( libfdata_arena_allocate_object(
+		     mapped_ranges_arena,
+		     (intptr_t **) &mapped_range,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -275,10 +277,6 @@ int libfdata_segments_array_set_segment_by_index(
 			 function,
 			 segment_index );
 
-			libfdata_mapped_range_free(
-			 &mapped_range,
-			 NULL );
-
 			return( -1 );
 		}
 	}
@@ -293,6 +291,8 @@ int libfdata_segments_array_set_segment_by_index(
 int libfdata_segments_array_prepend_segment(
      libcdata_array_t *segments_array,
      libcdata_array_t *mapped_ranges_array,
+     libfdata_arena_t *segments_arena,
+     libfdata_arena_t *mapped_ranges_arena,
      size64_t *data_size,
      int segment_file_index,
      off64_t segment_offset,
@@ -349,8 +349,9 @@ int libfdata_segments_array_prepend_segment(
 
 		return( -1 );
 	}
-	if( libfdata_mapped_range_initialize(
-	     &mapped_range,
+	if( libfdata_arena_allocate_object(
+	     mapped_ranges_arena,
+	     (intptr_t **) &mapped_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -392,8 +393,9 @@ int libfdata_segments_array_prepend_segment(
 
 		goto on_error;
 	}
-	if( libfdata_range_initialize(
-	     &segment_data_range,
+	if( libfdata_arena_allocate_object(
+	     segments_arena,
+	     (intptr_t **) &segment_data_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -441,12 +443,8 @@ int libfdata_segments_array_prepend_segment(
 	return( 1 );
 
 on_error:
-	if( segment_data_range != NULL )
-	{
-		libfdata_range_free(
-		 &segment_data_range,
-		 NULL );
-	}
+	/* The segment data range and mapped range remain owned by the arenas
+	 */
 	if( mapped_range_index != -1 )
 	{
 		libcdata_array_set_entry_by_index(
@@ -455,12 +453,6 @@ on_error:
 		 NULL,
 		 NULL );
 	}
-	if( mapped_range != NULL )
-	{
-		libfdata_mapped_range_free(
-		 &mapped_range,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -470,6 +462,8 @@ on_error:
 int libfdata_segments_array_append_segment(
      libcdata_array_t *segments_array,
      libcdata_array_t *mapped_ranges_array,
+     libfdata_arena_t *segments_arena,
+     libfdata_arena_t *mapped_ranges_arena,
      size64_t *data_size,
      int *segment_index,
      int segment_file_index,
@@ -478,10 +472,13 @@ int libfdata_segments_array_append_segment(
      uint32_t segment_flags,
      libcerror_error_t **error )
 {
-	libfdata_mapped_range_t *mapped_range = NULL;
-	libfdata_range_t *segment_data_range  = NULL;
-	static char *function                 = "libfdata_segments_array_append_segment";
-	int mapped_range_index                = -1;
+	libfdata_mapped_range_t *last_mapped_range = NULL;
+	libfdata_mapped_range_t *mapped_range      = NULL;
+	libfdata_range_t *segment_data_range       = NULL;
+	static char *function                      = "libfdata_segments_array_append_segment";
+	int mapped_range_index                     = -1;
+	int number_of_mapped_ranges                = 0;
+	int number_of_sparse_segments              = 0;
 
 	if( data_size == NULL )
 	{
@@ -516,8 +513,9 @@ int libfdata_segments_array_append_segment(
 
 		return( -1 );
 	}
-	if( libfdata_mapped_range_initialize(
-	     &mapped_range,
+	if( libfdata_arena_allocate_object(
+	     mapped_ranges_arena,
+	     (intptr_t **) &mapped_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -544,6 +542,49 @@ int libfdata_segments_array_append_segment(
 
 		goto on_error;
 	}
+	if( libcdata_array_get_number_of_entries(
+	     mapped_ranges_array,
+	     &number_of_mapped_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from mapped ranges array.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_mapped_ranges > 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     mapped_ranges_array,
+		     number_of_mapped_ranges - 1,
+		     (intptr_t **) &last_mapped_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from mapped ranges array.",
+			 function,
+			 number_of_mapped_ranges - 1 );
+
+			goto on_error;
+		}
+		if( last_mapped_range != NULL )
+		{
+			number_of_sparse_segments = last_mapped_range->number_of_sparse_segments;
+		}
+	}
+	if( ( segment_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		number_of_sparse_segments++;
+	}
+	mapped_range->number_of_sparse_segments = number_of_sparse_segments;
+
 	if( libcdata_array_append_entry(
 	     mapped_ranges_array,
 	     &mapped_range_index,
@@ -559,8 +600,9 @@ int libfdata_segments_array_append_segment(
 
 		goto on_error;
 	}
-	if( libfdata_range_initialize(
-	     &segment_data_range,
+	if( libfdata_arena_allocate_object(
+	     segments_arena,
+	     (intptr_t **) &segment_data_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -633,12 +675,8 @@ int libfdata_segments_array_append_segment(
 	return( 1 );
 
 on_error:
-	if( segment_data_range != NULL )
-	{
-		libfdata_range_free(
-		 &segment_data_range,
-		 NULL );
-	}
+	/* The segment data range and mapped range remain owned by the arenas
+	 */
 	if( mapped_range_index != -1 )
 	{
 		libcdata_array_set_entry_by_index(
@@ -647,12 +685,6 @@ on_error:
 		 NULL,
 		 NULL );
 	}
-	if( mapped_range != NULL )
-	{
-		libfdata_mapped_range_free(
-		 &mapped_range,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -672,6 +704,7 @@ int libfdata_segments_array_calculate_mapped_ranges(
 	size64_t segment_size                 = 0;
 	uint32_t segment_flags                = 0;
 	int number_of_segments                = 0;
+	int number_of_sparse_segments         = 0;
 	int segment_file_index                = 0;
 	int segment_index                     = 0;
 
@@ -780,6 +813,12 @@ int libfdata_segments_array_calculate_mapped_ranges(
 
 			return( -1 );
 		}
+		if( ( segment_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			number_of_sparse_segments++;
+		}
+		mapped_range->number_of_sparse_segments = number_of_sparse_segments;
+
 		mapped_offset += (off64_t) segment_size;
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -912,3 +951,99 @@ int libfdata_segments_array_get_data_range_at_offset(
 	return( 1 );
 }
 
+/* Retrieves the memory usage of the segments and mapped ranges arrays
+ * The memory usage consists of the array entries and the arenas of the segment data ranges and the mapped ranges
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_array_get_memory_usage(
+     libcdata_array_t *segments_array,
+     libcdata_array_t *mapped_ranges_array,
+     libfdata_arena_t *segments_arena,
+     libfdata_arena_t *mapped_ranges_arena,
+     size64_t *memory_usage,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfdata_segments_array_get_memory_usage";
+	size64_t arena_memory_usage = 0;
+	size64_t safe_memory_usage  = 0;
+	int number_of_mapped_ranges = 0;
+	int number_of_segments      = 0;
+
+	if( memory_usage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory usage.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     mapped_ranges_array,
+	     &number_of_mapped_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of mapped ranges from array.",
+		 function );
+
+		return( -1 );
+	}
+	safe_memory_usage = (size64_t) ( number_of_segments + number_of_mapped_ranges ) * sizeof( intptr_t * );
+
+	if( libfdata_arena_get_memory_usage(
+	     segments_arena,
+	     &arena_memory_usage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory usage of segments arena.",
+		 function );
+
+		return( -1 );
+	}
+	safe_memory_usage += arena_memory_usage;
+
+	if( libfdata_arena_get_memory_usage(
+	     mapped_ranges_arena,
+	     &arena_memory_usage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory usage of mapped ranges arena.",
+		 function );
+
+		return( -1 );
+	}
+	safe_memory_usage += arena_memory_usage;
+
+	*memory_usage = safe_memory_usage;
+
+	return( 1 );
+}
+
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfdata_arena.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_range.h"
@@ -41,6 +42,8 @@ int libfdata_segments_array_get_segment_by_index(
 int libfdata_segments_array_set_segment_by_index(
      libcdata_array_t *segments_array,
      libcdata_array_t *mapped_ranges_array,
+     libfdata_arena_t *segments_arena,
+     libfdata_arena_t *mapped_ranges_arena,
      size64_t *data_size,
      int segment_index,
      int segment_file_index,
@@ -52,6 +55,8 @@ int libfdata_segments_array_set_segment_by_index(
 int libfdata_segments_array_prepend_segment(
      libcdata_array_t *segments_array,
      libcdata_array_t *mapped_ranges_array,
+     libfdata_arena_t *segments_arena,
+     libfdata_arena_t *mapped_ranges_arena,
      size64_t *data_size,
      int segment_file_index,
      off64_t segment_offset,
@@ -62,6 +67,8 @@ int libfdata_segments_array_prepend_segment(
 int libfdata_segments_array_append_segment(
      libcdata_array_t *segments_array,
      libcdata_array_t *mapped_ranges_array,
+     libfdata_arena_t *segments_arena,
+     libfdata_arena_t *mapped_ranges_arena,
      size64_t *data_size,
      int *segment_index,
      int segment_file_index,
@@ -82,6 +89,14 @@ int libfdata_segments_array_get_data_range_at_offset(
      libfdata_range_t **segment_data_range,
      libcerror_error_t **error );
 
+int libfdata_segments_array_get_memory_usage(
+     libcdata_array_t *segments_array,
+     libcdata_array_t *mapped_ranges_array,
+     libfdata_arena_t *segments_arena,
+     libfdata_arena_t *mapped_ranges_arena,
+     size64_t *memory_usage,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 extern "C" {
 #endif
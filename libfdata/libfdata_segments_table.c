@@ -0,0 +1,942 @@
+/*
+ * The segments table functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_allocator.h"
+#include "libfdata_arena.h"
+#include "libfdata_libcdata.h"
+#include "libfdata_libcerror.h"
+#include "libfdata_libcthreads.h"
+#include "libfdata_mapped_range.h"
+#include "libfdata_range.h"
+#include "libfdata_segments_array.h"
+#include "libfdata_segments_table.h"
+
+/* Creates a segments table
+ * The segments table contains the segments and mapped ranges arrays and the arenas
+ * their values are allocated from. It can be shared by multiple containers and
+ * is copied when a container that shares it is modified
+ * Make sure the value segments_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_table_initialize(
+     libfdata_segments_table_t **segments_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_segments_table_initialize";
+
+	if( segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segments_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segments table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segments_table = libfdata_allocator_allocate_structure(
+	                   libfdata_segments_table_t );
+
+	if( *segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segments_table,
+	     0,
+	     sizeof( libfdata_segments_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segments table.",
+		 function );
+
+		libfdata_allocator_free(
+		 *segments_table );
+
+		*segments_table = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *segments_table )->segments_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *segments_table )->mapped_ranges_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mapped ranges array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_arena_initialize(
+	     &( ( *segments_table )->segments_arena ),
+	     sizeof( libfdata_range_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_arena_initialize(
+	     &( ( *segments_table )->mapped_ranges_arena ),
+	     sizeof( libfdata_mapped_range_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mapped ranges arena.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_lock_initialize(
+	     &( ( *segments_table )->reference_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reference lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *segments_table )->number_of_references = 1;
+
+	return( 1 );
+
+on_error:
+	if( *segments_table != NULL )
+	{
+		if( ( *segments_table )->mapped_ranges_arena != NULL )
+		{
+			libfdata_arena_free(
+			 &( ( *segments_table )->mapped_ranges_arena ),
+			 NULL );
+		}
+		if( ( *segments_table )->segments_arena != NULL )
+		{
+			libfdata_arena_free(
+			 &( ( *segments_table )->segments_arena ),
+			 NULL );
+		}
+		if( ( *segments_table )->mapped_ranges_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *segments_table )->mapped_ranges_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *segments_table )->segments_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *segments_table )->segments_array ),
+			 NULL,
+			 NULL );
+		}
+		libfdata_allocator_free(
+		 *segments_table );
+
+		*segments_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segments table
+ * The segments table is only freed when its last reference is released
+ * The number of references is changed under the reference lock when
+ * multi-threading support is enabled
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_table_free(
+     libfdata_segments_table_t **segments_table,
+     libcerror_error_t **error )
+{
+	libfdata_segments_table_t *safe_segments_table = NULL;
+	static char *function                          = "libfdata_segments_table_free";
+	int number_of_references                       = 0;
+	int result                                     = 1;
+
+	if( segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segments_table != NULL )
+	{
+		safe_segments_table = *segments_table;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_lock_grab(
+		     safe_segments_table->reference_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab reference lock.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		safe_segments_table->number_of_references -= 1;
+
+		number_of_references = safe_segments_table->number_of_references;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_lock_release(
+		     safe_segments_table->reference_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release reference lock.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		*segments_table = NULL;
+
+		if( number_of_references > 0 )
+		{
+			return( 1 );
+		}
+		if( libcdata_array_free(
+		     &( safe_segments_table->segments_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free the segments array.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_array_free(
+		     &( safe_segments_table->mapped_ranges_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free the mapped ranges array.",
+			 function );
+
+			result = -1;
+		}
+		if( libfdata_arena_free(
+		     &( safe_segments_table->segments_arena ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free the segments arena.",
+			 function );
+
+			result = -1;
+		}
+		if( libfdata_arena_free(
+		     &( safe_segments_table->mapped_ranges_arena ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free the mapped ranges arena.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_lock_free(
+		     &( safe_segments_table->reference_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reference lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		libfdata_allocator_free(
+		 safe_segments_table );
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the segments table
+ * The segments and mapped ranges are copied into a new segments table
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_table_clone(
+     libfdata_segments_table_t **destination_segments_table,
+     libfdata_segments_table_t *source_segments_table,
+     libcerror_error_t **error )
+{
+	libfdata_segments_table_t *safe_segments_table = NULL;
+	static char *function                          = "libfdata_segments_table_clone";
+
+	if( destination_segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination segments table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_segments_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination segments table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_segments_table == NULL )
+	{
+		*destination_segments_table = NULL;
+
+		return( 1 );
+	}
+	safe_segments_table = libfdata_allocator_allocate_structure(
+	                       libfdata_segments_table_t );
+
+	if( safe_segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination segments table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_segments_table,
+	     0,
+	     sizeof( libfdata_segments_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination segments table.",
+		 function );
+
+		libfdata_allocator_free(
+		 safe_segments_table );
+
+		return( -1 );
+	}
+	if( libfdata_arena_initialize(
+	     &( safe_segments_table->segments_arena ),
+	     sizeof( libfdata_range_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination segments arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_arena_initialize(
+	     &( safe_segments_table->mapped_ranges_arena ),
+	     sizeof( libfdata_mapped_range_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination mapped ranges arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_arena_clone_array(
+	     safe_segments_table->segments_arena,
+	     &( safe_segments_table->segments_array ),
+	     source_segments_table->segments_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination segments array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_arena_clone_array(
+	     safe_segments_table->mapped_ranges_arena,
+	     &( safe_segments_table->mapped_ranges_array ),
+	     source_segments_table->mapped_ranges_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination mapped ranges array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_lock_initialize(
+	     &( safe_segments_table->reference_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize destination reference lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	safe_segments_table->number_of_references = 1;
+
+	*destination_segments_table = safe_segments_table;
+
+	return( 1 );
+
+on_error:
+	if( safe_segments_table != NULL )
+	{
+		if( safe_segments_table->mapped_ranges_array != NULL )
+		{
+			libcdata_array_free(
+			 &( safe_segments_table->mapped_ranges_array ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+			 NULL );
+		}
+		if( safe_segments_table->segments_array != NULL )
+		{
+			libcdata_array_free(
+			 &( safe_segments_table->segments_array ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+			 NULL );
+		}
+		if( safe_segments_table->mapped_ranges_arena != NULL )
+		{
+			libfdata_arena_free(
+			 &( safe_segments_table->mapped_ranges_arena ),
+			 NULL );
+		}
+		if( safe_segments_table->segments_arena != NULL )
+		{
+			libfdata_arena_free(
+			 &( safe_segments_table->segments_arena ),
+			 NULL );
+		}
+		libfdata_allocator_free(
+		 safe_segments_table );
+	}
+	return( -1 );
+}
+
+/* Adds a reference to the segments table
+ * The destination segments table shares the segments and mapped ranges with the source
+ * The number of references is changed under the reference lock when
+ * multi-threading support is enabled
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_table_reference(
+     libfdata_segments_table_t **destination_segments_table,
+     libfdata_segments_table_t *source_segments_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_segments_table_reference";
+	int result            = 1;
+
+	if( destination_segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination segments table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_segments_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination segments table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source segments table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_lock_grab(
+	     source_segments_table->reference_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference lock.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( source_segments_table->number_of_references == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source segments table - number of references value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		source_segments_table->number_of_references += 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_lock_release(
+	     source_segments_table->reference_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference lock.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	*destination_segments_table = source_segments_table;
+
+	return( 1 );
+}
+
+/* Makes sure the segments table is not shared before it is modified
+ * If the segments table is shared it is replaced by a copy
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_table_make_writable(
+     libfdata_segments_table_t **segments_table,
+     libcerror_error_t **error )
+{
+	libfdata_segments_table_t *safe_segments_table = NULL;
+	static char *function                          = "libfdata_segments_table_make_writable";
+	int number_of_references                       = 0;
+
+	if( segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segments table value missing.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_lock_grab(
+	     ( *segments_table )->reference_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference lock.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	number_of_references = ( *segments_table )->number_of_references;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_lock_release(
+	     ( *segments_table )->reference_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference lock.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( number_of_references <= 1 )
+	{
+		return( 1 );
+	}
+	if( libfdata_segments_table_clone(
+	     &safe_segments_table,
+	     *segments_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments table.",
+		 function );
+
+		return( -1 );
+	}
+	/* The other references could have been released since the number of references
+	 * was read, in which case releasing this reference frees the segments table
+	 */
+	if( libfdata_segments_table_free(
+	     segments_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release segments table reference.",
+		 function );
+
+		libfdata_segments_table_free(
+		 &safe_segments_table,
+		 NULL );
+
+		return( -1 );
+	}
+	*segments_table = safe_segments_table;
+
+	return( 1 );
+}
+
+/* Empties the segments table
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_table_empty(
+     libfdata_segments_table_t *segments_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_segments_table_empty";
+
+	if( segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_empty(
+	     segments_table->segments_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_empty(
+	     segments_table->mapped_ranges_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty mapped ranges array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_arena_empty(
+	     segments_table->segments_arena,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segments arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_arena_empty(
+	     segments_table->mapped_ranges_arena,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty mapped ranges arena.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Resizes the segments table
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_table_resize(
+     libfdata_segments_table_t *segments_table,
+     int number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_segments_table_resize";
+
+	if( segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_resize(
+	     segments_table->segments_array,
+	     number_of_segments,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_resize(
+	     segments_table->mapped_ranges_array,
+	     number_of_segments,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_arena_free_object,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize mapped ranges array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the memory usage of the segments table
+ * A shared segments table is accounted in full to every container that references it
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_segments_table_get_memory_usage(
+     libfdata_segments_table_t *segments_table,
+     size64_t *memory_usage,
+     libcerror_error_t **error )
+{
+	static char *function      = "libfdata_segments_table_get_memory_usage";
+	size64_t safe_memory_usage = 0;
+
+	if( segments_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments table.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_usage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory usage.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_segments_array_get_memory_usage(
+	     segments_table->segments_array,
+	     segments_table->mapped_ranges_array,
+	     segments_table->segments_arena,
+	     segments_table->mapped_ranges_arena,
+	     &safe_memory_usage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory usage of segments.",
+		 function );
+
+		return( -1 );
+	}
+	*memory_usage = sizeof( libfdata_segments_table_t ) + safe_memory_usage;
+
+	return( 1 );
+}
+
@@ -0,0 +1,109 @@
+/*
+ * The segments table functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFDATA_SEGMENTS_TABLE_H )
+#define _LIBFDATA_SEGMENTS_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_arena.h"
+#include "libfdata_libcdata.h"
+#include "libfdata_libcerror.h"
+#include "libfdata_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfdata_segments_table libfdata_segments_table_t;
+
+struct libfdata_segments_table
+{
+	/* The segments array
+	 */
+	libcdata_array_t *segments_array;
+
+	/* The mapped ranges array
+	 */
+	libcdata_array_t *mapped_ranges_array;
+
+	/* The segment data ranges arena
+	 */
+	libfdata_arena_t *segments_arena;
+
+	/* The mapped ranges arena
+	 */
+	libfdata_arena_t *mapped_ranges_arena;
+
+	/* The number of references
+	 */
+	int number_of_references;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The lock that protects the number of references
+	 */
+	libcthreads_lock_t *reference_lock;
+#endif
+};
+
+int libfdata_segments_table_initialize(
+     libfdata_segments_table_t **segments_table,
+     libcerror_error_t **error );
+
+int libfdata_segments_table_free(
+     libfdata_segments_table_t **segments_table,
+     libcerror_error_t **error );
+
+int libfdata_segments_table_clone(
+     libfdata_segments_table_t **destination_segments_table,
+     libfdata_segments_table_t *source_segments_table,
+     libcerror_error_t **error );
+
+int libfdata_segments_table_reference(
+     libfdata_segments_table_t **destination_segments_table,
+     libfdata_segments_table_t *source_segments_table,
+     libcerror_error_t **error );
+
+int libfdata_segments_table_make_writable(
+     libfdata_segments_table_t **segments_table,
+     libcerror_error_t **error );
+
+int libfdata_segments_table_empty(
+     libfdata_segments_table_t *segments_table,
+     libcerror_error_t **error );
+
+int libfdata_segments_table_resize(
+     libfdata_segments_table_t *segments_table,
+     int number_of_segments,
+     libcerror_error_t **error );
+
+int libfdata_segments_table_get_memory_usage(
+     libfdata_segments_table_t *segments_table,
+     size64_t *memory_usage,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_SEGMENTS_TABLE_H ) */
+
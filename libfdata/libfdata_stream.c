@@ -27,12 +27,16 @@
 #include <unistd.h>
 #endif
 
+#include "libfdata_allocator.h"
 #include "libfdata_definitions.h"
+#include "libfdata_latency_histogram.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
 #include "libfdata_mapped_range.h"
+#include "libfdata_notify.h"
 #include "libfdata_range.h"
 #include "libfdata_segments_array.h"
+#include "libfdata_segments_table.h"
 #include "libfdata_stream.h"
 #include "libfdata_types.h"
 #include "libfdata_unused.h"
@@ -131,7 +135,7 @@ int libfdata_stream_initialize(
 
 		return( -1 );
 	}
-	internal_stream = memory_allocate_structure(
+	internal_stream = libfdata_allocator_allocate_structure(
 	                   libfdata_internal_stream_t );
 
 	if( internal_stream == NULL )
@@ -157,35 +161,20 @@ int libfdata_stream_initialize(
 		 "%s: unable to clear stream.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_stream );
 
 		return( -1 );
 	}
-	if( libcdata_array_initialize(
-	     &( internal_stream->segments_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segments array.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcdata_array_initialize(
-	     &( internal_stream->mapped_ranges_array ),
-	     0,
+	if( libfdata_segments_table_initialize(
+	     &( internal_stream->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create mapped ranges array.",
+		 "%s: unable to create segments table.",
 		 function );
 
 		goto on_error;
@@ -200,6 +189,19 @@ int libfdata_stream_initialize(
 	internal_stream->write_segment_data  = write_segment_data;
 	internal_stream->seek_segment_offset = seek_segment_offset;
 
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_STREAM,
+		 LIBFDATA_WORKLOAD_CALL_INITIALIZE,
+		 (intptr_t *) internal_stream,
+		 0,
+		 0,
+		 0,
+		 0,
+		 0 );
+	}
+
 	*stream = (libfdata_stream_t *) internal_stream;
 
 	return( 1 );
@@ -207,168 +209,120 @@ int libfdata_stream_initialize(
 on_error:
 	if( internal_stream != NULL )
 	{
-		if( internal_stream->segments_array != NULL )
+		if( internal_stream->segments_table != NULL )
 		{
-			libcdata_array_free(
-			 &( internal_stream->segments_array ),
-			 NULL,
+			libfdata_segments_table_free(
+			 &( internal_stream->segments_table ),
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_stream );
 	}
 	return( -1 );
 }
 
-/* Frees a stream
+/* Creates a slice of a stream
+ * The slice is a read-only view of size bytes of the source stream starting at offset
+ * The slice shares the segments and the data handle of the source stream,
+ * hence the source stream must remain available while the slice is used
+ * Make sure the value slice_stream is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_free(
-     libfdata_stream_t **stream,
+int libfdata_stream_initialize_slice(
+     libfdata_stream_t **slice_stream,
+     libfdata_stream_t *source_stream,
+     off64_t offset,
+     size64_t size,
      libcerror_error_t **error )
 {
-	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_free";
-	int result                                  = 1;
+	libfdata_internal_stream_t *internal_slice_stream  = NULL;
+	libfdata_internal_stream_t *internal_source_stream = NULL;
+	static char *function                              = "libfdata_stream_initialize_slice";
+	size64_t source_size                               = 0;
 
-	if( stream == NULL )
+	if( slice_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stream.",
+		 "%s: invalid slice stream.",
 		 function );
 
 		return( -1 );
 	}
-	if( *stream != NULL )
+	if( *slice_stream != NULL )
 	{
-		internal_stream = (libfdata_internal_stream_t *) *stream;
-		*stream         = NULL;
-
-		if( libcdata_array_free(
-		     &( internal_stream->segments_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the segments array.",
-			 function );
-
-			result = -1;
-		}
-		if( libcdata_array_free(
-		     &( internal_stream->mapped_ranges_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the mapped ranges array.",
-			 function );
-
-			result = -1;
-		}
-		if( ( internal_stream->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
-		{
-			if( internal_stream->data_handle != NULL )
-			{
-				if( internal_stream->free_data_handle == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: invalid source stream - missing free data handle function.",
-					 function );
-
-					result = -1;
-				}
-				else if( internal_stream->free_data_handle(
-				          &( internal_stream->data_handle ),
-				          error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free data handle.",
-					 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid slice stream value already set.",
+		 function );
 
-					result = -1;
-				}
-			}
-		}
-		memory_free(
-		 internal_stream );
+		return( -1 );
 	}
-	return( result );
-}
-
-/* Clones (duplicates) the stream
- * Returns 1 if successful or -1 on error
- */
-int libfdata_stream_clone(
-     libfdata_stream_t **destination_stream,
-     libfdata_stream_t *source_stream,
-     libcerror_error_t **error )
-{
-	libfdata_internal_stream_t *internal_destination_stream = NULL;
-	libfdata_internal_stream_t *internal_source_stream      = NULL;
-	static char *function                                   = "libfdata_stream_clone";
-
-	if( destination_stream == NULL )
+	if( source_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid destination stream.",
+		 "%s: invalid source stream.",
 		 function );
 
 		return( -1 );
 	}
-	if( *destination_stream != NULL )
+	internal_source_stream = (libfdata_internal_stream_t *) source_stream;
+
+	if( internal_source_stream->mapped_size != 0 )
+	{
+		source_size = internal_source_stream->mapped_size;
+	}
+	else
+	{
+		source_size = internal_source_stream->size;
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset > source_size ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: destination stream already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( source_stream == NULL )
+	if( ( size == 0 )
+	 || ( size > ( source_size - (size64_t) offset ) ) )
 	{
-		*destination_stream = NULL;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
 
-		return( 1 );
+		return( -1 );
 	}
-	internal_source_stream = (libfdata_internal_stream_t *) source_stream;
+	internal_slice_stream = libfdata_allocator_allocate_structure(
+	                         libfdata_internal_stream_t );
 
-	internal_destination_stream = memory_allocate_structure(
-	                               libfdata_internal_stream_t );
-
-	if( internal_destination_stream == NULL )
+	if( internal_slice_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create destination stream.",
+		 "%s: unable to create slice stream.",
 		 function );
 
 		goto on_error;
 	}
 	if( memory_set(
-	     internal_destination_stream,
+	     internal_slice_stream,
 	     0,
 	     sizeof( libfdata_internal_stream_t ) ) == NULL )
 	{
@@ -376,291 +330,431 @@ int libfdata_stream_clone(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear destination stream.",
+		 "%s: unable to clear slice stream.",
 		 function );
 
-		memory_free(
-		 internal_destination_stream );
+		libfdata_allocator_free(
+		 internal_slice_stream );
 
 		return( -1 );
 	}
-	if( internal_source_stream->data_handle != NULL )
+	if( ( internal_source_stream->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
-		if( internal_source_stream->free_data_handle == NULL )
+		/* Calculate the mapped ranges before the segments table is shared
+		 */
+		if( libfdata_segments_table_make_writable(
+		     &( internal_source_stream->segments_table ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid source stream - missing free data handle function.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
 			 function );
 
 			goto on_error;
 		}
-		if( internal_source_stream->clone_data_handle == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid source stream - missing clone data handle function.",
-			 function );
+		internal_source_stream->current_segment_data_range = NULL;
 
-			goto on_error;
-		}
-		if( internal_source_stream->clone_data_handle(
-		     &( internal_destination_stream->data_handle ),
-		     internal_source_stream->data_handle,
+		if( libfdata_segments_array_calculate_mapped_ranges(
+		     internal_source_stream->segments_table->segments_array,
+		     internal_source_stream->segments_table->mapped_ranges_array,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination data handle.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate mapped ranges.",
 			 function );
 
 			goto on_error;
 		}
+		internal_source_stream->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
 	}
-	if( libcdata_array_clone(
-	     &( internal_destination_stream->segments_array ),
-	     internal_source_stream->segments_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_range_clone,
+	if( libfdata_segments_table_reference(
+	     &( internal_slice_stream->segments_table ),
+	     internal_source_stream->segments_table,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination segments array.",
+		 "%s: unable to reference source segments table.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcdata_array_clone(
-	     &( internal_destination_stream->mapped_ranges_array ),
-	     internal_source_stream->mapped_ranges_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_mapped_range_clone,
+	/* The data handle is shared with the source stream and therefore not managed
+	 * by the slice. No create segment functions are set since a slice cannot be
+	 * written beyond its end.
+	 */
+	internal_slice_stream->size                = internal_source_stream->size;
+	internal_slice_stream->mapped_size         = size;
+	internal_slice_stream->slice_offset        = internal_source_stream->slice_offset + offset;
+	internal_slice_stream->flags               = LIBFDATA_FLAG_IS_SLICE;
+	internal_slice_stream->data_handle         = internal_source_stream->data_handle;
+	internal_slice_stream->free_data_handle    = internal_source_stream->free_data_handle;
+	internal_slice_stream->clone_data_handle   = internal_source_stream->clone_data_handle;
+	internal_slice_stream->read_segment_data   = internal_source_stream->read_segment_data;
+	internal_slice_stream->write_segment_data  = internal_source_stream->write_segment_data;
+	internal_slice_stream->seek_segment_offset = internal_source_stream->seek_segment_offset;
+
+	internal_slice_stream->maximum_read_ahead_size = internal_source_stream->maximum_read_ahead_size;
+	internal_slice_stream->read_alignment          = internal_source_stream->read_alignment;
+	internal_slice_stream->read_segment_data_batch = internal_source_stream->read_segment_data_batch;
+
+	if( libfdata_stream_get_segment_index_at_offset(
+	     (libfdata_stream_t *) internal_slice_stream,
+	     0,
+	     &( internal_slice_stream->current_segment_index ),
+	     &( internal_slice_stream->segment_data_offset ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination mapped ranges array.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index at start of slice.",
 		 function );
 
 		goto on_error;
 	}
-	internal_destination_stream->size                = internal_source_stream->size;
-	internal_destination_stream->mapped_size         = internal_source_stream->mapped_size;
-	internal_destination_stream->flags               = internal_source_stream->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
-	internal_destination_stream->free_data_handle    = internal_source_stream->free_data_handle;
-	internal_destination_stream->clone_data_handle   = internal_source_stream->clone_data_handle;
-	internal_destination_stream->create_segment      = internal_source_stream->create_segment;
-	internal_destination_stream->read_segment_data   = internal_source_stream->read_segment_data;
-	internal_destination_stream->write_segment_data  = internal_source_stream->write_segment_data;
-	internal_destination_stream->seek_segment_offset = internal_source_stream->seek_segment_offset;
-
-	*destination_stream = (libfdata_stream_t *) internal_destination_stream;
+	*slice_stream = (libfdata_stream_t *) internal_slice_stream;
 
 	return( 1 );
 
 on_error:
-	if( internal_destination_stream != NULL )
+	if( internal_slice_stream != NULL )
 	{
-		if( internal_destination_stream->segments_array != NULL )
-		{
-			libcdata_array_free(
-			 &( internal_destination_stream->segments_array ),
-			 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
-			 NULL );
-		}
-		if( ( internal_destination_stream->data_handle != NULL )
-		 && ( internal_source_stream->free_data_handle != NULL ) )
+		if( internal_slice_stream->segments_table != NULL )
 		{
-			internal_source_stream->free_data_handle(
-			 &( internal_destination_stream->data_handle ),
+			libfdata_segments_table_free(
+			 &( internal_slice_stream->segments_table ),
 			 NULL );
 		}
-		memory_free(
-		 internal_destination_stream );
+		libfdata_allocator_free(
+		 internal_slice_stream );
 	}
 	return( -1 );
 }
 
-/* Segment functions
- */
-
-/* Empties the stream
+/* Creates a composed stream of an upper stream which segments are stored in a lower stream
+ * The segment offsets of the upper stream are offsets in the lower stream, regardless of
+ * their file index. The segments of the composed stream are the physical extents
+ * of the lower stream, hence reading the composed stream does not require the upper stream.
+ * The composed stream uses a clone of the data handle and the segment data functions
+ * of the lower stream, where the segment index passed to these functions is the index
+ * of the segment in the composed stream
+ * Make sure the value composed_stream is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_empty(
-     libfdata_stream_t *stream,
+int libfdata_stream_initialize_composed(
+     libfdata_stream_t **composed_stream,
+     libfdata_stream_t *upper_stream,
+     libfdata_stream_t *lower_stream,
      libcerror_error_t **error )
 {
-	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_empty";
-
-	if( stream == NULL )
+	libfdata_internal_stream_t *internal_lower_stream = NULL;
+	libfdata_stream_t *safe_composed_stream           = NULL;
+	intptr_t *data_handle                             = NULL;
+	static char *function                             = "libfdata_stream_initialize_composed";
+	off64_t extent_offset                             = 0;
+	off64_t lower_offset                              = 0;
+	off64_t pending_offset                            = 0;
+	off64_t upper_extent_offset                       = 0;
+	off64_t upper_offset                              = 0;
+	size64_t extent_size                              = 0;
+	size64_t pending_size                             = 0;
+	size64_t remaining_size                           = 0;
+	size64_t upper_extent_size                        = 0;
+	size64_t upper_size                               = 0;
+	uint32_t extent_flags                             = 0;
+	uint32_t pending_flags                            = 0;
+	uint32_t upper_extent_flags                       = 0;
+	int extent_file_index                             = 0;
+	int pending_file_index                            = 0;
+	int result                                        = 0;
+	int segment_index                                 = 0;
+	int upper_extent_file_index                       = 0;
+
+	if( composed_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stream.",
+		 "%s: invalid composed stream.",
 		 function );
 
 		return( -1 );
 	}
-	internal_stream = (libfdata_internal_stream_t *) stream;
-
-	if( libcdata_array_empty(
-	     internal_stream->segments_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
-	     error ) != 1 )
+	if( *composed_stream != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty segments array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid composed stream value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_stream->mapped_ranges_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-	     error ) != 1 )
+	if( upper_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty mapped ranges array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upper stream.",
 		 function );
 
 		return( -1 );
 	}
-	internal_stream->size = 0;
-
-	return( 1 );
-}
-
-/* Resizes the stream
- * Returns 1 if successful or -1 on error
- */
-int libfdata_stream_resize(
-     libfdata_stream_t *stream,
-     int number_of_segments,
-     libcerror_error_t **error )
-{
-	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_resize";
-
-	if( stream == NULL )
+	if( lower_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stream.",
+		 "%s: invalid lower stream.",
 		 function );
 
 		return( -1 );
 	}
-	internal_stream = (libfdata_internal_stream_t *) stream;
+	internal_lower_stream = (libfdata_internal_stream_t *) lower_stream;
 
-	if( libcdata_array_resize(
-	     internal_stream->segments_array,
-	     number_of_segments,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
+	if( internal_lower_stream->data_handle != NULL )
+	{
+		if( internal_lower_stream->clone_data_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid lower stream - missing clone data handle function.",
+			 function );
+
+			goto on_error;
+		}
+		if( internal_lower_stream->clone_data_handle(
+		     &data_handle,
+		     internal_lower_stream->data_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfdata_stream_initialize(
+	     &safe_composed_stream,
+	     data_handle,
+	     internal_lower_stream->free_data_handle,
+	     internal_lower_stream->clone_data_handle,
+	     NULL,
+	     internal_lower_stream->read_segment_data,
+	     internal_lower_stream->write_segment_data,
+	     internal_lower_stream->seek_segment_offset,
+	     LIBFDATA_DATA_HANDLE_FLAG_MANAGED,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize segments array.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create composed stream.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libcdata_array_resize(
-	     internal_stream->mapped_ranges_array,
-	     number_of_segments,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
+	/* The composed stream now manages the data handle
+	 */
+	data_handle = NULL;
+
+	( (libfdata_internal_stream_t *) safe_composed_stream )->read_segment_data_batch = internal_lower_stream->read_segment_data_batch;
+
+	if( libfdata_stream_get_size(
+	     upper_stream,
+	     &upper_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize mapped ranges array.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve upper stream size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_stream->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
-
-	return( 1 );
-}
+	while( (size64_t) upper_offset < upper_size )
+	{
+		result = libfdata_stream_get_extent_at_offset(
+		          upper_stream,
+		          upper_offset,
+		          upper_size - (size64_t) upper_offset,
+		          &upper_extent_file_index,
+		          &upper_extent_offset,
+		          &upper_extent_size,
+		          &upper_extent_flags,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve upper stream extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 upper_offset,
+			 upper_offset );
 
-/* Reverses the order of the segments
- * Returns 1 if successful or -1 on error
- */
-int libfdata_stream_reverse(
-     libfdata_stream_t *stream,
-     libcerror_error_t **error )
-{
-	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_reverse";
+			goto on_error;
+		}
+		lower_offset   = upper_extent_offset;
+		remaining_size = upper_extent_size;
 
-	if( stream == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stream.",
-		 function );
+		while( remaining_size > 0 )
+		{
+			/* Sparse extents of the upper stream are not stored in the lower stream
+			 */
+			if( ( upper_extent_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				extent_file_index = upper_extent_file_index;
+				extent_offset     = lower_offset;
+				extent_size       = remaining_size;
+				extent_flags      = upper_extent_flags;
+			}
+			else
+			{
+				result = libfdata_stream_get_extent_at_offset(
+				          lower_stream,
+				          lower_offset,
+				          remaining_size,
+				          &extent_file_index,
+				          &extent_offset,
+				          &extent_size,
+				          &extent_flags,
+				          error );
+
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve lower stream extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 lower_offset,
+					 lower_offset );
 
-		return( -1 );
+					goto on_error;
+				}
+			}
+			/* Combine the extent with the pending segment if they are adjacent
+			 */
+			if( ( pending_size > 0 )
+			 && ( extent_flags == pending_flags )
+			 && ( ( ( extent_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+			  || ( ( extent_file_index == pending_file_index )
+			   && ( extent_offset == ( pending_offset + (off64_t) pending_size ) ) ) ) )
+			{
+				pending_size += extent_size;
+			}
+			else
+			{
+				if( pending_size > 0 )
+				{
+					if( libfdata_stream_append_segment(
+					     safe_composed_stream,
+					     &segment_index,
+					     pending_file_index,
+					     pending_offset,
+					     pending_size,
+					     pending_flags,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to append segment to composed stream.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				pending_file_index = extent_file_index;
+				pending_offset     = extent_offset;
+				pending_size       = extent_size;
+				pending_flags      = extent_flags;
+			}
+			lower_offset   += (off64_t) extent_size;
+			remaining_size -= extent_size;
+		}
+		upper_offset += (off64_t) upper_extent_size;
 	}
-	internal_stream = (libfdata_internal_stream_t *) stream;
-
-	if( libcdata_array_reverse(
-	     internal_stream->segments_array,
-	     error ) != 1 )
+	if( pending_size > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to reverse segments array.",
-		 function );
+		if( libfdata_stream_append_segment(
+		     safe_composed_stream,
+		     &segment_index,
+		     pending_file_index,
+		     pending_offset,
+		     pending_size,
+		     pending_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment to composed stream.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	internal_stream->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	*composed_stream = safe_composed_stream;
 
 	return( 1 );
+
+on_error:
+	if( safe_composed_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &safe_composed_stream,
+		 NULL );
+	}
+	if( ( data_handle != NULL )
+	 && ( internal_lower_stream->free_data_handle != NULL ) )
+	{
+		internal_lower_stream->free_data_handle(
+		 &data_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the number of segments
+/* Frees a stream
  * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_get_number_of_segments(
-     libfdata_stream_t *stream,
-     int *number_of_segments,
+int libfdata_stream_free(
+     libfdata_stream_t **stream,
      libcerror_error_t **error )
 {
 	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_get_number_of_segments";
+	static char *function                       = "libfdata_stream_free";
+	int result                                  = 1;
 
 	if( stream == NULL )
 	{
@@ -673,142 +767,362 @@ int libfdata_stream_get_number_of_segments(
 
 		return( -1 );
 	}
-	internal_stream = (libfdata_internal_stream_t *) stream;
-
-	if( libcdata_array_get_number_of_entries(
-	     internal_stream->segments_array,
-	     number_of_segments,
-	     error ) != 1 )
+	if( *stream != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from segments array.",
-		 function );
+		internal_stream = (libfdata_internal_stream_t *) *stream;
+		*stream         = NULL;
 
-		return( -1 );
+		if( libfdata_notify_workload_function != NULL )
+		{
+			libfdata_notify_workload(
+			 LIBFDATA_TRACE_CONTAINER_TYPE_STREAM,
+			 LIBFDATA_WORKLOAD_CALL_FREE,
+			 (intptr_t *) internal_stream,
+			 0,
+			 0,
+			 0,
+			 0,
+			 0 );
+		}
+
+		/* The file IO handle of the buffered data is not owned by the stream
+		 * and can already be closed, hence the data is not written here
+		 */
+		if( internal_stream->write_buffer_data_size > 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: discarding %" PRIzd " bytes of unflushed data in write buffer.\n",
+				 function,
+				 internal_stream->write_buffer_data_size );
+			}
+#endif
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid stream - write buffer contains unflushed data.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_stream->write_buffer != NULL )
+		{
+			libfdata_allocator_free(
+			 internal_stream->write_buffer );
+		}
+		if( internal_stream->read_ahead_buffer != NULL )
+		{
+			libfdata_allocator_free(
+			 internal_stream->read_ahead_buffer );
+		}
+		if( internal_stream->aligned_buffer_allocation != NULL )
+		{
+			libfdata_allocator_free(
+			 internal_stream->aligned_buffer_allocation );
+		}
+		if( libfdata_segments_table_free(
+		     &( internal_stream->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free the segments table.",
+			 function );
+
+			result = -1;
+		}
+		if( ( internal_stream->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
+		{
+			if( internal_stream->data_handle != NULL )
+			{
+				if( internal_stream->free_data_handle == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: invalid source stream - missing free data handle function.",
+					 function );
+
+					result = -1;
+				}
+				else if( internal_stream->free_data_handle(
+				          &( internal_stream->data_handle ),
+				          error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free data handle.",
+					 function );
+
+					result = -1;
+				}
+			}
+		}
+		libfdata_allocator_free(
+		 internal_stream );
 	}
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves a specific segment
+/* Clones (duplicates) the stream
  * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_get_segment_by_index(
-     libfdata_stream_t *stream,
-     int segment_index,
-     int *segment_file_index,
-     off64_t *segment_offset,
-     size64_t *segment_size,
-     uint32_t *segment_flags,
+int libfdata_stream_clone(
+     libfdata_stream_t **destination_stream,
+     libfdata_stream_t *source_stream,
      libcerror_error_t **error )
 {
-	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_get_segment_by_index";
+	libfdata_internal_stream_t *internal_destination_stream = NULL;
+	libfdata_internal_stream_t *internal_source_stream      = NULL;
+	static char *function                                   = "libfdata_stream_clone";
 
-	if( stream == NULL )
+	if( destination_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stream.",
+		 "%s: invalid destination stream.",
 		 function );
 
 		return( -1 );
 	}
-	internal_stream = (libfdata_internal_stream_t *) stream;
-
-	if( libfdata_segments_array_get_segment_by_index(
-	     internal_stream->segments_array,
-	     segment_index,
-	     segment_file_index,
-	     segment_offset,
-	     segment_size,
-	     segment_flags,
-	     error ) != 1 )
+	if( *destination_stream != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment: %d.",
-		 function,
-		 segment_index );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination stream already set.",
+		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
+	if( source_stream == NULL )
+	{
+		*destination_stream = NULL;
 
-/* Sets a specific segment
- * Returns 1 if successful or -1 on error
- */
-int libfdata_stream_set_segment_by_index(
-     libfdata_stream_t *stream,
-     int segment_index,
-     int segment_file_index,
-     off64_t segment_offset,
-     size64_t segment_size,
-     uint32_t segment_flags,
-     libcerror_error_t **error )
-{
-	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_set_segment_by_index";
+		return( 1 );
+	}
+	internal_source_stream = (libfdata_internal_stream_t *) source_stream;
 
-	if( stream == NULL )
+	internal_destination_stream = libfdata_allocator_allocate_structure(
+	                               libfdata_internal_stream_t );
+
+	if( internal_destination_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stream.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination stream.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_stream = (libfdata_internal_stream_t *) stream;
-
-	if( libfdata_segments_array_set_segment_by_index(
-	     internal_stream->segments_array,
-	     internal_stream->mapped_ranges_array,
-	     &( internal_stream->size ),
-	     segment_index,
-	     segment_file_index,
-	     segment_offset,
-	     segment_size,
-	     segment_flags,
+	if( memory_set(
+	     internal_destination_stream,
+	     0,
+	     sizeof( libfdata_internal_stream_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination stream.",
+		 function );
+
+		libfdata_allocator_free(
+		 internal_destination_stream );
+
+		return( -1 );
+	}
+	if( internal_source_stream->data_handle != NULL )
+	{
+		if( internal_source_stream->free_data_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid source stream - missing free data handle function.",
+			 function );
+
+			goto on_error;
+		}
+		if( internal_source_stream->clone_data_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid source stream - missing clone data handle function.",
+			 function );
+
+			goto on_error;
+		}
+		if( internal_source_stream->clone_data_handle(
+		     &( internal_destination_stream->data_handle ),
+		     internal_source_stream->data_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination data handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( internal_source_stream->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
+	{
+		/* Calculate the mapped ranges before the segments table is shared
+		 */
+		if( libfdata_segments_table_make_writable(
+		     &( internal_source_stream->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
+
+			goto on_error;
+		}
+		internal_source_stream->current_segment_data_range = NULL;
+
+		if( libfdata_segments_array_calculate_mapped_ranges(
+		     internal_source_stream->segments_table->segments_array,
+		     internal_source_stream->segments_table->mapped_ranges_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate mapped ranges.",
+			 function );
+
+			goto on_error;
+		}
+		internal_source_stream->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
+	}
+	if( libfdata_segments_table_reference(
+	     &( internal_destination_stream->segments_table ),
+	     internal_source_stream->segments_table,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment: %d.",
-		 function,
-		 segment_index );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to reference source segments table.",
+		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_stream->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	internal_destination_stream->size                = internal_source_stream->size;
+	internal_destination_stream->mapped_size         = internal_source_stream->mapped_size;
+	internal_destination_stream->write_buffer_size   = internal_source_stream->write_buffer_size;
+	internal_destination_stream->flags               = internal_source_stream->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
+	internal_destination_stream->free_data_handle    = internal_source_stream->free_data_handle;
+	internal_destination_stream->clone_data_handle   = internal_source_stream->clone_data_handle;
+	internal_destination_stream->create_segment      = internal_source_stream->create_segment;
+	internal_destination_stream->read_segment_data   = internal_source_stream->read_segment_data;
+	internal_destination_stream->write_segment_data  = internal_source_stream->write_segment_data;
+	internal_destination_stream->seek_segment_offset = internal_source_stream->seek_segment_offset;
+
+	internal_destination_stream->create_segment_run                 = internal_source_stream->create_segment_run;
+	internal_destination_stream->maximum_number_of_segments_per_run = internal_source_stream->maximum_number_of_segments_per_run;
+	internal_destination_stream->maximum_read_ahead_size            = internal_source_stream->maximum_read_ahead_size;
+	internal_destination_stream->read_alignment                     = internal_source_stream->read_alignment;
+	internal_destination_stream->read_segment_data_batch            = internal_source_stream->read_segment_data_batch;
+
+	if( ( internal_source_stream->flags & LIBFDATA_FLAG_IS_SLICE ) != 0 )
+	{
+		internal_destination_stream->slice_offset = internal_source_stream->slice_offset;
+
+		if( libfdata_stream_get_segment_index_at_offset(
+		     (libfdata_stream_t *) internal_destination_stream,
+		     0,
+		     &( internal_destination_stream->current_segment_index ),
+		     &( internal_destination_stream->segment_data_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment index at start of slice.",
+			 function );
+
+			goto on_error;
+		}
+	}
+
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_STREAM,
+		 LIBFDATA_WORKLOAD_CALL_CLONE,
+		 (intptr_t *) internal_destination_stream,
+		 0,
+		 0,
+		 (off64_t) (intptr_t) source_stream,
+		 0,
+		 0 );
+	}
+
+	*destination_stream = (libfdata_stream_t *) internal_destination_stream;
 
 	return( 1 );
+
+on_error:
+	if( internal_destination_stream != NULL )
+	{
+		if( ( internal_destination_stream->data_handle != NULL )
+		 && ( internal_source_stream->free_data_handle != NULL ) )
+		{
+			internal_source_stream->free_data_handle(
+			 &( internal_destination_stream->data_handle ),
+			 NULL );
+		}
+		if( internal_destination_stream->segments_table != NULL )
+		{
+			libfdata_segments_table_free(
+			 &( internal_destination_stream->segments_table ),
+			 NULL );
+		}
+		libfdata_allocator_free(
+		 internal_destination_stream );
+	}
+	return( -1 );
 }
 
-/* Prepends a segment
+/* Segment functions
+ */
+
+/* Empties the stream
  * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_prepend_segment(
+int libfdata_stream_empty(
      libfdata_stream_t *stream,
-     int segment_file_index,
-     off64_t segment_offset,
-     size64_t segment_size,
-     uint32_t segment_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_prepend_segment";
+	static char *function                       = "libfdata_stream_empty";
 
 	if( stream == NULL )
 	{
@@ -823,44 +1137,50 @@ int libfdata_stream_prepend_segment(
 	}
 	internal_stream = (libfdata_internal_stream_t *) stream;
 
-	if( libfdata_segments_array_prepend_segment(
-	     internal_stream->segments_array,
-	     internal_stream->mapped_ranges_array,
-	     &( internal_stream->size ),
-	     segment_file_index,
-	     segment_offset,
-	     segment_size,
-	     segment_flags,
+	if( libfdata_segments_table_make_writable(
+	     &( internal_stream->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to prepend segment.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
 		 function );
 
 		return( -1 );
 	}
-	internal_stream->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+	internal_stream->current_segment_data_range = NULL;
+	internal_stream->read_ahead_data_size       = 0;
+
+	if( libfdata_segments_table_empty(
+	     internal_stream->segments_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segments table.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream->size = 0;
 
 	return( 1 );
 }
 
-/* Appends a segment
+/* Resizes the stream
  * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_append_segment(
+int libfdata_stream_resize(
      libfdata_stream_t *stream,
-     int *segment_index,
-     int segment_file_index,
-     off64_t segment_offset,
-     size64_t segment_size,
-     uint32_t segment_flags,
+     int number_of_segments,
      libcerror_error_t **error )
 {
 	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_append_segment";
+	static char *function                       = "libfdata_stream_resize";
 
 	if( stream == NULL )
 	{
@@ -875,41 +1195,50 @@ int libfdata_stream_append_segment(
 	}
 	internal_stream = (libfdata_internal_stream_t *) stream;
 
-	if( libfdata_segments_array_append_segment(
-	     internal_stream->segments_array,
-	     internal_stream->mapped_ranges_array,
-	     &( internal_stream->size ),
-	     segment_index,
-	     segment_file_index,
-	     segment_offset,
-	     segment_size,
-	     segment_flags,
+	if( libfdata_segments_table_make_writable(
+	     &( internal_stream->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append segment.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream->current_segment_data_range = NULL;
+	internal_stream->read_ahead_data_size       = 0;
+
+	if( libfdata_segments_table_resize(
+	     internal_stream->segments_table,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize segments table.",
 		 function );
 
 		return( -1 );
 	}
+	internal_stream->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
 	return( 1 );
 }
 
-/* Sets the mapped size
- * The mapped size cannot be larger than the stream size
- * A value of 0 is equivalent for the stream size
+/* Reverses the order of the segments
  * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_set_mapped_size(
+int libfdata_stream_reverse(
      libfdata_stream_t *stream,
-     size64_t mapped_size,
      libcerror_error_t **error )
 {
 	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_set_mapped_size";
+	static char *function                       = "libfdata_stream_reverse";
 
 	if( stream == NULL )
 	{
@@ -924,38 +1253,50 @@ int libfdata_stream_set_mapped_size(
 	}
 	internal_stream = (libfdata_internal_stream_t *) stream;
 
-	if( mapped_size > internal_stream->size )
+	if( libfdata_segments_table_make_writable(
+	     &( internal_stream->segments_table ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid mapped size value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
 		 function );
 
 		return( -1 );
 	}
-	internal_stream->mapped_size = mapped_size;
+	internal_stream->current_segment_data_range = NULL;
+	internal_stream->read_ahead_data_size       = 0;
+
+	if( libcdata_array_reverse(
+	     internal_stream->segments_table->segments_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reverse segments array.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
 
 	return( 1 );
 }
 
-/* Mapped range functions
- */
-
-/* Retrieves the mapped range of a specific segment
+/* Retrieves the number of segments
  * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_get_segment_mapped_range(
+int libfdata_stream_get_number_of_segments(
      libfdata_stream_t *stream,
-     int segment_index,
-     off64_t *mapped_range_offset,
-     size64_t *mapped_range_size,
+     int *number_of_segments,
      libcerror_error_t **error )
 {
 	libfdata_internal_stream_t *internal_stream = NULL;
-	libfdata_mapped_range_t *mapped_range       = NULL;
-	static char *function                       = "libfdata_stream_get_segment_mapped_range";
+	static char *function                       = "libfdata_stream_get_number_of_segments";
 
 	if( stream == NULL )
 	{
@@ -970,33 +1311,65 @@ int libfdata_stream_get_segment_mapped_range(
 	}
 	internal_stream = (libfdata_internal_stream_t *) stream;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_stream->mapped_ranges_array,
-	     segment_index,
-	     (intptr_t **) &mapped_range,
+	if( libcdata_array_get_number_of_entries(
+	     internal_stream->segments_table->segments_array,
+	     number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry: %d from mapped ranges array.",
-		 function,
-		 segment_index );
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
 
 		return( -1 );
 	}
-	if( libfdata_mapped_range_get(
-	     mapped_range,
-	     mapped_range_offset,
-	     mapped_range_size,
+	return( 1 );
+}
+
+/* Retrieves a specific segment
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_get_segment_by_index(
+     libfdata_stream_t *stream,
+     int segment_index,
+     int *segment_file_index,
+     off64_t *segment_offset,
+     size64_t *segment_size,
+     uint32_t *segment_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_get_segment_by_index";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( libfdata_segments_array_get_segment_by_index(
+	     internal_stream->segments_table->segments_array,
+	     segment_index,
+	     segment_file_index,
+	     segment_offset,
+	     segment_size,
+	     segment_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to retrieve values from mapped range: %d.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %d.",
 		 function,
 		 segment_index );
 
@@ -1005,36 +1378,20 @@ int libfdata_stream_get_segment_mapped_range(
 	return( 1 );
 }
 
-/* Retrieves the segment index for a specific offset
- * The segment_data_offset value is set to the offset relative to the start of the segment
- * Returns 1 if successful, 0 if not or -1 on error
+/* Sets a specific segment
+ * Returns 1 if successful or -1 on error
  */
-int libfdata_stream_get_segment_index_at_offset(
+int libfdata_stream_set_segment_by_index(
      libfdata_stream_t *stream,
-     off64_t offset,
-     int *segment_index,
-     off64_t *segment_data_offset,
+     int segment_index,
+     int segment_file_index,
+     off64_t segment_offset,
+     size64_t segment_size,
+     uint32_t segment_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_stream_t *internal_stream = NULL;
-	libfdata_mapped_range_t *mapped_range       = NULL;
-	static char *function                       = "libfdata_stream_get_segment_index_at_offset";
-	off64_t mapped_range_end_offset             = 0;
-	off64_t mapped_range_start_offset           = 0;
-	size64_t mapped_range_size                  = 0;
-	size64_t stream_size                        = 0;
-	int initial_segment_index                   = 0;
-	int number_of_segments                      = 0;
-	int result                                  = 0;
-	int search_segment_index                    = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	libfdata_range_t *segment_data_range        = NULL;
-	off64_t segment_offset                      = 0;
-	size64_t segment_size                       = 0;
-	uint32_t segment_flags                      = 0;
-	int segment_file_index                      = -1;
-#endif
+	static char *function                       = "libfdata_stream_set_segment_by_index";
 
 	if( stream == NULL )
 	{
@@ -1049,365 +1406,605 @@ int libfdata_stream_get_segment_index_at_offset(
 	}
 	internal_stream = (libfdata_internal_stream_t *) stream;
 
-	if( offset < 0 )
+	if( libfdata_segments_table_make_writable(
+	     &( internal_stream->segments_table ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
-		 "%s: invalid offset value less than zero.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_index == NULL )
+	internal_stream->current_segment_data_range = NULL;
+	internal_stream->read_ahead_data_size       = 0;
+
+	if( libfdata_segments_array_set_segment_by_index(
+	     internal_stream->segments_table->segments_array,
+	     internal_stream->segments_table->mapped_ranges_array,
+	     internal_stream->segments_table->segments_arena,
+	     internal_stream->segments_table->mapped_ranges_arena,
+	     &( internal_stream->size ),
+	     segment_index,
+	     segment_file_index,
+	     segment_offset,
+	     segment_size,
+	     segment_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment index.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment: %d.",
+		 function,
+		 segment_index );
 
 		return( -1 );
 	}
-	if( segment_data_offset == NULL )
+	internal_stream->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	return( 1 );
+}
+
+/* Prepends a segment
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_prepend_segment(
+     libfdata_stream_t *stream,
+     int segment_file_index,
+     off64_t segment_offset,
+     size64_t segment_size,
+     uint32_t segment_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_prepend_segment";
+
+	if( stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment data offset.",
+		 "%s: invalid stream.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_stream->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
-	{
-		if( libfdata_segments_array_calculate_mapped_ranges(
-		     internal_stream->segments_array,
-		     internal_stream->mapped_ranges_array,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to calculate mapped ranges.",
-			 function );
+	internal_stream = (libfdata_internal_stream_t *) stream;
 
-			return( -1 );
-		}
-		internal_stream->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( libfdata_segments_table_make_writable(
+	     &( internal_stream->segments_table ),
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: requested offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-		 function,
-		 offset,
-		 offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	if( internal_stream->mapped_size != 0 )
+	internal_stream->current_segment_data_range = NULL;
+	internal_stream->read_ahead_data_size       = 0;
+
+	if( libfdata_segments_array_prepend_segment(
+	     internal_stream->segments_table->segments_array,
+	     internal_stream->segments_table->mapped_ranges_array,
+	     internal_stream->segments_table->segments_arena,
+	     internal_stream->segments_table->mapped_ranges_arena,
+	     &( internal_stream->size ),
+	     segment_file_index,
+	     segment_offset,
+	     segment_size,
+	     segment_flags,
+	     error ) != 1 )
 	{
-		stream_size = internal_stream->mapped_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to prepend segment.",
+		 function );
+
+		return( -1 );
 	}
-	else
+	internal_stream->flags |= LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES;
+
+	return( 1 );
+}
+
+/* Appends a segment
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_append_segment(
+     libfdata_stream_t *stream,
+     int *segment_index,
+     int segment_file_index,
+     off64_t segment_offset,
+     size64_t segment_size,
+     uint32_t segment_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_append_segment";
+
+	if( stream == NULL )
 	{
-		stream_size = internal_stream->size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
 	}
-	if( stream_size == 0 )
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( libfdata_segments_table_make_writable(
+	     &( internal_stream->segments_table ),
+	     error ) != 1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_stream->mapped_ranges_array,
-	     &number_of_segments,
+	internal_stream->current_segment_data_range = NULL;
+
+	if( libfdata_segments_array_append_segment(
+	     internal_stream->segments_table->segments_array,
+	     internal_stream->segments_table->mapped_ranges_array,
+	     internal_stream->segments_table->segments_arena,
+	     internal_stream->segments_table->mapped_ranges_arena,
+	     &( internal_stream->size ),
+	     segment_index,
+	     segment_file_index,
+	     segment_offset,
+	     segment_size,
+	     segment_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from mapped ranges array.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment.",
 		 function );
 
 		return( -1 );
 	}
-	/* This assumes a fairly even distribution of the sizes of the segments
-	 */
-	initial_segment_index = (int) ( ( number_of_segments * offset ) / stream_size );
-
-	/* Look for the corresponding segment upwards in the array
-	 */
-	for( search_segment_index = initial_segment_index;
-	     search_segment_index < number_of_segments;
-	     search_segment_index++ )
+	if( libfdata_notify_workload_function != NULL )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_stream->mapped_ranges_array,
-		     search_segment_index,
-		     (intptr_t **) &mapped_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from mapped ranges array.",
-			 function,
-			 search_segment_index );
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_STREAM,
+		 LIBFDATA_WORKLOAD_CALL_APPEND_SEGMENT,
+		 (intptr_t *) internal_stream,
+		 *segment_index,
+		 segment_file_index,
+		 segment_offset,
+		 segment_size,
+		 0 );
+	}
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		if( libfdata_mapped_range_get(
-		     mapped_range,
-		     &mapped_range_start_offset,
-		     &mapped_range_size,
-		     error ) != 1 )
+/* Sets the mapped size
+ * The mapped size cannot be larger than the stream size
+ * A value of 0 is equivalent for the stream size
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_set_mapped_size(
+     libfdata_stream_t *stream,
+     size64_t mapped_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_set_mapped_size";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( ( internal_stream->flags & LIBFDATA_FLAG_IS_SLICE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid stream - unsupported slice.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_size > internal_stream->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapped size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream->mapped_size = mapped_size;
+
+	return( 1 );
+}
+/* Sets the create segment run function
+ * The create segment run function creates up to maximum number of segments
+ * of the same size that directly follow each other in the same segment file.
+ * When set, it is used instead of the create segment function when writing
+ * beyond the end of the stream. Created segments that are not written
+ * are reserved for subsequent writes and only appended once they are written.
+ * The create segment run function returns 1 if successful, 0 if no more
+ * segments can be created or -1 on error.
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_set_create_segment_run_function(
+     libfdata_stream_t *stream,
+     int (*create_segment_run)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            int segment_index,
+            int maximum_number_of_segments,
+            int *segment_file_index,
+            off64_t *segment_offset,
+            size64_t *segment_size,
+            uint32_t *segment_flags,
+            int *number_of_segments,
+            libcerror_error_t **error ),
+     int maximum_number_of_segments_per_run,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_set_create_segment_run_function";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( ( create_segment_run != NULL )
+	 && ( maximum_number_of_segments_per_run <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of segments per run value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream->create_segment_run                 = create_segment_run;
+	internal_stream->maximum_number_of_segments_per_run = maximum_number_of_segments_per_run;
+	internal_stream->number_of_reserved_segments        = 0;
+
+	return( 1 );
+}
+
+/* Creates a segment at the end of the stream
+ * Uses the reserved segments, if any, otherwise the create segment run or create segment function
+ * Returns 1 if successful, 0 if no segment could be created or -1 on error
+ */
+int libfdata_stream_create_segment(
+     libfdata_internal_stream_t *internal_stream,
+     intptr_t *file_io_handle,
+     int segment_index,
+     int *segment_file_index,
+     off64_t *segment_offset,
+     size64_t *segment_size,
+     uint32_t *segment_flags,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfdata_stream_create_segment";
+	int number_of_segments = 0;
+	int result             = 0;
+
+	if( internal_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment size.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment flags.",
+		 function );
+
+		return( -1 );
+	}
+	/* Discard reserved segments that no longer directly follow the last segment
+	 */
+	if( internal_stream->reserved_segment_index != segment_index )
+	{
+		internal_stream->number_of_reserved_segments = 0;
+	}
+	if( ( internal_stream->number_of_reserved_segments == 0 )
+	 && ( internal_stream->create_segment_run != NULL ) )
+	{
+		result = internal_stream->create_segment_run(
+		          internal_stream->data_handle,
+		          file_io_handle,
+		          segment_index,
+		          internal_stream->maximum_number_of_segments_per_run,
+		          &( internal_stream->reserved_segment_file_index ),
+		          &( internal_stream->reserved_segment_offset ),
+		          &( internal_stream->reserved_segment_size ),
+		          &( internal_stream->reserved_segment_flags ),
+		          &number_of_segments,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to retrieve values from mapped range: %d.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment run: %d.",
 			 function,
-			 search_segment_index );
+			 segment_index );
 
 			return( -1 );
 		}
-		mapped_range_end_offset = mapped_range_start_offset + (off64_t) mapped_range_size;
-
-		if( mapped_range_end_offset < mapped_range_start_offset )
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( ( number_of_segments <= 0 )
+		 || ( number_of_segments > internal_stream->maximum_number_of_segments_per_run ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid segment: %d - mapped range value out of bounds.",
-			 function,
-			 search_segment_index );
+			 "%s: invalid number of segments value out of bounds.",
+			 function );
 
 			return( -1 );
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: segment: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-			 function,
-			 search_segment_index,
-			 mapped_range_start_offset,
-			 mapped_range_end_offset,
-			 mapped_range_size );
-		}
-#endif
-		/* Check if the offset is in the mapped range
-		 */
-		if( ( offset >= mapped_range_start_offset )
-		 && ( offset < mapped_range_end_offset ) )
+		if( internal_stream->reserved_segment_offset < 0 )
 		{
-			offset -= mapped_range_start_offset;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment offset value out of bounds.",
+			 function );
 
-			break;
+			return( -1 );
 		}
-		/* Check if the offset is out of bounds
-		 */
-		if( offset < mapped_range_start_offset )
+		if( ( internal_stream->reserved_segment_size == 0 )
+		 || ( internal_stream->reserved_segment_size > ( (size64_t) ( INT64_MAX - internal_stream->reserved_segment_offset ) / number_of_segments ) ) )
 		{
-			search_segment_index = number_of_segments;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment size value out of bounds.",
+			 function );
 
-			break;
+			return( -1 );
 		}
+		internal_stream->reserved_segment_index      = segment_index;
+		internal_stream->number_of_reserved_segments = number_of_segments;
 	}
-	if( search_segment_index >= number_of_segments )
+	if( internal_stream->number_of_reserved_segments > 0 )
 	{
-		/* Look for the corresponding segment downwards in the array
-		 */
-		for( search_segment_index = initial_segment_index;
-		     search_segment_index >= 0;
-		     search_segment_index-- )
-		{
-			if( libcdata_array_get_entry_by_index(
-			     internal_stream->mapped_ranges_array,
-			     search_segment_index,
-			     (intptr_t **) &mapped_range,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve entry: %d from mapped ranges array.",
-				 function,
-				 search_segment_index );
-
-				return( -1 );
-			}
-			if( libfdata_mapped_range_get(
-			     mapped_range,
-			     &mapped_range_start_offset,
-			     &mapped_range_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to retrieve values from mapped range: %d.",
-				 function,
-				 search_segment_index );
+		*segment_file_index = internal_stream->reserved_segment_file_index;
+		*segment_offset     = internal_stream->reserved_segment_offset;
+		*segment_size       = internal_stream->reserved_segment_size;
+		*segment_flags      = internal_stream->reserved_segment_flags;
 
-				return( -1 );
-			}
-			mapped_range_end_offset = mapped_range_start_offset + (off64_t) mapped_range_size;
+		internal_stream->reserved_segment_index      += 1;
+		internal_stream->reserved_segment_offset     += (off64_t) internal_stream->reserved_segment_size;
+		internal_stream->number_of_reserved_segments -= 1;
 
-			if( mapped_range_end_offset < mapped_range_start_offset )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid segment: %d - mapped range value out of bounds.",
-				 function,
-				 search_segment_index );
+		return( 1 );
+	}
+	if( internal_stream->create_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing create segment function.",
+		 function );
 
-				return( -1 );
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: segment: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
-				 function,
-				 search_segment_index,
-				 mapped_range_start_offset,
-				 mapped_range_end_offset,
-				 mapped_range_size );
-			}
-#endif
-			/* Check if the offset is in the mapped range
-			 */
-			if( ( offset >= mapped_range_start_offset )
-			 && ( offset < mapped_range_end_offset ) )
-			{
-				offset -= mapped_range_start_offset;
+		return( -1 );
+	}
+	result = internal_stream->create_segment(
+	          internal_stream->data_handle,
+	          file_io_handle,
+	          segment_index,
+	          segment_file_index,
+	          segment_offset,
+	          segment_size,
+	          segment_flags,
+	          error );
 
-				break;
-			}
-			/* Check if the offset is out of bounds
-			 */
-			if( offset > mapped_range_start_offset )
-			{
-				search_segment_index--;
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment: %d.",
+		 function,
+		 segment_index );
 
-				break;
-			}
-		}
+		return( -1 );
 	}
-	if( ( search_segment_index >= 0 )
-	 && ( search_segment_index < number_of_segments ) )
-	{
-		if( offset < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid offset value out of bounds.",
-			 function );
+	return( result );
+}
 
-			return( -1 );
-		}
-		*segment_data_offset = offset;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( libcdata_array_get_entry_by_index(
-			     internal_stream->segments_array,
-			     search_segment_index,
-			     (intptr_t **) &segment_data_range,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve entry: %d from segments array.",
-				 function,
-				 search_segment_index );
+/* Mapped range functions
+ */
 
-				return( -1 );
-			}
-			if( libfdata_range_get(
-			     segment_data_range,
-			     &segment_file_index,
-			     &segment_offset,
-			     &segment_size,
-			     &segment_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve segment: %d data range values.",
-				 function,
-				 search_segment_index );
+/* Retrieves the mapped range of a specific segment
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_get_segment_mapped_range(
+     libfdata_stream_t *stream,
+     int segment_index,
+     off64_t *mapped_range_offset,
+     size64_t *mapped_range_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	libfdata_mapped_range_t *mapped_range       = NULL;
+	static char *function                       = "libfdata_stream_get_segment_mapped_range";
 
-				return( -1 );
-			}
-			libcnotify_printf(
-			 "%s: segment: %03d\tfile index: %03d offset: %" PRIi64 " - %" PRIi64 " (0x%08" PRIx64 " - 0x%08" PRIx64 ") (size: %" PRIu64 ")\n",
-			 function,
-			 search_segment_index,
-			 segment_file_index,
-			 segment_offset,
-			 segment_offset + segment_size,
-			 segment_offset,
-			 segment_offset + segment_size,
-			 segment_size );
-		}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
 
-		result = 1;
+		return( -1 );
 	}
-	if( result == 1 )
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_stream->segments_table->mapped_ranges_array,
+	     segment_index,
+	     (intptr_t **) &mapped_range,
+	     error ) != 1 )
 	{
-		*segment_index = search_segment_index;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %d from mapped ranges array.",
+		 function,
+		 segment_index );
+
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( libfdata_mapped_range_get(
+	     mapped_range,
+	     mapped_range_offset,
+	     mapped_range_size,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "\n" );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to retrieve values from mapped range: %d.",
+		 function,
+		 segment_index );
+
+		return( -1 );
 	}
-#endif
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves the segment for a specific offset
+/* Retrieves the segment index for a specific offset
  * The segment_data_offset value is set to the offset relative to the start of the segment
  * Returns 1 if successful, 0 if not or -1 on error
  */
-int libfdata_stream_get_segment_at_offset(
+int libfdata_stream_get_segment_index_at_offset(
      libfdata_stream_t *stream,
      off64_t offset,
      int *segment_index,
      off64_t *segment_data_offset,
-     int *segment_file_index,
-     off64_t *segment_offset,
-     size64_t *segment_size,
-     uint32_t *segment_flags,
      libcerror_error_t **error )
 {
 	libfdata_internal_stream_t *internal_stream = NULL;
-	libfdata_range_t *segment_data_range        = NULL;
-	static char *function                       = "libfdata_stream_get_segment_at_offset";
+	libfdata_mapped_range_t *mapped_range       = NULL;
+	static char *function                       = "libfdata_stream_get_segment_index_at_offset";
+	off64_t mapped_range_end_offset             = 0;
+	off64_t mapped_range_start_offset           = 0;
+	size64_t mapped_range_size                  = 0;
+	size64_t stream_size                        = 0;
+	int initial_segment_index                   = 0;
+	int number_of_segments                      = 0;
 	int result                                  = 0;
+	int search_segment_index                    = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	libfdata_range_t *segment_data_range        = NULL;
+	off64_t segment_offset                      = 0;
+	size64_t segment_size                       = 0;
+	uint32_t segment_flags                      = 0;
+	int segment_file_index                      = -1;
+#endif
 
 	if( stream == NULL )
 	{
@@ -1422,6 +2019,17 @@ int libfdata_stream_get_segment_at_offset(
 	}
 	internal_stream = (libfdata_internal_stream_t *) stream;
 
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
 	if( segment_index == NULL )
 	{
 		libcerror_error_set(
@@ -1433,161 +2041,60 @@ int libfdata_stream_get_segment_at_offset(
 
 		return( -1 );
 	}
-	result = libfdata_stream_get_segment_index_at_offset(
-	          stream,
-	          offset,
-	          segment_index,
-	          segment_data_offset,
-	          error );
-
-	if( result == -1 )
+	if( segment_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 offset,
-		 offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data offset.",
+		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
+	if( ( internal_stream->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_stream->segments_array,
-		     *segment_index,
-		     (intptr_t **) &segment_data_range,
+		if( libfdata_segments_table_make_writable(
+		     &( internal_stream->segments_table ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from segments array.",
-			 function,
-			 *segment_index );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
 
 			return( -1 );
 		}
-		if( libfdata_range_get(
-		     segment_data_range,
-		     segment_file_index,
-		     segment_offset,
-		     segment_size,
-		     segment_flags,
+		internal_stream->current_segment_data_range = NULL;
+
+		if( libfdata_segments_array_calculate_mapped_ranges(
+		     internal_stream->segments_table->segments_array,
+		     internal_stream->segments_table->mapped_ranges_array,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %d data range values.",
-			 function,
-			 *segment_index );
+			 "%s: unable to calculate mapped ranges.",
+			 function );
 
 			return( -1 );
 		}
+		internal_stream->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
 	}
-	return( result );
-}
-
-/* IO functions
- */
-
-/* Reads data from the current offset into a buffer
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libfdata_stream_read_buffer(
-         libfdata_stream_t *stream,
-         intptr_t *file_io_handle,
-         uint8_t *buffer,
-         size_t buffer_size,
-         uint8_t read_flags,
-         libcerror_error_t **error )
-{
-	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_read_buffer";
-	off64_t result_offset                       = 0;
-	off64_t segment_offset                      = 0;
-	size64_t segment_size                       = 0;
-	size64_t segment_data_size                  = 0;
-	size64_t stream_size                        = 0;
-	size_t buffer_offset                        = 0;
-	size_t read_size                            = 0;
-	ssize_t read_count                          = 0;
-	uint32_t segment_flags                      = 0;
-	int segment_file_index                      = 0;
-
-	if( stream == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stream.",
-		 function );
-
-		return( -1 );
-	}
-	internal_stream = (libfdata_internal_stream_t *) stream;
-
-	if( internal_stream->read_segment_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid stream - missing read segment data function.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_stream->seek_segment_offset == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid stream - missing seek segment offset function.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_stream->current_offset < 0 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid stream - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
+		libcnotify_printf(
+		 "%s: requested offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 offset,
+		 offset );
 	}
+#endif
 	if( internal_stream->mapped_size != 0 )
 	{
 		stream_size = internal_stream->mapped_size;
@@ -1596,172 +2103,230 @@ ssize_t libfdata_stream_read_buffer(
 	{
 		stream_size = internal_stream->size;
 	}
-	/* Bail out early for requests to read empty buffers and beyond the end of the stream
-	 */
-	if( (size64_t) internal_stream->current_offset >= stream_size )
-	{
-		buffer_size = 0;
-	}
-	else if( (size64_t) buffer_size > ( stream_size - internal_stream->current_offset ) )
-	{
-		buffer_size = (size_t) ( stream_size - internal_stream->current_offset );
-	}
-	if( buffer_size == 0 )
+	if( stream_size == 0 )
 	{
 		return( 0 );
 	}
-	if( internal_stream->current_segment_data_range == NULL )
+	if( ( internal_stream->flags & LIBFDATA_FLAG_IS_SLICE ) != 0 )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_stream->segments_array,
-		     internal_stream->current_segment_index,
-		     (intptr_t **) &( internal_stream->current_segment_data_range ),
-		     error ) != 1 )
+		if( (size64_t) offset >= stream_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve entry: %d from segments array.",
-			 function,
-			 internal_stream->current_segment_index );
-
-			return( -1 );
+			return( 0 );
 		}
+		/* The offset of a slice is relative to the start of the slice
+		 * in the segments that are shared with the source stream
+		 */
+		offset     += internal_stream->slice_offset;
+		stream_size = internal_stream->size;
 	}
-	if( libfdata_range_get(
-	     internal_stream->current_segment_data_range,
-	     &segment_file_index,
-	     &segment_offset,
-	     &segment_size,
-	     &segment_flags,
+	if( libcdata_array_get_number_of_entries(
+	     internal_stream->segments_table->mapped_ranges_array,
+	     &number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment: %d data range values.",
-		 function,
-		 internal_stream->current_segment_index );
-
-		return( -1 );
-	}
-	if( ( internal_stream->segment_data_offset < 0 )
-	 || ( segment_offset > ( INT64_MAX - internal_stream->segment_data_offset ) )
-	 || ( (size64_t) internal_stream->segment_data_offset >= segment_size ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid stream - segment data offset value out of bounds.",
+		 "%s: unable to retrieve number of entries from mapped ranges array.",
 		 function );
 
 		return( -1 );
 	}
-	segment_offset += internal_stream->segment_data_offset;
-
-	segment_data_size = segment_size - internal_stream->segment_data_offset;
-
-	/* Make sure the file IO handle is pointing to the correct offset
+	/* This assumes a fairly even distribution of the sizes of the segments
 	 */
-	result_offset = internal_stream->seek_segment_offset(
-	                 internal_stream->data_handle,
-	                 file_io_handle,
-	                 internal_stream->current_segment_index,
-	                 segment_file_index,
-	                 segment_offset,
-	                 error );
-
-	if( result_offset != segment_offset )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek segment: %d offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_stream->current_segment_index,
-		 segment_offset,
-		 segment_offset );
-
-		return( -1 );
-	}
-	internal_stream->segment_offset = segment_offset;
+	initial_segment_index = (int) ( ( number_of_segments * offset ) / stream_size );
 
-	while( buffer_size > 0 )
+	/* Look for the corresponding segment upwards in the array
+	 */
+	for( search_segment_index = initial_segment_index;
+	     search_segment_index < number_of_segments;
+	     search_segment_index++ )
 	{
-		if( (size64_t) buffer_size <= segment_data_size )
-		{
-			read_size = buffer_size;
-		}
-		else
-		{
-			read_size = (size_t) segment_data_size;
-		}
-		if( read_size == 0 )
+		if( libcdata_array_get_entry_by_index(
+		     internal_stream->segments_table->mapped_ranges_array,
+		     search_segment_index,
+		     (intptr_t **) &mapped_range,
+		     error ) != 1 )
 		{
-			break;
-		}
-		read_count = internal_stream->read_segment_data(
-		              internal_stream->data_handle,
-		              file_io_handle,
-		              internal_stream->current_segment_index,
-		              segment_file_index,
-		              &( buffer[ buffer_offset ]),
-		              read_size,
-		              segment_flags,
-		              read_flags,
-		              error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from mapped ranges array.",
+			 function,
+			 search_segment_index );
 
-		if( read_count != (ssize_t) read_size )
+			return( -1 );
+		}
+		if( libfdata_mapped_range_get(
+		     mapped_range,
+		     &mapped_range_start_offset,
+		     &mapped_range_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to retrieve values from mapped range: %d.",
 			 function,
-			 internal_stream->current_segment_index,
-			 segment_offset,
-			 segment_offset );
+			 search_segment_index );
 
 			return( -1 );
 		}
-		internal_stream->current_offset      += read_size;
-		internal_stream->segment_offset      += read_size;
-		internal_stream->segment_data_offset += read_size;
-		segment_offset                       += read_size;
-		segment_data_size                    -= read_size;
-		buffer_size                          -= read_size;
-		buffer_offset                        += read_size;
+		mapped_range_end_offset = mapped_range_start_offset + (off64_t) mapped_range_size;
 
-		if( (size64_t) internal_stream->current_offset >= stream_size )
+		if( mapped_range_end_offset < mapped_range_start_offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d - mapped range value out of bounds.",
+			 function,
+			 search_segment_index );
+
+			return( -1 );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: segment: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+			 function,
+			 search_segment_index,
+			 mapped_range_start_offset,
+			 mapped_range_end_offset,
+			 mapped_range_size );
+		}
+#endif
+		/* Check if the offset is in the mapped range
+		 */
+		if( ( offset >= mapped_range_start_offset )
+		 && ( offset < mapped_range_end_offset ) )
+		{
+			offset -= mapped_range_start_offset;
+
+			break;
+		}
+		/* Check if the offset is out of bounds
+		 */
+		if( offset < mapped_range_start_offset )
 		{
+			search_segment_index = number_of_segments;
+
 			break;
 		}
-		if( (size64_t) internal_stream->segment_data_offset >= segment_size )
+	}
+	if( search_segment_index >= number_of_segments )
+	{
+		/* Look for the corresponding segment downwards in the array
+		 */
+		for( search_segment_index = initial_segment_index;
+		     search_segment_index >= 0;
+		     search_segment_index-- )
 		{
-			if( (size64_t) internal_stream->segment_data_offset > segment_size )
+			if( libcdata_array_get_entry_by_index(
+			     internal_stream->segments_table->mapped_ranges_array,
+			     search_segment_index,
+			     (intptr_t **) &mapped_range,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve entry: %d from mapped ranges array.",
+				 function,
+				 search_segment_index );
+
+				return( -1 );
+			}
+			if( libfdata_mapped_range_get(
+			     mapped_range,
+			     &mapped_range_start_offset,
+			     &mapped_range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to retrieve values from mapped range: %d.",
+				 function,
+				 search_segment_index );
+
+				return( -1 );
+			}
+			mapped_range_end_offset = mapped_range_start_offset + (off64_t) mapped_range_size;
+
+			if( mapped_range_end_offset < mapped_range_start_offset )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid stream - segment data offset value out of bounds.",
-				 function );
+				 "%s: invalid segment: %d - mapped range value out of bounds.",
+				 function,
+				 search_segment_index );
 
 				return( -1 );
 			}
-			internal_stream->current_segment_index++;
-			internal_stream->current_segment_data_range = NULL;
-			internal_stream->segment_data_offset        = 0;
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: segment: %03d\tmapped range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ")\n",
+				 function,
+				 search_segment_index,
+				 mapped_range_start_offset,
+				 mapped_range_end_offset,
+				 mapped_range_size );
+			}
+#endif
+			/* Check if the offset is in the mapped range
+			 */
+			if( ( offset >= mapped_range_start_offset )
+			 && ( offset < mapped_range_end_offset ) )
+			{
+				offset -= mapped_range_start_offset;
+
+				break;
+			}
+			/* Check if the offset is out of bounds
+			 */
+			if( offset > mapped_range_start_offset )
+			{
+				search_segment_index--;
+
+				break;
+			}
+		}
+	}
+	if( ( search_segment_index >= 0 )
+	 && ( search_segment_index < number_of_segments ) )
+	{
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		*segment_data_offset = offset;
 
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
 			if( libcdata_array_get_entry_by_index(
-			     internal_stream->segments_array,
-			     internal_stream->current_segment_index,
-			     (intptr_t **) &( internal_stream->current_segment_data_range ),
+			     internal_stream->segments_table->segments_array,
+			     search_segment_index,
+			     (intptr_t **) &segment_data_range,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -1770,12 +2335,12 @@ ssize_t libfdata_stream_read_buffer(
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 				 "%s: unable to retrieve entry: %d from segments array.",
 				 function,
-				 internal_stream->current_segment_index );
+				 search_segment_index );
 
 				return( -1 );
 			}
 			if( libfdata_range_get(
-			     internal_stream->current_segment_data_range,
+			     segment_data_range,
 			     &segment_file_index,
 			     &segment_offset,
 			     &segment_size,
@@ -1788,205 +2353,252 @@ ssize_t libfdata_stream_read_buffer(
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 				 "%s: unable to retrieve segment: %d data range values.",
 				 function,
-				 internal_stream->current_segment_index );
-
-				return( -1 );
-			}
-			segment_data_size = segment_size;
-
-			result_offset = internal_stream->seek_segment_offset(
-			                 internal_stream->data_handle,
-			                 file_io_handle,
-			                 internal_stream->current_segment_index,
-			                 segment_file_index,
-			                 segment_offset,
-			                 error );
-
-			if( result_offset != segment_offset )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_SEEK_FAILED,
-				 "%s: unable to seek segment: %d offset: %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 internal_stream->current_segment_index,
-				 segment_offset,
-				 segment_offset );
+				 search_segment_index );
 
 				return( -1 );
 			}
-			internal_stream->segment_offset = segment_offset;
+			libcnotify_printf(
+			 "%s: segment: %03d\tfile index: %03d offset: %" PRIi64 " - %" PRIi64 " (0x%08" PRIx64 " - 0x%08" PRIx64 ") (size: %" PRIu64 ")\n",
+			 function,
+			 search_segment_index,
+			 segment_file_index,
+			 segment_offset,
+			 segment_offset + segment_size,
+			 segment_offset,
+			 segment_offset + segment_size,
+			 segment_size );
 		}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+		result = 1;
 	}
-	return( (ssize_t) buffer_offset );
+	if( result == 1 )
+	{
+		*segment_index = search_segment_index;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	return( result );
 }
 
-/* Reads data at a specific offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Retrieves the segment for a specific offset
+ * The segment_data_offset value is set to the offset relative to the start of the segment
+ * Returns 1 if successful, 0 if not or -1 on error
  */
-ssize_t libfdata_stream_read_buffer_at_offset(
-         libfdata_stream_t *stream,
-         intptr_t *file_io_handle,
-         uint8_t *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         uint8_t read_flags,
-         libcerror_error_t **error )
+int libfdata_stream_get_segment_at_offset(
+     libfdata_stream_t *stream,
+     off64_t offset,
+     int *segment_index,
+     off64_t *segment_data_offset,
+     int *segment_file_index,
+     off64_t *segment_offset,
+     size64_t *segment_size,
+     uint32_t *segment_flags,
+     libcerror_error_t **error )
 {
-	static char *function = "libfdata_stream_read_buffer_at_offset";
-	ssize_t read_count    = 0;
+	libfdata_internal_stream_t *internal_stream = NULL;
+	libfdata_range_t *segment_data_range        = NULL;
+	static char *function                       = "libfdata_stream_get_segment_at_offset";
+	int result                                  = 0;
 
-	if( libfdata_stream_seek_offset(
-	     stream,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
 		 function );
 
 		return( -1 );
 	}
-	read_count = libfdata_stream_read_buffer(
-	              stream,
-	              file_io_handle,
-	              buffer,
-	              buffer_size,
-	              read_flags,
-	              error );
+	internal_stream = (libfdata_internal_stream_t *) stream;
 
-	if( read_count < 0 )
+	if( segment_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
 		 function );
 
 		return( -1 );
 	}
-	return( read_count );
-}
+	result = libfdata_stream_get_segment_index_at_offset(
+	          stream,
+	          offset,
+	          segment_index,
+	          segment_data_offset,
+	          error );
 
-/* Writes data in the buffer to the current offset
- * Returns the number of bytes written or -1 on error
- */
-ssize_t libfdata_stream_write_buffer(
-         libfdata_stream_t *stream,
-         intptr_t *file_io_handle,
-         const uint8_t *buffer,
-         size_t buffer_size,
-         uint8_t write_flags,
-         libcerror_error_t **error )
-{
-	libfdata_internal_stream_t *internal_stream = NULL;
-	static char *function                       = "libfdata_stream_write_buffer";
-	off64_t result_offset                       = 0;
-	off64_t segment_offset                      = 0;
-	size64_t segment_size                       = 0;
-	size64_t segment_data_size                  = 0;
-	size_t buffer_offset                        = 0;
-	size_t write_size                           = 0;
-	ssize_t write_count                         = 0;
-	uint32_t segment_flags                      = 0;
-	int number_of_segments                      = 0;
-	int result                                  = 0;
-	int segment_file_index                      = 0;
-	int segment_index                           = 0;
-
-	if( stream == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stream.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 
 		return( -1 );
 	}
-	internal_stream = (libfdata_internal_stream_t *) stream;
-
-	if( internal_stream->create_segment == NULL )
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid stream - missing create segment function.",
-		 function );
+		if( libcdata_array_get_entry_by_index(
+		     internal_stream->segments_table->segments_array,
+		     *segment_index,
+		     (intptr_t **) &segment_data_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from segments array.",
+			 function,
+			 *segment_index );
 
-		return( -1 );
+			return( -1 );
+		}
+		if( libfdata_range_get(
+		     segment_data_range,
+		     segment_file_index,
+		     segment_offset,
+		     segment_size,
+		     segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d data range values.",
+			 function,
+			 *segment_index );
+
+			return( -1 );
+		}
 	}
-	if( internal_stream->write_segment_data == NULL )
+	return( result );
+}
+
+/* Retrieves the offset of the first segment at or after a specific offset
+ * that is sparse or not sparse
+ * Uses a binary search over the number of sparse segments stored in the mapped ranges
+ * Returns 1 if successful, 0 if no such segment was found or -1 on error
+ */
+int libfdata_stream_get_sparse_boundary_offset(
+     libfdata_internal_stream_t *internal_stream,
+     off64_t offset,
+     uint8_t is_sparse,
+     off64_t *boundary_offset,
+     libcerror_error_t **error )
+{
+	libfdata_mapped_range_t *mapped_range = NULL;
+	static char *function                 = "libfdata_stream_get_sparse_boundary_offset";
+	size64_t stream_size                  = 0;
+	int base_number_of_sparse_segments    = 0;
+	int maximum_segment_index             = 0;
+	int minimum_segment_index             = 0;
+	int number_of_matching_segments       = 0;
+	int number_of_segments                = 0;
+	int number_of_sparse_segments         = 0;
+	int search_segment_index              = 0;
+	int segment_index                     = 0;
+
+	if( internal_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid stream - missing write segment data function.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_stream->seek_segment_offset == NULL )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid stream - missing seek segment offset function.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( boundary_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid boundary offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( ( internal_stream->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
+		if( libfdata_segments_table_make_writable(
+		     &( internal_stream->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		internal_stream->current_segment_data_range = NULL;
+
+		if( libfdata_segments_array_calculate_mapped_ranges(
+		     internal_stream->segments_table->segments_array,
+		     internal_stream->segments_table->mapped_ranges_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate mapped ranges.",
+			 function );
+
+			return( -1 );
+		}
+		internal_stream->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
 	}
-	if( internal_stream->current_offset < 0 )
+	if( internal_stream->mapped_size != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid stream - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
+		stream_size = internal_stream->mapped_size;
 	}
-	/* Bail out early for requests to write empty buffers
-	 */
-	if( buffer_size == 0 )
+	else
+	{
+		stream_size = internal_stream->size;
+	}
+	if( (size64_t) offset >= stream_size )
 	{
 		return( 0 );
 	}
+	/* The offset of a slice is relative to the start of the slice
+	 */
+	offset      += internal_stream->slice_offset;
+	stream_size += internal_stream->slice_offset;
+
 	if( libcdata_array_get_number_of_entries(
-	     internal_stream->segments_array,
+	     internal_stream->segments_table->mapped_ranges_array,
 	     &number_of_segments,
 	     error ) != 1 )
 	{
@@ -1994,348 +2606,3502 @@ ssize_t libfdata_stream_write_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from segments array.",
+		 "%s: unable to retrieve number of entries from mapped ranges array.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_stream->current_offset < internal_stream->size )
+	/* Find the last segment that starts at or before the offset
+	 */
+	minimum_segment_index = 0;
+	maximum_segment_index = number_of_segments - 1;
+
+	while( minimum_segment_index < maximum_segment_index )
 	{
-		if( internal_stream->current_segment_data_range == NULL )
-		{
-			if( libcdata_array_get_entry_by_index(
-			     internal_stream->segments_array,
-			     internal_stream->current_segment_index,
-			     (intptr_t **) &( internal_stream->current_segment_data_range ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve entry: %d from segments array.",
-				 function,
-				 internal_stream->current_segment_index );
+		search_segment_index = minimum_segment_index + ( ( maximum_segment_index - minimum_segment_index + 1 ) / 2 );
 
-				return( -1 );
-			}
-		}
-		if( libfdata_range_get(
-		     internal_stream->current_segment_data_range,
-		     &segment_file_index,
-		     &segment_offset,
-		     &segment_size,
-		     &segment_flags,
+		if( libcdata_array_get_entry_by_index(
+		     internal_stream->segments_table->mapped_ranges_array,
+		     search_segment_index,
+		     (intptr_t **) &mapped_range,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %d data range values.",
+			 "%s: unable to retrieve entry: %d from mapped ranges array.",
 			 function,
-			 internal_stream->current_segment_index );
+			 search_segment_index );
 
 			return( -1 );
 		}
-		if( ( internal_stream->segment_data_offset < 0 )
-		 || ( (size64_t) internal_stream->segment_data_offset >= segment_size ) )
+		if( mapped_range == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid stream - segment data offset value out of bounds.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing mapped range: %d.",
+			 function,
+			 search_segment_index );
 
 			return( -1 );
 		}
-		segment_offset += internal_stream->segment_data_offset;
-
-		segment_data_size = segment_size - internal_stream->segment_data_offset;
-	}
-	else while( (size64_t) internal_stream->current_offset >= internal_stream->size )
-	{
-		if( internal_stream->current_segment_index < number_of_segments )
+		if( mapped_range->offset <= offset )
 		{
-			internal_stream->current_segment_index++;
-			internal_stream->current_segment_data_range = NULL;
+			minimum_segment_index = search_segment_index;
 		}
-		internal_stream->segment_data_offset = 0;
-
-		result = internal_stream->create_segment(
-			  internal_stream->data_handle,
-			  file_io_handle,
-			  internal_stream->current_segment_index,
-			  &segment_file_index,
-			  &segment_offset,
-			  &segment_size,
-			  &segment_flags,
-			  error );
+		else
+		{
+			maximum_segment_index = search_segment_index - 1;
+		}
+	}
+	segment_index = minimum_segment_index;
 
-		if( result == -1 )
+	/* The number of sparse segments before the segment at the offset
+	 */
+	if( segment_index > 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_stream->segments_table->mapped_ranges_array,
+		     segment_index - 1,
+		     (intptr_t **) &mapped_range,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create segment: %d.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from mapped ranges array.",
 			 function,
-			 internal_stream->current_segment_index );
+			 segment_index - 1 );
 
 			return( -1 );
 		}
-		else if( result == 0 )
-		{
-			return( 0 );
-		}
-		if( libfdata_stream_append_segment(
-		     stream,
-		     &segment_index,
-		     segment_file_index,
-		     segment_offset,
-		     segment_size,
-		     segment_flags,
-		     error ) != 1 )
+		if( mapped_range == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append segment to stream.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing mapped range: %d.",
+			 function,
+			 segment_index - 1 );
 
 			return( -1 );
 		}
-		if( internal_stream->current_segment_index != segment_index )
+		base_number_of_sparse_segments = mapped_range->number_of_sparse_segments;
+	}
+	/* Find the first segment at or after the segment at the offset
+	 * for which the number of matching segments becomes non-zero
+	 */
+	minimum_segment_index = segment_index;
+	maximum_segment_index = number_of_segments;
+
+	while( minimum_segment_index < maximum_segment_index )
+	{
+		search_segment_index = minimum_segment_index + ( ( maximum_segment_index - minimum_segment_index ) / 2 );
+
+		if( libcdata_array_get_entry_by_index(
+		     internal_stream->segments_table->mapped_ranges_array,
+		     search_segment_index,
+		     (intptr_t **) &mapped_range,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid segment index value out of bounds.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from mapped ranges array.",
+			 function,
+			 search_segment_index );
 
 			return( -1 );
 		}
-		number_of_segments++;
+		if( mapped_range == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing mapped range: %d.",
+			 function,
+			 search_segment_index );
 
-		segment_data_size = segment_size;
+			return( -1 );
+		}
+		number_of_sparse_segments = mapped_range->number_of_sparse_segments - base_number_of_sparse_segments;
+
+		if( is_sparse != 0 )
+		{
+			number_of_matching_segments = number_of_sparse_segments;
+		}
+		else
+		{
+			number_of_matching_segments = search_segment_index - segment_index + 1 - number_of_sparse_segments;
+		}
+		if( number_of_matching_segments > 0 )
+		{
+			maximum_segment_index = search_segment_index;
+		}
+		else
+		{
+			minimum_segment_index = search_segment_index + 1;
+		}
 	}
-	/* Make sure the file IO handle is pointing to the correct offset
-	 */
-	result_offset = internal_stream->seek_segment_offset(
-			 internal_stream->data_handle,
-			 file_io_handle,
-			 internal_stream->current_segment_index,
-			 segment_file_index,
-			 segment_offset,
-			 error );
+	if( minimum_segment_index >= number_of_segments )
+	{
+		return( 0 );
+	}
+	if( minimum_segment_index == segment_index )
+	{
+		*boundary_offset = offset - internal_stream->slice_offset;
 
-	if( result_offset != segment_offset )
+		return( 1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_stream->segments_table->mapped_ranges_array,
+	     minimum_segment_index,
+	     (intptr_t **) &mapped_range,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek segment: %d offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %d from mapped ranges array.",
 		 function,
-		 internal_stream->current_segment_index,
-		 segment_offset,
-		 segment_offset );
+		 minimum_segment_index );
 
 		return( -1 );
 	}
-	internal_stream->segment_offset = segment_offset;
+	if( mapped_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing mapped range: %d.",
+		 function,
+		 minimum_segment_index );
 
-	while( buffer_size > 0 )
+		return( -1 );
+	}
+	if( (size64_t) mapped_range->offset >= stream_size )
 	{
-		if( (size64_t) buffer_size <= segment_data_size )
-		{
-			write_size = buffer_size;
-		}
-		else
-		{
-			write_size = (size_t) segment_data_size;
-		}
-		if( write_size == 0 )
-		{
-			break;
-		}
-		write_count = internal_stream->write_segment_data(
-		               internal_stream->data_handle,
-		               file_io_handle,
-		               internal_stream->current_segment_index,
-		               segment_file_index,
-		               &( buffer[ buffer_offset ] ),
-		               write_size,
-		               segment_flags,
-		               write_flags,
-		               error );
+		return( 0 );
+	}
+	*boundary_offset = mapped_range->offset - internal_stream->slice_offset;
 
-		if( write_count != (ssize_t) write_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 internal_stream->current_segment_index,
-			 segment_offset + internal_stream->segment_data_offset,
-			 segment_offset + internal_stream->segment_data_offset );
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		internal_stream->current_offset      += write_size;
-		internal_stream->segment_offset      += write_size;
-		internal_stream->segment_data_offset += write_size;
-		segment_offset                       += write_size;
-		segment_data_size                    -= write_size;
-		buffer_size                          -= write_size;
-		buffer_offset                        += write_size;
+/* Retrieves the offset of the first data at or after a specific offset
+ * Data is stored in segments that are not sparse, so no data needs to be read
+ * Returns 1 if successful, 0 if there is no data at or after the offset or -1 on error
+ */
+int libfdata_stream_get_data_offset(
+     libfdata_stream_t *stream,
+     off64_t offset,
+     off64_t *data_offset,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_get_data_offset";
+	int result                                  = 0;
 
-		if( (size64_t) internal_stream->segment_data_offset >= segment_size )
-		{
-			if( (size64_t) internal_stream->segment_data_offset > segment_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid stream - segment data offset value out of bounds.",
-				 function );
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
 
-				return( -1 );
-			}
-			internal_stream->current_segment_index++;
-			internal_stream->current_segment_data_range = NULL;
-			internal_stream->segment_data_offset        = 0;
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
 
-			if( internal_stream->current_segment_index < number_of_segments )
-			{
-				if( libcdata_array_get_entry_by_index(
-				     internal_stream->segments_array,
-				     internal_stream->current_segment_index,
-				     (intptr_t **) &( internal_stream->current_segment_data_range ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve entry: %d from segments array.",
-					 function,
-					 internal_stream->current_segment_index );
+	result = libfdata_stream_get_sparse_boundary_offset(
+	          internal_stream,
+	          offset,
+	          0,
+	          data_offset,
+	          error );
 
-					return( -1 );
-				}
-				if( libfdata_range_get(
-				     internal_stream->current_segment_data_range,
-				     &segment_file_index,
-				     &segment_offset,
-				     &segment_size,
-				     &segment_flags,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve segment: %d data range values.",
-					 function,
-					 internal_stream->current_segment_index );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data offset at or after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 
-					return( -1 );
-				}
-			}
-			else
-			{
-				result = internal_stream->create_segment(
-					  internal_stream->data_handle,
-					  file_io_handle,
-					  internal_stream->current_segment_index,
-					  &segment_file_index,
-					  &segment_offset,
-					  &segment_size,
-					  &segment_flags,
-					  error );
+		return( -1 );
+	}
+	return( result );
+}
 
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create segment: %d.",
-					 function,
-					 internal_stream->current_segment_index );
+/* Retrieves the offset of the first hole at or after a specific offset
+ * A hole is stored in sparse segments, the end of the stream is considered a hole
+ * Returns 1 if successful, 0 if the offset is at or beyond the end of the stream or -1 on error
+ */
+int libfdata_stream_get_hole_offset(
+     libfdata_stream_t *stream,
+     off64_t offset,
+     off64_t *hole_offset,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_get_hole_offset";
+	int result                                  = 0;
 
-					return( -1 );
-				}
-				else if( result == 0 )
-				{
-					break;
-				}
-				if( libfdata_stream_append_segment(
-				     stream,
-				     &segment_index,
-				     segment_file_index,
-				     segment_offset,
-				     segment_size,
-				     segment_flags,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-					 "%s: unable to append segment to stream.",
-					 function );
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
 
-					return( -1 );
-				}
-				if( internal_stream->current_segment_index != segment_index )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: invalid segment index value out of bounds.",
-					 function );
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
 
-					return( -1 );
-				}
-				number_of_segments++;
-			}
-			segment_data_size = segment_size;
+	result = libfdata_stream_get_sparse_boundary_offset(
+	          internal_stream,
+	          offset,
+	          1,
+	          hole_offset,
+	          error );
 
-			result_offset = internal_stream->seek_segment_offset(
-					 internal_stream->data_handle,
-					 file_io_handle,
-					 internal_stream->current_segment_index,
-					 segment_file_index,
-					 segment_offset,
-					 error );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hole offset at or after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 
-			if( result_offset != segment_offset )
-			{
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( internal_stream->mapped_size != 0 )
+		{
+			if( (size64_t) offset >= internal_stream->mapped_size )
+			{
+				return( 0 );
+			}
+			*hole_offset = (off64_t) internal_stream->mapped_size;
+		}
+		else
+		{
+			if( (size64_t) offset >= internal_stream->size )
+			{
+				return( 0 );
+			}
+			*hole_offset = (off64_t) internal_stream->size;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the physical extent at a specific offset
+ * The extent consists of the segments that back the stream data starting at the offset,
+ * and is extended with the following segments that are physically adjacent and have
+ * the same file index and flags. Sparse segments are combined regardless of their location.
+ * The extent is limited to size bytes and the (mapped) size of the stream
+ * Returns 1 if successful, 0 if the offset is at or beyond the end of the stream or size is 0 or -1 on error
+ */
+int libfdata_stream_get_extent_at_offset(
+     libfdata_stream_t *stream,
+     off64_t offset,
+     size64_t size,
+     int *extent_file_index,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	libfdata_range_t *segment_data_range        = NULL;
+	static char *function                       = "libfdata_stream_get_extent_at_offset";
+	off64_t segment_data_offset                 = 0;
+	off64_t segment_offset                      = 0;
+	size64_t remaining_size                     = 0;
+	size64_t safe_extent_size                   = 0;
+	size64_t segment_size                       = 0;
+	size64_t stream_size                        = 0;
+	uint32_t segment_flags                      = 0;
+	int number_of_segments                      = 0;
+	int result                                  = 0;
+	int segment_file_index                      = 0;
+	int segment_index                           = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( extent_file_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file index.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->mapped_size != 0 )
+	{
+		stream_size = internal_stream->mapped_size;
+	}
+	else
+	{
+		stream_size = internal_stream->size;
+	}
+	if( ( offset >= 0 )
+	 && ( (size64_t) offset >= stream_size ) )
+	{
+		return( 0 );
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	result = libfdata_stream_get_segment_index_at_offset(
+	          stream,
+	          offset,
+	          &segment_index,
+	          &segment_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	remaining_size = stream_size - (size64_t) offset;
+
+	if( remaining_size > size )
+	{
+		remaining_size = size;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_stream->segments_table->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	while( segment_index < number_of_segments )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_stream->segments_table->segments_array,
+		     segment_index,
+		     (intptr_t **) &segment_data_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from segments array.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( libfdata_range_get(
+		     segment_data_range,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d data range values.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( safe_extent_size == 0 )
+		{
+			if( (size64_t) segment_data_offset > segment_size )
+			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_SEEK_FAILED,
-				 "%s: unable to seek segment: %d offset: %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 internal_stream->current_segment_index,
-				 segment_offset,
-				 segment_offset );
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid segment data offset value out of bounds.",
+				 function );
 
 				return( -1 );
 			}
-			internal_stream->segment_offset = segment_offset;
+			*extent_file_index = segment_file_index;
+			*extent_offset     = segment_offset + segment_data_offset;
+			*extent_flags      = segment_flags;
+
+			segment_size -= (size64_t) segment_data_offset;
+		}
+		else if( ( segment_flags != *extent_flags )
+		      || ( ( ( segment_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) == 0 )
+		        && ( ( segment_file_index != *extent_file_index )
+		         || ( segment_offset != ( *extent_offset + (off64_t) safe_extent_size ) ) ) ) )
+		{
+			break;
 		}
+		if( segment_size >= ( remaining_size - safe_extent_size ) )
+		{
+			safe_extent_size = remaining_size;
+
+			break;
+		}
+		safe_extent_size += segment_size;
+
+		segment_index++;
+	}
+	*extent_size = safe_extent_size;
+
+	return( 1 );
+}
+
+/* IO functions
+ */
+
+/* Reads data from the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfdata_stream_read_buffer(
+         libfdata_stream_t *stream,
+         intptr_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         uint8_t read_flags,
+         libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_read_buffer";
+	off64_t segment_offset                      = 0;
+	size64_t segment_size                       = 0;
+	size64_t segment_data_size                  = 0;
+	size64_t stream_size                        = 0;
+	size_t buffer_offset                        = 0;
+	size_t read_size                            = 0;
+	ssize_t read_count                          = 0;
+	uint32_t segment_flags                      = 0;
+	int segment_file_index                      = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( internal_stream->read_segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing read segment data function.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->seek_segment_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing seek segment offset function.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stream - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_STREAM,
+		 LIBFDATA_WORKLOAD_CALL_READ_BUFFER,
+		 (intptr_t *) internal_stream,
+		 0,
+		 0,
+		 internal_stream->current_offset,
+		 (size64_t) buffer_size,
+		 read_flags );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	internal_stream->number_of_bytes_requested += buffer_size;
+#endif
+	if( internal_stream->mapped_size != 0 )
+	{
+		stream_size = internal_stream->mapped_size;
+	}
+	else
+	{
+		stream_size = internal_stream->size;
+	}
+	/* Bail out early for requests to read empty buffers and beyond the end of the stream
+	 */
+	if( (size64_t) internal_stream->current_offset >= stream_size )
+	{
+		buffer_size = 0;
+	}
+	else if( (size64_t) buffer_size > ( stream_size - internal_stream->current_offset ) )
+	{
+		buffer_size = (size_t) ( stream_size - internal_stream->current_offset );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( internal_stream->write_buffer_data_size > 0 )
+	{
+		if( libfdata_stream_flush_write_buffer(
+		     (libfdata_stream_t *) internal_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_stream->maximum_read_ahead_size > 0 )
+	{
+		/* Grow the read-ahead window for sequential reads and shrink it otherwise
+		 */
+		if( internal_stream->current_offset == internal_stream->read_ahead_next_offset )
+		{
+			if( internal_stream->read_ahead_window_size < buffer_size )
+			{
+				internal_stream->read_ahead_window_size = buffer_size;
+			}
+			if( internal_stream->read_ahead_window_size > ( internal_stream->maximum_read_ahead_size / 2 ) )
+			{
+				internal_stream->read_ahead_window_size = internal_stream->maximum_read_ahead_size;
+			}
+			else
+			{
+				internal_stream->read_ahead_window_size *= 2;
+			}
+		}
+		else
+		{
+			internal_stream->read_ahead_window_size /= 2;
+		}
+		internal_stream->read_ahead_next_offset = internal_stream->current_offset + (off64_t) buffer_size;
+	}
+	if( internal_stream->current_segment_data_range == NULL )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_stream->segments_table->segments_array,
+		     internal_stream->current_segment_index,
+		     (intptr_t **) &( internal_stream->current_segment_data_range ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from segments array.",
+			 function,
+			 internal_stream->current_segment_index );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_range_get(
+	     internal_stream->current_segment_data_range,
+	     &segment_file_index,
+	     &segment_offset,
+	     &segment_size,
+	     &segment_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %d data range values.",
+		 function,
+		 internal_stream->current_segment_index );
+
+		return( -1 );
+	}
+	if( ( internal_stream->segment_data_offset < 0 )
+	 || ( segment_offset > ( INT64_MAX - internal_stream->segment_data_offset ) )
+	 || ( (size64_t) internal_stream->segment_data_offset >= segment_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stream - segment data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	segment_offset += internal_stream->segment_data_offset;
+
+	segment_data_size = segment_size - internal_stream->segment_data_offset;
+
+	internal_stream->segment_offset = segment_offset;
+
+	while( buffer_size > 0 )
+	{
+		if( (size64_t) buffer_size <= segment_data_size )
+		{
+			read_size = buffer_size;
+		}
+		else
+		{
+			read_size = (size_t) segment_data_size;
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+		read_count = libfdata_stream_read_segment_data(
+		              internal_stream,
+		              file_io_handle,
+		              internal_stream->current_segment_index,
+		              segment_file_index,
+		              segment_offset,
+		              segment_data_size,
+		              &( buffer[ buffer_offset ] ),
+		              read_size,
+		              segment_flags,
+		              read_flags,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 internal_stream->current_segment_index,
+			 segment_offset,
+			 segment_offset );
+
+			return( -1 );
+		}
+		internal_stream->current_offset      += read_size;
+		internal_stream->segment_offset      += read_size;
+		internal_stream->segment_data_offset += read_size;
+		segment_offset                       += read_size;
+		segment_data_size                    -= read_size;
+		buffer_size                          -= read_size;
+		buffer_offset                        += read_size;
+
+		if( (size64_t) internal_stream->current_offset >= stream_size )
+		{
+			break;
+		}
+		if( (size64_t) internal_stream->segment_data_offset >= segment_size )
+		{
+			if( (size64_t) internal_stream->segment_data_offset > segment_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid stream - segment data offset value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			internal_stream->current_segment_index++;
+			internal_stream->current_segment_data_range = NULL;
+			internal_stream->segment_data_offset        = 0;
+
+#if defined( HAVE_IO_STATISTICS )
+			internal_stream->number_of_segment_switches += 1;
+#endif
+
+			if( libcdata_array_get_entry_by_index(
+			     internal_stream->segments_table->segments_array,
+			     internal_stream->current_segment_index,
+			     (intptr_t **) &( internal_stream->current_segment_data_range ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve entry: %d from segments array.",
+				 function,
+				 internal_stream->current_segment_index );
+
+				return( -1 );
+			}
+			if( libfdata_range_get(
+			     internal_stream->current_segment_data_range,
+			     &segment_file_index,
+			     &segment_offset,
+			     &segment_size,
+			     &segment_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %d data range values.",
+				 function,
+				 internal_stream->current_segment_index );
+
+				return( -1 );
+			}
+			segment_data_size = segment_size;
+
+			internal_stream->segment_offset = segment_offset;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads segment data
+ * The data is copied from the read-ahead buffer if available, otherwise it is read
+ * using the read segment data function. If the read-ahead window is larger than the data,
+ * the read-ahead window is read into the read-ahead buffer, limited by the segment data size,
+ * which contains the size of the segment data remaining at the segment offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfdata_stream_read_segment_data(
+         libfdata_internal_stream_t *internal_stream,
+         intptr_t *file_io_handle,
+         int segment_index,
+         int segment_file_index,
+         off64_t segment_offset,
+         size64_t segment_data_size,
+         uint8_t *data,
+         size_t data_size,
+         uint32_t segment_flags,
+         uint8_t read_flags,
+         libcerror_error_t **error )
+{
+	uint8_t *read_data    = NULL;
+	static char *function = "libfdata_stream_read_segment_data";
+	size_t buffer_offset  = 0;
+	size_t data_offset    = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( internal_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) SSIZE_MAX )
+	 || ( (size64_t) data_size > segment_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) != 0 )
+	{
+		internal_stream->read_ahead_data_size = 0;
+	}
+	else if( ( internal_stream->read_ahead_data_size > 0 )
+	      && ( internal_stream->read_ahead_file_io_handle == file_io_handle )
+	      && ( internal_stream->read_ahead_segment_index == segment_index )
+	      && ( internal_stream->read_ahead_segment_file_index == segment_file_index )
+	      && ( internal_stream->read_ahead_segment_flags == segment_flags )
+	      && ( segment_offset >= internal_stream->read_ahead_segment_offset )
+	      && ( segment_offset < ( internal_stream->read_ahead_segment_offset + (off64_t) internal_stream->read_ahead_data_size ) ) )
+	{
+		buffer_offset = (size_t) ( segment_offset - internal_stream->read_ahead_segment_offset );
+		data_offset   = internal_stream->read_ahead_data_size - buffer_offset;
+
+		if( data_offset > data_size )
+		{
+			data_offset = data_size;
+		}
+		if( memory_copy(
+		     data,
+		     &( internal_stream->read_ahead_buffer[ buffer_offset ] ),
+		     data_offset ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data from read-ahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( data_offset == data_size )
+		{
+			return( (ssize_t) data_size );
+		}
+		segment_offset    += (off64_t) data_offset;
+		segment_data_size -= (size64_t) data_offset;
+	}
+	read_data = &( data[ data_offset ] );
+	read_size = data_size - data_offset;
+
+	if( ( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+	 && ( internal_stream->read_ahead_window_size > read_size ) )
+	{
+		if( internal_stream->read_ahead_buffer == NULL )
+		{
+			internal_stream->read_ahead_buffer = (uint8_t *) libfdata_allocator_allocate(
+			                                                  sizeof( uint8_t ) * internal_stream->maximum_read_ahead_size );
+
+			if( internal_stream->read_ahead_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create read-ahead buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		internal_stream->read_ahead_data_size = 0;
+
+		read_data = internal_stream->read_ahead_buffer;
+		read_size = internal_stream->read_ahead_window_size;
+
+		if( (size64_t) read_size > segment_data_size )
+		{
+			read_size = (size_t) segment_data_size;
+		}
+	}
+	if( internal_stream->read_alignment != 0 )
+	{
+		read_count = libfdata_stream_read_aligned_segment_data(
+		              internal_stream,
+		              file_io_handle,
+		              segment_index,
+		              segment_file_index,
+		              segment_offset,
+		              read_data,
+		              read_size,
+		              segment_flags,
+		              read_flags,
+		              error );
+	}
+	else
+	{
+		read_count = libfdata_stream_seek_and_read_segment_data(
+		              internal_stream,
+		              file_io_handle,
+		              segment_index,
+		              segment_file_index,
+		              segment_offset,
+		              read_data,
+		              read_size,
+		              segment_flags,
+		              read_flags,
+		              error );
+	}
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 segment_index,
+		 segment_offset,
+		 segment_offset );
+
+		return( -1 );
+	}
+	if( read_data == internal_stream->read_ahead_buffer )
+	{
+		internal_stream->read_ahead_data_size          = read_size;
+		internal_stream->read_ahead_file_io_handle     = file_io_handle;
+		internal_stream->read_ahead_segment_index      = segment_index;
+		internal_stream->read_ahead_segment_file_index = segment_file_index;
+		internal_stream->read_ahead_segment_offset     = segment_offset;
+		internal_stream->read_ahead_segment_flags      = segment_flags;
+
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     internal_stream->read_ahead_buffer,
+		     data_size - data_offset ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data from read-ahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( (ssize_t) data_size );
+}
+
+/* Seeks the segment offset and reads segment data using the read segment data function
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfdata_stream_seek_and_read_segment_data(
+         libfdata_internal_stream_t *internal_stream,
+         intptr_t *file_io_handle,
+         int segment_index,
+         int segment_file_index,
+         off64_t segment_offset,
+         uint8_t *data,
+         size_t data_size,
+         uint32_t segment_flags,
+         uint8_t read_flags,
+         libcerror_error_t **error )
+{
+	static char *function   = "libfdata_stream_seek_and_read_segment_data";
+	off64_t result_offset   = 0;
+	ssize_t read_count      = 0;
+	int64_t trace_timestamp = 0;
+
+#if defined( HAVE_IO_STATISTICS )
+	int64_t read_timestamp  = 0;
+#endif
+
+	if( internal_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the file IO handle is pointing to the correct offset
+	 */
+#if defined( HAVE_IO_STATISTICS )
+	internal_stream->number_of_seek_calls += 1;
+#endif
+	if( libfdata_notify_trace_function != NULL )
+	{
+		libfdata_notify_trace_get_timestamp(
+		 &trace_timestamp );
+	}
+	result_offset = internal_stream->seek_segment_offset(
+	                 internal_stream->data_handle,
+	                 file_io_handle,
+	                 segment_index,
+	                 segment_file_index,
+	                 segment_offset,
+	                 error );
+
+	if( result_offset != segment_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek segment: %d offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 segment_index,
+		 segment_offset,
+		 segment_offset );
+
+		return( -1 );
+	}
+	if( libfdata_notify_trace_function != NULL )
+	{
+		libfdata_notify_trace(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_STREAM,
+		 LIBFDATA_TRACE_OPERATION_SEEK,
+		 segment_index,
+		 segment_file_index,
+		 segment_offset,
+		 0,
+		 0,
+		 trace_timestamp );
+
+		libfdata_notify_trace_get_timestamp(
+		 &trace_timestamp );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	libfdata_latency_histogram_get_timestamp(
+	 &read_timestamp );
+#endif
+	read_count = internal_stream->read_segment_data(
+	              internal_stream->data_handle,
+	              file_io_handle,
+	              segment_index,
+	              segment_file_index,
+	              data,
+	              data_size,
+	              segment_flags,
+	              read_flags,
+	              error );
+
+#if defined( HAVE_IO_STATISTICS )
+	libfdata_latency_histogram_record(
+	 internal_stream->read_latency_histogram,
+	 read_timestamp );
+
+	internal_stream->number_of_read_calls += 1;
+
+	if( read_count > 0 )
+	{
+		internal_stream->number_of_bytes_read += (uint64_t) read_count;
+	}
+	if( ( read_count >= 0 )
+	 && ( (size_t) read_count < data_size ) )
+	{
+		internal_stream->number_of_short_reads += 1;
+	}
+#endif
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 segment_index,
+		 segment_offset,
+		 segment_offset );
+
+		return( -1 );
+	}
+	if( libfdata_notify_trace_function != NULL )
+	{
+		libfdata_notify_trace(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_STREAM,
+		 LIBFDATA_TRACE_OPERATION_READ,
+		 segment_index,
+		 segment_file_index,
+		 segment_offset,
+		 (size64_t) read_count,
+		 0,
+		 trace_timestamp );
+	}
+	return( read_count );
+}
+
+/* Reads segment data using reads of which the offset and size are a multiple of the read alignment
+ * The reads are made into the aligned buffer from which the data is copied
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfdata_stream_read_aligned_segment_data(
+         libfdata_internal_stream_t *internal_stream,
+         intptr_t *file_io_handle,
+         int segment_index,
+         int segment_file_index,
+         off64_t segment_offset,
+         uint8_t *data,
+         size_t data_size,
+         uint32_t segment_flags,
+         uint8_t read_flags,
+         libcerror_error_t **error )
+{
+	static char *function     = "libfdata_stream_read_aligned_segment_data";
+	off64_t aligned_offset    = 0;
+	size_t alignment_padding  = 0;
+	size_t copy_size          = 0;
+	size_t data_offset        = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+
+	if( internal_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->read_alignment == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing read alignment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid segment offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->aligned_buffer == NULL )
+	{
+		internal_stream->aligned_buffer_size = internal_stream->read_alignment * LIBFDATA_STREAM_NUMBER_OF_ALIGNED_BUFFER_BLOCKS;
+
+		/* The allocation contains additional space to align the start of the aligned buffer
+		 */
+		internal_stream->aligned_buffer_allocation = (uint8_t *) libfdata_allocator_allocate(
+		                                                          sizeof( uint8_t ) * ( internal_stream->aligned_buffer_size + internal_stream->read_alignment ) );
+
+		if( internal_stream->aligned_buffer_allocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create aligned buffer.",
+			 function );
+
+			return( -1 );
+		}
+		alignment_padding = (size_t) ( (intptr_t) internal_stream->aligned_buffer_allocation ) % internal_stream->read_alignment;
+
+		if( alignment_padding != 0 )
+		{
+			alignment_padding = internal_stream->read_alignment - alignment_padding;
+		}
+		internal_stream->aligned_buffer = &( internal_stream->aligned_buffer_allocation[ alignment_padding ] );
+	}
+	while( data_offset < data_size )
+	{
+		alignment_padding = (size_t) ( segment_offset % (off64_t) internal_stream->read_alignment );
+		aligned_offset    = segment_offset - (off64_t) alignment_padding;
+		copy_size         = data_size - data_offset;
+
+		if( copy_size > ( internal_stream->aligned_buffer_size - alignment_padding ) )
+		{
+			copy_size = internal_stream->aligned_buffer_size - alignment_padding;
+		}
+		read_size = alignment_padding + copy_size;
+
+		if( ( read_size % internal_stream->read_alignment ) != 0 )
+		{
+			read_size += internal_stream->read_alignment - ( read_size % internal_stream->read_alignment );
+		}
+		read_count = libfdata_stream_seek_and_read_segment_data(
+		              internal_stream,
+		              file_io_handle,
+		              segment_index,
+		              segment_file_index,
+		              aligned_offset,
+		              internal_stream->aligned_buffer,
+		              read_size,
+		              segment_flags,
+		              read_flags,
+		              error );
+
+		/* The read can be shorter than the aligned size at the end of the data
+		 */
+		if( ( read_count < 0 )
+		 || ( (size_t) read_count < ( alignment_padding + copy_size ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment: %d aligned data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 segment_index,
+			 aligned_offset,
+			 aligned_offset );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     &( internal_stream->aligned_buffer[ alignment_padding ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data from aligned buffer.",
+			 function );
+
+			return( -1 );
+		}
+		segment_offset += (off64_t) copy_size;
+		data_offset    += copy_size;
+	}
+	return( (ssize_t) data_size );
+}
+
+/* Reads data at a specific offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfdata_stream_read_buffer_at_offset(
+         libfdata_stream_t *stream,
+         intptr_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         uint8_t read_flags,
+         libcerror_error_t **error )
+{
+	static char *function = "libfdata_stream_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( libfdata_stream_seek_offset(
+	     stream,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              file_io_handle,
+	              buffer,
+	              buffer_size,
+	              read_flags,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Maps a read request to segment reads
+ * The segment reads are stored starting at the index referenced by segment_read_index,
+ * which is incremented for every segment read. If segment_indexes is NULL,
+ * the segment reads are only counted
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_map_read_request(
+     libfdata_internal_stream_t *internal_stream,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     int *segment_indexes,
+     int *segment_file_indexes,
+     off64_t *segment_offsets,
+     uint8_t **segment_data,
+     size_t *segment_data_sizes,
+     uint32_t *segment_flags,
+     int *segment_read_index,
+     libcerror_error_t **error )
+{
+	libfdata_range_t *segment_data_range = NULL;
+	static char *function                = "libfdata_stream_map_read_request";
+	off64_t range_offset                 = 0;
+	off64_t segment_data_offset          = 0;
+	size64_t range_size                  = 0;
+	size_t read_size                     = 0;
+	uint32_t range_flags                 = 0;
+	int range_file_index                 = 0;
+	int segment_index                    = 0;
+
+	if( internal_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_read_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment read index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_stream_get_segment_index_at_offset(
+	     (libfdata_stream_t *) internal_stream,
+	     offset,
+	     &segment_index,
+	     &segment_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	while( buffer_size > 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_stream->segments_table->segments_array,
+		     segment_index,
+		     (intptr_t **) &segment_data_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from segments array.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( libfdata_range_get(
+		     segment_data_range,
+		     &range_file_index,
+		     &range_offset,
+		     &range_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d data range values.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( (size64_t) segment_data_offset >= range_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d data offset value out of bounds.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( *segment_read_index == INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid segment read index value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		read_size = buffer_size;
+
+		if( (size64_t) read_size > ( range_size - segment_data_offset ) )
+		{
+			read_size = (size_t) ( range_size - segment_data_offset );
+		}
+		if( segment_indexes != NULL )
+		{
+			segment_indexes[ *segment_read_index ]      = segment_index;
+			segment_file_indexes[ *segment_read_index ] = range_file_index;
+			segment_offsets[ *segment_read_index ]      = range_offset + segment_data_offset;
+			segment_data[ *segment_read_index ]         = buffer;
+			segment_data_sizes[ *segment_read_index ]   = read_size;
+			segment_flags[ *segment_read_index ]        = range_flags;
+		}
+		*segment_read_index += 1;
+
+		buffer      += read_size;
+		buffer_size -= read_size;
+
+		segment_index++;
+
+		segment_data_offset = 0;
+	}
+	return( 1 );
+}
+
+/* Reads multiple buffers at specific offsets
+ * The read requests are mapped to segment reads of which the data is read directly into the buffers
+ * The segment reads are read with a single call to the read segment data batch function if set,
+ * otherwise they are read one at a time using the read segment data function
+ * The read count of a request is smaller than its buffer size if it extends beyond the end of the stream
+ * The current offset of the stream is not changed and the data is not read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_read_buffers_at_offsets(
+     libfdata_stream_t *stream,
+     intptr_t *file_io_handle,
+     uint8_t **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	uint8_t **segment_data                      = NULL;
+	static char *function                       = "libfdata_stream_read_buffers_at_offsets";
+	off64_t *segment_offsets                    = NULL;
+	size64_t stream_size                        = 0;
+	size_t *segment_data_sizes                  = NULL;
+	size_t read_size                            = 0;
+	ssize_t read_count                          = 0;
+	uint32_t *segment_flags                     = NULL;
+	int *segment_file_indexes                   = NULL;
+	int *segment_indexes                        = NULL;
+	int buffer_index                            = 0;
+	int number_of_segment_reads                 = 0;
+	int segment_read_index                      = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( internal_stream->read_segment_data_batch == NULL )
+	{
+		if( internal_stream->read_segment_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid stream - missing read segment data function.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_stream->seek_segment_offset == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid stream - missing seek segment offset function.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of buffers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->write_buffer_data_size > 0 )
+	{
+		if( libfdata_stream_flush_write_buffer(
+		     stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_stream->mapped_size != 0 )
+	{
+		stream_size = internal_stream->mapped_size;
+	}
+	else
+	{
+		stream_size = internal_stream->size;
+	}
+	/* Determine the read counts and the number of segment reads
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( offsets[ buffer_index ] < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid offset: %d value less than zero.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( buffer_sizes[ buffer_index ] > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer size: %d value exceeds maximum.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		read_size = buffer_sizes[ buffer_index ];
+
+		if( (size64_t) offsets[ buffer_index ] >= stream_size )
+		{
+			read_size = 0;
+		}
+		else if( (size64_t) read_size > ( stream_size - offsets[ buffer_index ] ) )
+		{
+			read_size = (size_t) ( stream_size - offsets[ buffer_index ] );
+		}
+		read_counts[ buffer_index ] = (ssize_t) read_size;
+
+		if( read_size == 0 )
+		{
+			continue;
+		}
+		if( libfdata_stream_map_read_request(
+		     internal_stream,
+		     offsets[ buffer_index ],
+		     buffers[ buffer_index ],
+		     read_size,
+		     NULL,
+		     NULL,
+		     NULL,
+		     NULL,
+		     NULL,
+		     NULL,
+		     &number_of_segment_reads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to map read request: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+#if defined( HAVE_IO_STATISTICS )
+		internal_stream->number_of_bytes_requested += buffer_sizes[ buffer_index ];
+#endif
+	}
+	if( number_of_segment_reads == 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_segment_reads > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of segment reads value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	segment_indexes = (int *) libfdata_allocator_allocate(
+	                           sizeof( int ) * number_of_segment_reads );
+
+	segment_file_indexes = (int *) libfdata_allocator_allocate(
+	                                sizeof( int ) * number_of_segment_reads );
+
+	segment_offsets = (off64_t *) libfdata_allocator_allocate(
+	                               sizeof( off64_t ) * number_of_segment_reads );
+
+	segment_data = (uint8_t **) libfdata_allocator_allocate(
+	                             sizeof( uint8_t * ) * number_of_segment_reads );
+
+	segment_data_sizes = (size_t *) libfdata_allocator_allocate(
+	                                 sizeof( size_t ) * number_of_segment_reads );
+
+	segment_flags = (uint32_t *) libfdata_allocator_allocate(
+	                              sizeof( uint32_t ) * number_of_segment_reads );
+
+	if( ( segment_indexes == NULL )
+	 || ( segment_file_indexes == NULL )
+	 || ( segment_offsets == NULL )
+	 || ( segment_data == NULL )
+	 || ( segment_data_sizes == NULL )
+	 || ( segment_flags == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment reads.",
+		 function );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( read_counts[ buffer_index ] == 0 )
+		{
+			continue;
+		}
+		if( libfdata_stream_map_read_request(
+		     internal_stream,
+		     offsets[ buffer_index ],
+		     buffers[ buffer_index ],
+		     (size_t) read_counts[ buffer_index ],
+		     segment_indexes,
+		     segment_file_indexes,
+		     segment_offsets,
+		     segment_data,
+		     segment_data_sizes,
+		     segment_flags,
+		     &segment_read_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to map read request: %d.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+	}
+	if( internal_stream->read_segment_data_batch != NULL )
+	{
+		if( internal_stream->read_segment_data_batch(
+		     internal_stream->data_handle,
+		     file_io_handle,
+		     number_of_segment_reads,
+		     segment_indexes,
+		     segment_file_indexes,
+		     segment_offsets,
+		     segment_data,
+		     segment_data_sizes,
+		     segment_flags,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read batch of: %d segment reads.",
+			 function,
+			 number_of_segment_reads );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		for( segment_read_index = 0;
+		     segment_read_index < number_of_segment_reads;
+		     segment_read_index++ )
+		{
+			if( internal_stream->read_alignment != 0 )
+			{
+				read_count = libfdata_stream_read_aligned_segment_data(
+				              internal_stream,
+				              file_io_handle,
+				              segment_indexes[ segment_read_index ],
+				              segment_file_indexes[ segment_read_index ],
+				              segment_offsets[ segment_read_index ],
+				              segment_data[ segment_read_index ],
+				              segment_data_sizes[ segment_read_index ],
+				              segment_flags[ segment_read_index ],
+				              read_flags,
+				              error );
+			}
+			else
+			{
+				read_count = libfdata_stream_seek_and_read_segment_data(
+				              internal_stream,
+				              file_io_handle,
+				              segment_indexes[ segment_read_index ],
+				              segment_file_indexes[ segment_read_index ],
+				              segment_offsets[ segment_read_index ],
+				              segment_data[ segment_read_index ],
+				              segment_data_sizes[ segment_read_index ],
+				              segment_flags[ segment_read_index ],
+				              read_flags,
+				              error );
+			}
+			if( read_count != (ssize_t) segment_data_sizes[ segment_read_index ] )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 segment_indexes[ segment_read_index ],
+				 segment_offsets[ segment_read_index ],
+				 segment_offsets[ segment_read_index ] );
+
+				goto on_error;
+			}
+		}
+	}
+	libfdata_allocator_free(
+	 segment_flags );
+	libfdata_allocator_free(
+	 segment_data_sizes );
+	libfdata_allocator_free(
+	 segment_data );
+	libfdata_allocator_free(
+	 segment_offsets );
+	libfdata_allocator_free(
+	 segment_file_indexes );
+	libfdata_allocator_free(
+	 segment_indexes );
+
+	return( 1 );
+
+on_error:
+	if( segment_flags != NULL )
+	{
+		libfdata_allocator_free(
+		 segment_flags );
+	}
+	if( segment_data_sizes != NULL )
+	{
+		libfdata_allocator_free(
+		 segment_data_sizes );
+	}
+	if( segment_data != NULL )
+	{
+		libfdata_allocator_free(
+		 segment_data );
+	}
+	if( segment_offsets != NULL )
+	{
+		libfdata_allocator_free(
+		 segment_offsets );
+	}
+	if( segment_file_indexes != NULL )
+	{
+		libfdata_allocator_free(
+		 segment_file_indexes );
+	}
+	if( segment_indexes != NULL )
+	{
+		libfdata_allocator_free(
+		 segment_indexes );
+	}
+	return( -1 );
+}
+
+/* Scans a range of the stream for the patterns
+ * The stream is read in blocks of LIBFDATA_STREAM_SEARCH_BUFFER_SIZE of which the last bytes
+ * are retained so that matches spanning blocks and segments are found. A match must be
+ * contained in the range. Matches are reported in order of offset and, for the same offset,
+ * in order of the patterns. The size of a pattern cannot exceed LIBFDATA_STREAM_SEARCH_BUFFER_SIZE
+ * If match_callback is NULL the scan stops at the first match, which is returned in
+ * match_offset and pattern_index, otherwise match_callback is called for every match
+ * The match callback function returns 1 to continue the scan, 0 to stop it or -1 on error
+ * Returns 1 if the scan was stopped at a match, 0 if the range was scanned completely or -1 on error
+ */
+int libfdata_stream_scan_patterns(
+     libfdata_internal_stream_t *internal_stream,
+     intptr_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     const uint8_t **patterns,
+     size_t *pattern_sizes,
+     int number_of_patterns,
+     int (*match_callback)(
+            intptr_t *callback_data,
+            off64_t match_offset,
+            int pattern_index,
+            libcerror_error_t **error ),
+     intptr_t *callback_data,
+     off64_t *match_offset,
+     int *pattern_index,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	uint8_t first_byte_table[ 256 ];
+
+	uint8_t *read_buffer                        = NULL;
+	uint8_t *search_buffer                      = NULL;
+	static char *function                       = "libfdata_stream_scan_patterns";
+	off64_t buffer_offset                       = 0;
+	off64_t read_offset                         = 0;
+	size64_t remaining_size                     = 0;
+	size64_t stream_size                        = 0;
+	size_t buffer_data_size                     = 0;
+	size_t buffer_index                         = 0;
+	size_t carry_index                          = 0;
+	size_t maximum_pattern_size                 = 0;
+	size_t read_size                            = 0;
+	size_t scan_size                            = 0;
+	ssize_t read_count                          = 0;
+	int result                                  = 0;
+	int safe_pattern_index                      = 0;
+
+	if( internal_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( patterns == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid patterns.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_patterns <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of patterns value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( match_callback == NULL )
+	{
+		if( match_offset == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid match offset.",
+			 function );
+
+			return( -1 );
+		}
+		if( pattern_index == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid pattern index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The first byte table is used to skip offsets at which none of the patterns can start
+	 */
+	if( memory_set(
+	     first_byte_table,
+	     0,
+	     256 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear first byte table.",
+		 function );
+
+		return( -1 );
+	}
+	for( safe_pattern_index = 0;
+	     safe_pattern_index < number_of_patterns;
+	     safe_pattern_index++ )
+	{
+		if( patterns[ safe_pattern_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid pattern: %d.",
+			 function,
+			 safe_pattern_index );
+
+			return( -1 );
+		}
+		if( ( pattern_sizes[ safe_pattern_index ] == 0 )
+		 || ( pattern_sizes[ safe_pattern_index ] > (size_t) LIBFDATA_STREAM_SEARCH_BUFFER_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid pattern: %d size value out of bounds.",
+			 function,
+			 safe_pattern_index );
+
+			return( -1 );
+		}
+		if( pattern_sizes[ safe_pattern_index ] > maximum_pattern_size )
+		{
+			maximum_pattern_size = pattern_sizes[ safe_pattern_index ];
+		}
+		first_byte_table[ patterns[ safe_pattern_index ][ 0 ] ] = 1;
+	}
+	if( internal_stream->mapped_size != 0 )
+	{
+		stream_size = internal_stream->mapped_size;
+	}
+	else
+	{
+		stream_size = internal_stream->size;
+	}
+	if( (size64_t) offset >= stream_size )
+	{
+		return( 0 );
+	}
+	remaining_size = stream_size - offset;
+
+	if( size < remaining_size )
+	{
+		remaining_size = size;
+	}
+	search_buffer = (uint8_t *) libfdata_allocator_allocate(
+	                             2 * LIBFDATA_STREAM_SEARCH_BUFFER_SIZE );
+
+	if( search_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create search buffer.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_offset = offset;
+
+	while( remaining_size > 0 )
+	{
+		read_buffer = &( search_buffer[ buffer_data_size ] );
+		read_offset = buffer_offset + buffer_data_size;
+		read_size   = LIBFDATA_STREAM_SEARCH_BUFFER_SIZE;
+
+		if( (size64_t) read_size > remaining_size )
+		{
+			read_size = (size_t) remaining_size;
+		}
+		if( libfdata_stream_read_buffers_at_offsets(
+		     (libfdata_stream_t *) internal_stream,
+		     file_io_handle,
+		     &read_buffer,
+		     &read_size,
+		     &read_offset,
+		     &read_count,
+		     1,
+		     read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset,
+			 read_offset );
+
+			goto on_error;
+		}
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset,
+			 read_offset );
+
+			goto on_error;
+		}
+		buffer_data_size += read_size;
+		remaining_size   -= read_size;
+
+		/* Offsets at which the longest pattern could extend beyond the buffered data
+		 * are searched after the next block has been read
+		 */
+		if( remaining_size == 0 )
+		{
+			scan_size = buffer_data_size;
+		}
+		else
+		{
+			scan_size = buffer_data_size - ( maximum_pattern_size - 1 );
+		}
+		for( buffer_index = 0;
+		     buffer_index < scan_size;
+		     buffer_index++ )
+		{
+			if( first_byte_table[ search_buffer[ buffer_index ] ] == 0 )
+			{
+				continue;
+			}
+			for( safe_pattern_index = 0;
+			     safe_pattern_index < number_of_patterns;
+			     safe_pattern_index++ )
+			{
+				if( pattern_sizes[ safe_pattern_index ] > ( buffer_data_size - buffer_index ) )
+				{
+					continue;
+				}
+				if( memory_compare(
+				     &( search_buffer[ buffer_index ] ),
+				     patterns[ safe_pattern_index ],
+				     pattern_sizes[ safe_pattern_index ] ) != 0 )
+				{
+					continue;
+				}
+				if( match_callback == NULL )
+				{
+					libfdata_allocator_free(
+					 search_buffer );
+
+					*match_offset  = buffer_offset + (off64_t) buffer_index;
+					*pattern_index = safe_pattern_index;
+
+					return( 1 );
+				}
+				result = match_callback(
+				          callback_data,
+				          buffer_offset + (off64_t) buffer_index,
+				          safe_pattern_index,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: match callback failed at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 buffer_offset + (off64_t) buffer_index,
+					 buffer_offset + (off64_t) buffer_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					libfdata_allocator_free(
+					 search_buffer );
+
+					return( 1 );
+				}
+			}
+		}
+		/* Move the bytes that have not been searched to the start of the search buffer
+		 */
+		for( carry_index = 0;
+		     carry_index < ( buffer_data_size - scan_size );
+		     carry_index++ )
+		{
+			search_buffer[ carry_index ] = search_buffer[ scan_size + carry_index ];
+		}
+		buffer_offset   += (off64_t) scan_size;
+		buffer_data_size = carry_index;
+	}
+	libfdata_allocator_free(
+	 search_buffer );
+
+	return( 0 );
+
+on_error:
+	if( search_buffer != NULL )
+	{
+		libfdata_allocator_free(
+		 search_buffer );
+	}
+	return( -1 );
+}
+
+/* Searches for the first occurrence of one of the patterns in a range of the stream
+ * Matches spanning segments are found, but a match must be contained in the range.
+ * If multiple patterns match at the same offset the first pattern is returned.
+ * The size of a pattern cannot exceed LIBFDATA_STREAM_SEARCH_BUFFER_SIZE
+ * The current offset of the stream is not changed
+ * Returns 1 if successful, 0 if no match was found or -1 on error
+ */
+int libfdata_stream_find_patterns(
+     libfdata_stream_t *stream,
+     intptr_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     const uint8_t **patterns,
+     size_t *pattern_sizes,
+     int number_of_patterns,
+     off64_t *match_offset,
+     int *pattern_index,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_stream_find_patterns";
+	int result            = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfdata_stream_scan_patterns(
+	          (libfdata_internal_stream_t *) stream,
+	          file_io_handle,
+	          offset,
+	          size,
+	          patterns,
+	          pattern_sizes,
+	          number_of_patterns,
+	          NULL,
+	          NULL,
+	          match_offset,
+	          pattern_index,
+	          read_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan stream for patterns.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Searches for all occurrences of the patterns in a range of the stream
+ * The match callback function is called for every match, including overlapping matches,
+ * in order of offset and, for the same offset, in order of the patterns. It returns 1 to
+ * continue the search, 0 to stop it or -1 on error
+ * The range is read once, matches spanning segments are found, but a match must be contained in the range.
+ * The size of a pattern cannot exceed LIBFDATA_STREAM_SEARCH_BUFFER_SIZE
+ * The current offset of the stream is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_find_all_patterns(
+     libfdata_stream_t *stream,
+     intptr_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     const uint8_t **patterns,
+     size_t *pattern_sizes,
+     int number_of_patterns,
+     int (*match_callback)(
+            intptr_t *callback_data,
+            off64_t match_offset,
+            int pattern_index,
+            libcerror_error_t **error ),
+     intptr_t *callback_data,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_stream_find_all_patterns";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( match_callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid match callback.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_stream_scan_patterns(
+	     (libfdata_internal_stream_t *) stream,
+	     file_io_handle,
+	     offset,
+	     size,
+	     patterns,
+	     pattern_sizes,
+	     number_of_patterns,
+	     match_callback,
+	     callback_data,
+	     NULL,
+	     NULL,
+	     read_flags,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan stream for patterns.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes data in the buffer to the current offset
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libfdata_stream_write_buffer(
+         libfdata_stream_t *stream,
+         intptr_t *file_io_handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         uint8_t write_flags,
+         libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_write_buffer";
+	off64_t segment_offset                      = 0;
+	size64_t segment_size                       = 0;
+	size64_t segment_data_size                  = 0;
+	size_t buffer_offset                        = 0;
+	size_t write_size                           = 0;
+	uint32_t segment_flags                      = 0;
+	int number_of_segments                      = 0;
+	int result                                  = 0;
+	int segment_file_index                      = 0;
+	int segment_index                           = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( ( internal_stream->create_segment == NULL )
+	 && ( internal_stream->create_segment_run == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing create segment function.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->write_segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing write segment data function.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->seek_segment_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing seek segment offset function.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stream - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Bail out early for requests to write empty buffers
+	 */
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_stream->segments_table->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_stream->current_offset < internal_stream->size )
+	{
+		if( internal_stream->current_segment_data_range == NULL )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_stream->segments_table->segments_array,
+			     internal_stream->current_segment_index,
+			     (intptr_t **) &( internal_stream->current_segment_data_range ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve entry: %d from segments array.",
+				 function,
+				 internal_stream->current_segment_index );
+
+				return( -1 );
+			}
+		}
+		if( libfdata_range_get(
+		     internal_stream->current_segment_data_range,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d data range values.",
+			 function,
+			 internal_stream->current_segment_index );
+
+			return( -1 );
+		}
+		if( ( internal_stream->segment_data_offset < 0 )
+		 || ( (size64_t) internal_stream->segment_data_offset >= segment_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid stream - segment data offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		segment_offset += internal_stream->segment_data_offset;
+
+		segment_data_size = segment_size - internal_stream->segment_data_offset;
+	}
+	else while( (size64_t) internal_stream->current_offset >= internal_stream->size )
+	{
+		if( internal_stream->current_segment_index < number_of_segments )
+		{
+			internal_stream->current_segment_index++;
+			internal_stream->current_segment_data_range = NULL;
+		}
+		internal_stream->segment_data_offset = 0;
+
+		result = libfdata_stream_create_segment(
+		          internal_stream,
+		          file_io_handle,
+		          internal_stream->current_segment_index,
+		          &segment_file_index,
+		          &segment_offset,
+		          &segment_size,
+		          &segment_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment: %d.",
+			 function,
+			 internal_stream->current_segment_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( libfdata_stream_append_segment(
+		     stream,
+		     &segment_index,
+		     segment_file_index,
+		     segment_offset,
+		     segment_size,
+		     segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment to stream.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_stream->current_segment_index != segment_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment index value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_segments++;
+
+		segment_data_size = segment_size;
+	}
+	internal_stream->segment_offset = segment_offset;
+
+	while( buffer_size > 0 )
+	{
+		if( (size64_t) buffer_size <= segment_data_size )
+		{
+			write_size = buffer_size;
+		}
+		else
+		{
+			write_size = (size_t) segment_data_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( libfdata_stream_write_segment_data(
+		     internal_stream,
+		     file_io_handle,
+		     internal_stream->current_segment_index,
+		     segment_file_index,
+		     segment_offset,
+		     &( buffer[ buffer_offset ] ),
+		     write_size,
+		     segment_flags,
+		     write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 internal_stream->current_segment_index,
+			 segment_offset,
+			 segment_offset );
+
+			return( -1 );
+		}
+		internal_stream->current_offset      += write_size;
+		internal_stream->segment_offset      += write_size;
+		internal_stream->segment_data_offset += write_size;
+		segment_offset                       += write_size;
+		segment_data_size                    -= write_size;
+		buffer_size                          -= write_size;
+		buffer_offset                        += write_size;
+
+		if( (size64_t) internal_stream->segment_data_offset >= segment_size )
+		{
+			if( (size64_t) internal_stream->segment_data_offset > segment_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid stream - segment data offset value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			internal_stream->current_segment_index++;
+			internal_stream->current_segment_data_range = NULL;
+			internal_stream->segment_data_offset        = 0;
+
+			if( internal_stream->current_segment_index < number_of_segments )
+			{
+				if( libcdata_array_get_entry_by_index(
+				     internal_stream->segments_table->segments_array,
+				     internal_stream->current_segment_index,
+				     (intptr_t **) &( internal_stream->current_segment_data_range ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve entry: %d from segments array.",
+					 function,
+					 internal_stream->current_segment_index );
+
+					return( -1 );
+				}
+				if( libfdata_range_get(
+				     internal_stream->current_segment_data_range,
+				     &segment_file_index,
+				     &segment_offset,
+				     &segment_size,
+				     &segment_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve segment: %d data range values.",
+					 function,
+					 internal_stream->current_segment_index );
+
+					return( -1 );
+				}
+			}
+			else
+			{
+				result = libfdata_stream_create_segment(
+				          internal_stream,
+				          file_io_handle,
+				          internal_stream->current_segment_index,
+				          &segment_file_index,
+				          &segment_offset,
+				          &segment_size,
+				          &segment_flags,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create segment: %d.",
+					 function,
+					 internal_stream->current_segment_index );
+
+					return( -1 );
+				}
+				else if( result == 0 )
+				{
+					break;
+				}
+				if( libfdata_stream_append_segment(
+				     stream,
+				     &segment_index,
+				     segment_file_index,
+				     segment_offset,
+				     segment_size,
+				     segment_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append segment to stream.",
+					 function );
+
+					return( -1 );
+				}
+				if( internal_stream->current_segment_index != segment_index )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid segment index value out of bounds.",
+					 function );
+
+					return( -1 );
+				}
+				number_of_segments++;
+			}
+			segment_data_size = segment_size;
+
+			internal_stream->segment_offset = segment_offset;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes segment data
+ * The data is added to the write buffer when write buffering is enabled and the data
+ * is smaller than the write buffer, otherwise it is written directly
+ * Data is only added to the write buffer if it directly follows the buffered data and
+ * is written with the same file IO handle. Data written with another file IO handle,
+ * even one of the same file, flushes the write buffer first
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_write_segment_data(
+     libfdata_internal_stream_t *internal_stream,
+     intptr_t *file_io_handle,
+     int segment_index,
+     int segment_file_index,
+     off64_t segment_offset,
+     const uint8_t *segment_data,
+     size_t segment_data_size,
+     uint32_t segment_flags,
+     uint8_t write_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_stream_write_segment_data";
+	off64_t result_offset = 0;
+	ssize_t write_count   = 0;
+
+	if( internal_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data in the read-ahead buffer can be overwritten
+	 */
+	internal_stream->read_ahead_data_size = 0;
+
+	if( internal_stream->write_buffer_data_size > 0 )
+	{
+		/* Only data that directly follows the data in the write buffer can be added
+		 */
+		if( ( internal_stream->write_buffer_file_io_handle != file_io_handle )
+		 || ( internal_stream->write_buffer_segment_index != segment_index )
+		 || ( internal_stream->write_buffer_segment_file_index != segment_file_index )
+		 || ( internal_stream->write_buffer_segment_flags != segment_flags )
+		 || ( internal_stream->write_buffer_write_flags != write_flags )
+		 || ( ( internal_stream->write_buffer_segment_offset + (off64_t) internal_stream->write_buffer_data_size ) != segment_offset )
+		 || ( segment_data_size > ( internal_stream->write_buffer_size - internal_stream->write_buffer_data_size ) ) )
+		{
+			if( libfdata_stream_flush_write_buffer(
+			     (libfdata_stream_t *) internal_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	if( segment_data_size < internal_stream->write_buffer_size )
+	{
+		if( internal_stream->write_buffer == NULL )
+		{
+			internal_stream->write_buffer = (uint8_t *) libfdata_allocator_allocate(
+			                                             sizeof( uint8_t ) * internal_stream->write_buffer_size );
+
+			if( internal_stream->write_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( internal_stream->write_buffer_data_size == 0 )
+		{
+			internal_stream->write_buffer_file_io_handle     = file_io_handle;
+			internal_stream->write_buffer_segment_index      = segment_index;
+			internal_stream->write_buffer_segment_file_index = segment_file_index;
+			internal_stream->write_buffer_segment_offset     = segment_offset;
+			internal_stream->write_buffer_segment_flags      = segment_flags;
+			internal_stream->write_buffer_write_flags        = write_flags;
+		}
+		if( memory_copy(
+		     &( internal_stream->write_buffer[ internal_stream->write_buffer_data_size ] ),
+		     segment_data,
+		     segment_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy segment data to write buffer.",
+			 function );
+
+			return( -1 );
+		}
+		internal_stream->write_buffer_data_size += segment_data_size;
+
+		return( 1 );
+	}
+	/* Make sure the file IO handle is pointing to the correct offset
+	 */
+	result_offset = internal_stream->seek_segment_offset(
+			 internal_stream->data_handle,
+			 file_io_handle,
+			 segment_index,
+			 segment_file_index,
+			 segment_offset,
+			 error );
+
+	if( result_offset != segment_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek segment: %d offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 segment_index,
+		 segment_offset,
+		 segment_offset );
+
+		return( -1 );
+	}
+	write_count = internal_stream->write_segment_data(
+	               internal_stream->data_handle,
+	               file_io_handle,
+	               segment_index,
+	               segment_file_index,
+	               segment_data,
+	               segment_data_size,
+	               segment_flags,
+	               write_flags,
+	               error );
+
+	if( write_count != (ssize_t) segment_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 segment_index,
+		 segment_offset,
+		 segment_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Flushes the write buffer
+ * Writes the data in the write buffer, if any, with a single write segment data function call
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_flush_write_buffer(
+     libfdata_stream_t *stream,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_flush_write_buffer";
+	off64_t result_offset                       = 0;
+	ssize_t write_count                         = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( internal_stream->write_buffer_data_size == 0 )
+	{
+		return( 1 );
+	}
+	if( internal_stream->write_segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing write segment data function.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->seek_segment_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream - missing seek segment offset function.",
+		 function );
+
+		return( -1 );
+	}
+	result_offset = internal_stream->seek_segment_offset(
+			 internal_stream->data_handle,
+			 internal_stream->write_buffer_file_io_handle,
+			 internal_stream->write_buffer_segment_index,
+			 internal_stream->write_buffer_segment_file_index,
+			 internal_stream->write_buffer_segment_offset,
+			 error );
+
+	if( result_offset != internal_stream->write_buffer_segment_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek segment: %d offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_stream->write_buffer_segment_index,
+		 internal_stream->write_buffer_segment_offset,
+		 internal_stream->write_buffer_segment_offset );
+
+		return( -1 );
+	}
+	write_count = internal_stream->write_segment_data(
+	               internal_stream->data_handle,
+	               internal_stream->write_buffer_file_io_handle,
+	               internal_stream->write_buffer_segment_index,
+	               internal_stream->write_buffer_segment_file_index,
+	               internal_stream->write_buffer,
+	               internal_stream->write_buffer_data_size,
+	               internal_stream->write_buffer_segment_flags,
+	               internal_stream->write_buffer_write_flags,
+	               error );
+
+	if( write_count != (ssize_t) internal_stream->write_buffer_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_stream->write_buffer_segment_index,
+		 internal_stream->write_buffer_segment_offset,
+		 internal_stream->write_buffer_segment_offset );
+
+		return( -1 );
+	}
+	internal_stream->write_buffer_data_size      = 0;
+	internal_stream->write_buffer_file_io_handle = NULL;
+
+	return( 1 );
+}
+
+/* Sets the write buffer size
+ * When set, writes of data smaller than the write buffer size are combined in the write buffer
+ * and written when the buffer is full, when data is written that does not directly follow
+ * the buffered data or is written with another file IO handle, when the stream is read
+ * or seeked to another offset, or when libfdata_stream_flush_write_buffer is called.
+ * The file IO handle used to write the buffered data must remain open until the data is written
+ * The buffered data must be flushed before the stream is freed, free does not write it and
+ * returns an error if the write buffer still contains data
+ * Until the data is written, reads of the same file through other streams, clones or file IO handles
+ * return the data as it was before the buffered write
+ * A write buffer size of 0 disables write buffering
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_set_write_buffer_size(
+     libfdata_stream_t *stream,
+     size_t write_buffer_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_set_write_buffer_size";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( write_buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid write buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_stream_flush_write_buffer(
+	     stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->write_buffer != NULL )
+	{
+		libfdata_allocator_free(
+		 internal_stream->write_buffer );
+
+		internal_stream->write_buffer = NULL;
+	}
+	internal_stream->write_buffer_size = write_buffer_size;
+
+	return( 1 );
+}
+
+/* Sets the maximum read-ahead size
+ * When set, sequential reads are detected and the read-ahead window is doubled
+ * for every sequential read up to the maximum read-ahead size and halved for
+ * every non-sequential read. When the read-ahead window is larger than the data
+ * to read, the read-ahead window of the segment is read into the read-ahead buffer
+ * and subsequent reads of the buffered data do not call the read segment data function.
+ * Writes through the stream, changes to its segments and reads with LIBFDATA_READ_FLAG_IGNORE_CACHE
+ * discard the read-ahead buffer. Writes to the segment files through other streams, such as clones,
+ * slices or composed streams, or through other file IO handles are not detected. After such writes
+ * call this function, which discards the read-ahead buffer, or read with LIBFDATA_READ_FLAG_IGNORE_CACHE
+ * A maximum read-ahead size of 0 disables read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_set_maximum_read_ahead_size(
+     libfdata_stream_t *stream,
+     size_t maximum_read_ahead_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_set_maximum_read_ahead_size";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( maximum_read_ahead_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum read-ahead size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->read_ahead_buffer != NULL )
+	{
+		libfdata_allocator_free(
+		 internal_stream->read_ahead_buffer );
+
+		internal_stream->read_ahead_buffer = NULL;
+	}
+	internal_stream->maximum_read_ahead_size   = maximum_read_ahead_size;
+	internal_stream->read_ahead_window_size    = 0;
+	internal_stream->read_ahead_data_size      = 0;
+	internal_stream->read_ahead_file_io_handle = NULL;
+
+	return( 1 );
+}
+
+/* Sets the read alignment
+ * When set, the offset and size of the reads of the read segment data function
+ * are a multiple of the read alignment and the data is read into a buffer that is
+ * aligned to the read alignment, such as required for direct IO.
+ * The requested data is copied from this buffer. The read alignment applies
+ * to the segment offsets in the segment files and must be a power of 2.
+ * Writes are not aligned
+ * A read alignment of 0 disables aligned reads
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_set_read_alignment(
+     libfdata_stream_t *stream,
+     size_t read_alignment,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_set_read_alignment";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( read_alignment > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / ( LIBFDATA_STREAM_NUMBER_OF_ALIGNED_BUFFER_BLOCKS + 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read alignment value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_alignment & ( read_alignment - 1 ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported read alignment value not a power of 2.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream->aligned_buffer_allocation != NULL )
+	{
+		libfdata_allocator_free(
+		 internal_stream->aligned_buffer_allocation );
+
+		internal_stream->aligned_buffer_allocation = NULL;
+		internal_stream->aligned_buffer            = NULL;
+		internal_stream->aligned_buffer_size       = 0;
+	}
+	internal_stream->read_alignment = read_alignment;
+
+	return( 1 );
+}
+
+/* Sets the read segment data batch function
+ * The read segment data batch function reads multiple segment reads, for example
+ * by submitting them to an asynchronous IO interface and waiting for their completion.
+ * It is used by libfdata_stream_read_buffers_at_offsets and returns 1 if all segment
+ * reads were read completely or -1 on error. The read alignment does not apply to it
+ * A read segment data batch function of NULL reads the segment reads one at a time
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_set_read_segment_data_batch_function(
+     libfdata_stream_t *stream,
+     int (*read_segment_data_batch)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            int number_of_segment_reads,
+            int *segment_indexes,
+            int *segment_file_indexes,
+            off64_t *segment_offsets,
+            uint8_t **segment_data,
+            size_t *segment_data_sizes,
+            uint32_t *segment_flags,
+            uint8_t read_flags,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_set_read_segment_data_batch_function";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
 	}
-	return( (ssize_t) buffer_offset );
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	internal_stream->read_segment_data_batch = read_segment_data_batch;
+
+	return( 1 );
 }
 
 /* Seeks a certain offset of the data
@@ -2390,6 +6156,18 @@ off64_t libfdata_stream_seek_offset(
 
 		return( -1 );
 	}
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_STREAM,
+		 LIBFDATA_WORKLOAD_CALL_SEEK_OFFSET,
+		 (intptr_t *) internal_stream,
+		 0,
+		 0,
+		 offset,
+		 0,
+		 (uint8_t) whence );
+	}
 	if( internal_stream->mapped_size != 0 )
 	{
 		stream_size = internal_stream->mapped_size;
@@ -2429,6 +6207,22 @@ off64_t libfdata_stream_seek_offset(
 
 			return( -1 );
 		}
+		if( internal_stream->write_buffer_data_size > 0 )
+		{
+			if( libfdata_stream_flush_write_buffer(
+			     (libfdata_stream_t *) internal_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		if( offset < (off64_t) stream_size )
 		{
 			if( libfdata_stream_get_segment_index_at_offset(
@@ -2453,7 +6247,7 @@ off64_t libfdata_stream_seek_offset(
 		else
 		{
 			if( libcdata_array_get_number_of_entries(
-			     internal_stream->segments_array,
+			     internal_stream->segments_table->segments_array,
 			     &segment_index,
 			     error ) != 1 )
 			{
@@ -2553,9 +6347,24 @@ int libfdata_stream_get_size(
 	}
 	if( ( internal_stream->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
+		if( libfdata_segments_table_make_writable(
+		     &( internal_stream->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
+
+			return( -1 );
+		}
+		internal_stream->current_segment_data_range = NULL;
+
 		if( libfdata_segments_array_calculate_mapped_ranges(
-		     internal_stream->segments_array,
-		     internal_stream->mapped_ranges_array,
+		     internal_stream->segments_table->segments_array,
+		     internal_stream->segments_table->mapped_ranges_array,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -2580,3 +6389,323 @@ int libfdata_stream_get_size(
 	return( 1 );
 }
 
+/* Memory usage functions
+ */
+
+/* Retrieves the memory usage
+ * The structure size contains the size of the stream, its segments, mapped ranges and write buffer.
+ * The stream does not cache data
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_stream_get_memory_usage(
+     libfdata_stream_t *stream,
+     size64_t *structure_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_stream_t *internal_stream = NULL;
+	static char *function                       = "libfdata_stream_get_memory_usage";
+	size64_t memory_usage                       = 0;
+	size64_t safe_structure_size                = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( structure_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid structure size.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( libfdata_segments_table_get_memory_usage(
+	     internal_stream->segments_table,
+	     &memory_usage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory usage of segments.",
+		 function );
+
+		return( -1 );
+	}
+	safe_structure_size = sizeof( libfdata_internal_stream_t ) + memory_usage;
+
+	if( internal_stream->write_buffer != NULL )
+	{
+		safe_structure_size += internal_stream->write_buffer_size;
+	}
+	if( internal_stream->read_ahead_buffer != NULL )
+	{
+		safe_structure_size += internal_stream->maximum_read_ahead_size;
+	}
+	if( internal_stream->aligned_buffer_allocation != NULL )
+	{
+		safe_structure_size += internal_stream->aligned_buffer_size + internal_stream->read_alignment;
+	}
+
+	*structure_size = safe_structure_size;
+
+	return( 1 );
+}
+
+/* IO statistics functions
+ */
+
+/* Retrieves the IO statistics
+ * The statistics cover the reads done by libfdata_stream_read_buffer
+ * and are only maintained when the library was built with IO statistics support
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_stream_get_io_statistics(
+     libfdata_stream_t *stream,
+     uint64_t *number_of_read_calls,
+     uint64_t *number_of_seek_calls,
+     uint64_t *number_of_segment_switches,
+     uint64_t *number_of_bytes_requested,
+     uint64_t *number_of_bytes_read,
+     uint64_t *number_of_short_reads,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_IO_STATISTICS )
+	libfdata_internal_stream_t *internal_stream = NULL;
+#endif
+	static char *function                       = "libfdata_stream_get_io_statistics";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_calls == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of read calls.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_seek_calls == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of seek calls.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segment_switches == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of segment switches.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bytes_requested == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bytes requested.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bytes_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bytes read.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_short_reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of short reads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	*number_of_read_calls       = internal_stream->number_of_read_calls;
+	*number_of_seek_calls       = internal_stream->number_of_seek_calls;
+	*number_of_segment_switches = internal_stream->number_of_segment_switches;
+	*number_of_bytes_requested  = internal_stream->number_of_bytes_requested;
+	*number_of_bytes_read       = internal_stream->number_of_bytes_read;
+	*number_of_short_reads      = internal_stream->number_of_short_reads;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Resets the IO statistics and the read latency histogram
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_stream_reset_io_statistics(
+     libfdata_stream_t *stream,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_IO_STATISTICS )
+	libfdata_internal_stream_t *internal_stream = NULL;
+#endif
+	static char *function                       = "libfdata_stream_reset_io_statistics";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	internal_stream->number_of_read_calls       = 0;
+	internal_stream->number_of_seek_calls       = 0;
+	internal_stream->number_of_segment_switches = 0;
+	internal_stream->number_of_bytes_requested  = 0;
+	internal_stream->number_of_bytes_read       = 0;
+	internal_stream->number_of_short_reads      = 0;
+
+	if( memory_set(
+	     internal_stream->read_latency_histogram,
+	     0,
+	     sizeof( uint64_t ) * LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read latency histogram.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the read latency histogram
+ * The histogram contains the number of read segment data function calls per latency bucket,
+ * where bucket N contains the latencies of at least 2^(N-1) and less than 2^N nanoseconds
+ * and bucket 0 the latencies of 0. The latencies are measured with a monotonic clock.
+ * The histogram is only maintained when the library was built with IO statistics support
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_stream_get_read_latency_histogram(
+     libfdata_stream_t *stream,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_IO_STATISTICS )
+	libfdata_internal_stream_t *internal_stream = NULL;
+#endif
+	static char *function                       = "libfdata_stream_get_read_latency_histogram";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of buckets value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	internal_stream = (libfdata_internal_stream_t *) stream;
+
+	if( libfdata_latency_histogram_get_buckets(
+	     internal_stream->read_latency_histogram,
+	     histogram,
+	     number_of_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read latency histogram.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
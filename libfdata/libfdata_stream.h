@@ -25,17 +25,28 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfdata_definitions.h"
 #include "libfdata_extern.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_mapped_range.h"
 #include "libfdata_range.h"
+#include "libfdata_segments_table.h"
 #include "libfdata_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The number of blocks of the read alignment in the aligned buffer
+ */
+#define LIBFDATA_STREAM_NUMBER_OF_ALIGNED_BUFFER_BLOCKS			16
+
+/* The size of the blocks read when searching for patterns
+ * which is also the maximum pattern size
+ */
+#define LIBFDATA_STREAM_SEARCH_BUFFER_SIZE				65536
+
 typedef struct libfdata_internal_stream libfdata_internal_stream_t;
 
 struct libfdata_internal_stream
@@ -68,13 +79,167 @@ struct libfdata_internal_stream
 	 */
 	size64_t mapped_size;
 
-	/* The segments array
+	/* The offset of the slice relative to the start of the segments
+	 * which is 0 if the stream is not a slice
+	 */
+	off64_t slice_offset;
+
+	/* The segments table, which can be shared with clones
+	 */
+	libfdata_segments_table_t *segments_table;
+
+	/* The write buffer
+	 */
+	uint8_t *write_buffer;
+
+	/* The write buffer size
+	 * where 0 represents that writes are not buffered
+	 */
+	size_t write_buffer_size;
+
+	/* The size of the data in the write buffer
+	 */
+	size_t write_buffer_data_size;
+
+	/* The file IO handle of the data in the write buffer
+	 */
+	intptr_t *write_buffer_file_io_handle;
+
+	/* The segment index of the data in the write buffer
+	 */
+	int write_buffer_segment_index;
+
+	/* The segment file index of the data in the write buffer
+	 */
+	int write_buffer_segment_file_index;
+
+	/* The segment offset of the data in the write buffer
+	 */
+	off64_t write_buffer_segment_offset;
+
+	/* The segment flags of the data in the write buffer
+	 */
+	uint32_t write_buffer_segment_flags;
+
+	/* The write flags of the data in the write buffer
+	 */
+	uint8_t write_buffer_write_flags;
+
+	/* The read-ahead buffer
+	 */
+	uint8_t *read_ahead_buffer;
+
+	/* The maximum read-ahead size
+	 * where 0 represents that reads are not read-ahead
+	 */
+	size_t maximum_read_ahead_size;
+
+	/* The read-ahead window size
+	 */
+	size_t read_ahead_window_size;
+
+	/* The offset of the next read if reads are sequential
+	 */
+	off64_t read_ahead_next_offset;
+
+	/* The size of the data in the read-ahead buffer
+	 */
+	size_t read_ahead_data_size;
+
+	/* The file IO handle of the data in the read-ahead buffer
+	 */
+	intptr_t *read_ahead_file_io_handle;
+
+	/* The segment index of the data in the read-ahead buffer
+	 */
+	int read_ahead_segment_index;
+
+	/* The segment file index of the data in the read-ahead buffer
+	 */
+	int read_ahead_segment_file_index;
+
+	/* The segment offset of the data in the read-ahead buffer
+	 */
+	off64_t read_ahead_segment_offset;
+
+	/* The segment flags of the data in the read-ahead buffer
+	 */
+	uint32_t read_ahead_segment_flags;
+
+	/* The read alignment
+	 * where 0 represents that reads are not aligned
+	 */
+	size_t read_alignment;
+
+	/* The allocation of the aligned buffer
+	 */
+	uint8_t *aligned_buffer_allocation;
+
+	/* The aligned buffer, which is aligned to the read alignment
+	 */
+	uint8_t *aligned_buffer;
+
+	/* The aligned buffer size
+	 */
+	size_t aligned_buffer_size;
+
+	/* The segment index of the first reserved segment
+	 */
+	int reserved_segment_index;
+
+	/* The number of reserved segments
 	 */
-	libcdata_array_t *segments_array;
+	int number_of_reserved_segments;
 
-	/* The mapped ranges array
+	/* The file index of the reserved segments
 	 */
-	libcdata_array_t *mapped_ranges_array;
+	int reserved_segment_file_index;
+
+	/* The offset of the first reserved segment
+	 */
+	off64_t reserved_segment_offset;
+
+	/* The size of a reserved segment
+	 */
+	size64_t reserved_segment_size;
+
+	/* The flags of the reserved segments
+	 */
+	uint32_t reserved_segment_flags;
+
+	/* The maximum number of segments in a segment run
+	 */
+	int maximum_number_of_segments_per_run;
+
+#if defined( HAVE_IO_STATISTICS )
+	/* The number of read segment data function calls
+	 */
+	uint64_t number_of_read_calls;
+
+	/* The number of seek segment offset function calls
+	 */
+	uint64_t number_of_seek_calls;
+
+	/* The number of times a read continued in the next segment
+	 */
+	uint64_t number_of_segment_switches;
+
+	/* The number of bytes requested to be read
+	 */
+	uint64_t number_of_bytes_requested;
+
+	/* The number of bytes returned by the read segment data function
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of times the read segment data function read less data than requested
+	 */
+	uint64_t number_of_short_reads;
+
+	/* The read latency histogram
+	 */
+	uint64_t read_latency_histogram[ LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+#endif
 
 	/* The flags
 	 */
@@ -109,6 +274,20 @@ struct libfdata_internal_stream
 	       uint32_t *segment_flags,
 	       libcerror_error_t **error );
 
+	/* The create segment run function
+	 */
+	int (*create_segment_run)(
+	       intptr_t *data_handle,
+	       intptr_t *file_io_handle,
+	       int segment_index,
+	       int maximum_number_of_segments,
+	       int *segment_file_index,
+	       off64_t *segment_offset,
+	       size64_t *segment_size,
+	       uint32_t *segment_flags,
+	       int *number_of_segments,
+	       libcerror_error_t **error );
+
 	/* The read segment data function
 	 */
 	ssize_t (*read_segment_data)(
@@ -144,6 +323,21 @@ struct libfdata_internal_stream
 	           int segment_file_index,
 	           off64_t segment_offset,
 	           libcerror_error_t **error );
+
+	/* The read segment data batch function
+	 */
+	int (*read_segment_data_batch)(
+	       intptr_t *data_handle,
+	       intptr_t *file_io_handle,
+	       int number_of_segment_reads,
+	       int *segment_indexes,
+	       int *segment_file_indexes,
+	       off64_t *segment_offsets,
+	       uint8_t **segment_data,
+	       size_t *segment_data_sizes,
+	       uint32_t *segment_flags,
+	       uint8_t read_flags,
+	       libcerror_error_t **error );
 };
 
 LIBFDATA_EXTERN \
@@ -196,6 +390,21 @@ int libfdata_stream_initialize(
      uint8_t flags,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_stream_initialize_slice(
+     libfdata_stream_t **slice_stream,
+     libfdata_stream_t *source_stream,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_initialize_composed(
+     libfdata_stream_t **composed_stream,
+     libfdata_stream_t *upper_stream,
+     libfdata_stream_t *lower_stream,
+     libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 int libfdata_stream_free(
      libfdata_stream_t **stream,
@@ -276,6 +485,33 @@ int libfdata_stream_set_mapped_size(
      size64_t mapped_size,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_stream_set_create_segment_run_function(
+     libfdata_stream_t *stream,
+     int (*create_segment_run)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            int segment_index,
+            int maximum_number_of_segments,
+            int *segment_file_index,
+            off64_t *segment_offset,
+            size64_t *segment_size,
+            uint32_t *segment_flags,
+            int *number_of_segments,
+            libcerror_error_t **error ),
+     int maximum_number_of_segments_per_run,
+     libcerror_error_t **error );
+
+int libfdata_stream_create_segment(
+     libfdata_internal_stream_t *internal_stream,
+     intptr_t *file_io_handle,
+     int segment_index,
+     int *segment_file_index,
+     off64_t *segment_offset,
+     size64_t *segment_size,
+     uint32_t *segment_flags,
+     libcerror_error_t **error );
+
 /* Mapped range functions
  */
 LIBFDATA_EXTERN \
@@ -306,6 +542,38 @@ int libfdata_stream_get_segment_at_offset(
      uint32_t *segment_flags,
      libcerror_error_t **error );
 
+int libfdata_stream_get_sparse_boundary_offset(
+     libfdata_internal_stream_t *internal_stream,
+     off64_t offset,
+     uint8_t is_sparse,
+     off64_t *boundary_offset,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_get_data_offset(
+     libfdata_stream_t *stream,
+     off64_t offset,
+     off64_t *data_offset,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_get_hole_offset(
+     libfdata_stream_t *stream,
+     off64_t offset,
+     off64_t *hole_offset,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_get_extent_at_offset(
+     libfdata_stream_t *stream,
+     off64_t offset,
+     size64_t size,
+     int *extent_file_index,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
 /* IO functions
  */
 LIBFDATA_EXTERN \
@@ -317,6 +585,43 @@ ssize_t libfdata_stream_read_buffer(
          uint8_t read_flags,
          libcerror_error_t **error );
 
+ssize_t libfdata_stream_read_segment_data(
+         libfdata_internal_stream_t *internal_stream,
+         intptr_t *file_io_handle,
+         int segment_index,
+         int segment_file_index,
+         off64_t segment_offset,
+         size64_t segment_data_size,
+         uint8_t *data,
+         size_t data_size,
+         uint32_t segment_flags,
+         uint8_t read_flags,
+         libcerror_error_t **error );
+
+ssize_t libfdata_stream_seek_and_read_segment_data(
+         libfdata_internal_stream_t *internal_stream,
+         intptr_t *file_io_handle,
+         int segment_index,
+         int segment_file_index,
+         off64_t segment_offset,
+         uint8_t *data,
+         size_t data_size,
+         uint32_t segment_flags,
+         uint8_t read_flags,
+         libcerror_error_t **error );
+
+ssize_t libfdata_stream_read_aligned_segment_data(
+         libfdata_internal_stream_t *internal_stream,
+         intptr_t *file_io_handle,
+         int segment_index,
+         int segment_file_index,
+         off64_t segment_offset,
+         uint8_t *data,
+         size_t data_size,
+         uint32_t segment_flags,
+         uint8_t read_flags,
+         libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 ssize_t libfdata_stream_read_buffer_at_offset(
          libfdata_stream_t *stream,
@@ -327,6 +632,83 @@ ssize_t libfdata_stream_read_buffer_at_offset(
          uint8_t read_flags,
          libcerror_error_t **error );
 
+int libfdata_stream_map_read_request(
+     libfdata_internal_stream_t *internal_stream,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     int *segment_indexes,
+     int *segment_file_indexes,
+     off64_t *segment_offsets,
+     uint8_t **segment_data,
+     size_t *segment_data_sizes,
+     uint32_t *segment_flags,
+     int *segment_read_index,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_read_buffers_at_offsets(
+     libfdata_stream_t *stream,
+     intptr_t *file_io_handle,
+     uint8_t **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+int libfdata_stream_scan_patterns(
+     libfdata_internal_stream_t *internal_stream,
+     intptr_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     const uint8_t **patterns,
+     size_t *pattern_sizes,
+     int number_of_patterns,
+     int (*match_callback)(
+            intptr_t *callback_data,
+            off64_t match_offset,
+            int pattern_index,
+            libcerror_error_t **error ),
+     intptr_t *callback_data,
+     off64_t *match_offset,
+     int *pattern_index,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_find_patterns(
+     libfdata_stream_t *stream,
+     intptr_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     const uint8_t **patterns,
+     size_t *pattern_sizes,
+     int number_of_patterns,
+     off64_t *match_offset,
+     int *pattern_index,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_find_all_patterns(
+     libfdata_stream_t *stream,
+     intptr_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     const uint8_t **patterns,
+     size_t *pattern_sizes,
+     int number_of_patterns,
+     int (*match_callback)(
+            intptr_t *callback_data,
+            off64_t match_offset,
+            int pattern_index,
+            libcerror_error_t **error ),
+     intptr_t *callback_data,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 ssize_t libfdata_stream_write_buffer(
          libfdata_stream_t *stream,
@@ -336,6 +718,58 @@ ssize_t libfdata_stream_write_buffer(
          uint8_t write_flags,
          libcerror_error_t **error );
 
+int libfdata_stream_write_segment_data(
+     libfdata_internal_stream_t *internal_stream,
+     intptr_t *file_io_handle,
+     int segment_index,
+     int segment_file_index,
+     off64_t segment_offset,
+     const uint8_t *segment_data,
+     size_t segment_data_size,
+     uint32_t segment_flags,
+     uint8_t write_flags,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_flush_write_buffer(
+     libfdata_stream_t *stream,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_set_write_buffer_size(
+     libfdata_stream_t *stream,
+     size_t write_buffer_size,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_set_maximum_read_ahead_size(
+     libfdata_stream_t *stream,
+     size_t maximum_read_ahead_size,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_set_read_alignment(
+     libfdata_stream_t *stream,
+     size_t read_alignment,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_set_read_segment_data_batch_function(
+     libfdata_stream_t *stream,
+     int (*read_segment_data_batch)(
+            intptr_t *data_handle,
+            intptr_t *file_io_handle,
+            int number_of_segment_reads,
+            int *segment_indexes,
+            int *segment_file_indexes,
+            off64_t *segment_offsets,
+            uint8_t **segment_data,
+            size_t *segment_data_sizes,
+            uint32_t *segment_flags,
+            uint8_t read_flags,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
 LIBFDATA_EXTERN \
 off64_t libfdata_stream_seek_offset(
          libfdata_stream_t *stream,
@@ -355,6 +789,39 @@ int libfdata_stream_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+/* Memory usage functions
+ */
+LIBFDATA_EXTERN \
+int libfdata_stream_get_memory_usage(
+     libfdata_stream_t *stream,
+     size64_t *structure_size,
+     libcerror_error_t **error );
+
+/* IO statistics functions
+ */
+LIBFDATA_EXTERN \
+int libfdata_stream_get_io_statistics(
+     libfdata_stream_t *stream,
+     uint64_t *number_of_read_calls,
+     uint64_t *number_of_seek_calls,
+     uint64_t *number_of_segment_switches,
+     uint64_t *number_of_bytes_requested,
+     uint64_t *number_of_bytes_read,
+     uint64_t *number_of_short_reads,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_reset_io_statistics(
+     libfdata_stream_t *stream,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_stream_get_read_latency_histogram(
+     libfdata_stream_t *stream,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
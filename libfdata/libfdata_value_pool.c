@@ -0,0 +1,525 @@
+/*
+ * The element value pool functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfdata_allocator.h"
+#include "libfdata_definitions.h"
+#include "libfdata_libcerror.h"
+#include "libfdata_value_pool.h"
+
+/* Creates a value pool
+ * Make sure the value value pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_value_pool_initialize(
+     libfdata_value_pool_t **value_pool,
+     int maximum_number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_value_pool_initialize";
+
+	if( value_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid value pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_values <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of values value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*value_pool = libfdata_allocator_allocate_structure(
+	               libfdata_value_pool_t );
+
+	if( *value_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create value pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *value_pool,
+	     0,
+	     sizeof( libfdata_value_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear value pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *value_pool )->maximum_number_of_values = maximum_number_of_values;
+
+	return( 1 );
+
+on_error:
+	if( *value_pool != NULL )
+	{
+		libfdata_allocator_free(
+		 *value_pool );
+
+		*value_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a value pool
+ * The recycled values are freed, the pool itself is freed when
+ * the last of its values has been removed from the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_value_pool_free(
+     libfdata_value_pool_t **value_pool,
+     libcerror_error_t **error )
+{
+	libfdata_pooled_value_t *pooled_value = NULL;
+	static char *function                 = "libfdata_value_pool_free";
+	int result                            = 1;
+
+	if( value_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value_pool != NULL )
+	{
+		while( ( *value_pool )->recycled_values != NULL )
+		{
+			pooled_value = ( *value_pool )->recycled_values;
+
+			( *value_pool )->recycled_values = pooled_value->next_pooled_value;
+
+			if( pooled_value->free_value(
+			     &( pooled_value->value ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free recycled value.",
+				 function );
+
+				result = -1;
+			}
+			libfdata_allocator_free(
+			 pooled_value );
+		}
+		( *value_pool )->number_of_recycled_values = 0;
+
+		while( ( *value_pool )->unused_values != NULL )
+		{
+			pooled_value = ( *value_pool )->unused_values;
+
+			( *value_pool )->unused_values = pooled_value->next_pooled_value;
+
+			libfdata_allocator_free(
+			 pooled_value );
+		}
+		( *value_pool )->number_of_unused_values = 0;
+
+		if( ( *value_pool )->number_of_cached_values == 0 )
+		{
+			libfdata_allocator_free(
+			 *value_pool );
+		}
+		else
+		{
+			( *value_pool )->is_detached = 1;
+		}
+		*value_pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a recycled value
+ * The caller takes over management of the value
+ * Returns 1 if successful, 0 if no recycled value is available or -1 on error
+ */
+int libfdata_value_pool_get_recycled_value(
+     libfdata_value_pool_t *value_pool,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libfdata_pooled_value_t *pooled_value = NULL;
+	static char *function                 = "libfdata_value_pool_get_recycled_value";
+
+	if( value_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_pool->recycled_values == NULL )
+	{
+		return( 0 );
+	}
+	pooled_value = value_pool->recycled_values;
+
+	value_pool->recycled_values = pooled_value->next_pooled_value;
+	value_pool->number_of_recycled_values -= 1;
+
+	*value = pooled_value->value;
+
+	pooled_value->value             = NULL;
+	pooled_value->free_value        = NULL;
+	pooled_value->next_pooled_value = value_pool->unused_values;
+
+	value_pool->unused_values            = pooled_value;
+	value_pool->number_of_unused_values += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the memory usage of the value pool
+ * The memory usage consists of the value pool and its pooled values,
+ * not of the (recycled) values themselves
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_value_pool_get_memory_usage(
+     libfdata_value_pool_t *value_pool,
+     size64_t *memory_usage,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_value_pool_get_memory_usage";
+
+	if( value_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_usage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory usage.",
+		 function );
+
+		return( -1 );
+	}
+	*memory_usage = sizeof( libfdata_value_pool_t )
+	              + (size64_t) ( value_pool->number_of_recycled_values + value_pool->number_of_unused_values + value_pool->number_of_cached_values ) * sizeof( libfdata_pooled_value_t );
+
+	return( 1 );
+}
+
+/* Wraps a value into a pooled value that can be stored in a cache
+ * The pooled value must be freed with libfdata_pooled_value_free
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_value_pool_wrap_value(
+     libfdata_value_pool_t *value_pool,
+     intptr_t *value,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libfdata_pooled_value_t **pooled_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_value_pool_wrap_value";
+
+	if( value_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & 0xfe ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
+	if( ( ( flags & LIBFDATA_FLAG_DATA_MANAGED ) != 0 )
+	 && ( free_value == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid free value function.",
+		 function );
+
+		return( -1 );
+	}
+	if( pooled_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pooled value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pooled_value != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pooled value value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_pool->unused_values != NULL )
+	{
+		*pooled_value = value_pool->unused_values;
+
+		value_pool->unused_values            = ( *pooled_value )->next_pooled_value;
+		value_pool->number_of_unused_values -= 1;
+	}
+	else
+	{
+		*pooled_value = libfdata_allocator_allocate_structure(
+		                 libfdata_pooled_value_t );
+
+		if( *pooled_value == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create pooled value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	( *pooled_value )->value_pool        = value_pool;
+	( *pooled_value )->value             = value;
+	( *pooled_value )->next_pooled_value = NULL;
+
+	if( ( flags & LIBFDATA_FLAG_DATA_MANAGED ) != 0 )
+	{
+		( *pooled_value )->free_value = free_value;
+	}
+	else
+	{
+		( *pooled_value )->free_value = NULL;
+	}
+	value_pool->number_of_cached_values += 1;
+
+	return( 1 );
+}
+
+/* Frees a pooled value
+ * A managed value is recycled if the pool has room for it
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_pooled_value_free(
+     libfdata_pooled_value_t **pooled_value,
+     libcerror_error_t **error )
+{
+	libfdata_value_pool_t *value_pool = NULL;
+	static char *function             = "libfdata_pooled_value_free";
+	int result                        = 1;
+
+	if( pooled_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pooled value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pooled_value == NULL )
+	{
+		return( 1 );
+	}
+	value_pool = ( *pooled_value )->value_pool;
+
+	value_pool->number_of_cached_values -= 1;
+
+	if( ( value_pool->is_detached == 0 )
+	 && ( ( *pooled_value )->free_value != NULL )
+	 && ( value_pool->number_of_recycled_values < value_pool->maximum_number_of_values ) )
+	{
+		( *pooled_value )->next_pooled_value = value_pool->recycled_values;
+
+		value_pool->recycled_values            = *pooled_value;
+		value_pool->number_of_recycled_values += 1;
+
+		*pooled_value = NULL;
+
+		return( 1 );
+	}
+	if( ( *pooled_value )->free_value != NULL )
+	{
+		if( ( *pooled_value )->free_value(
+		     &( ( *pooled_value )->value ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free value.",
+			 function );
+
+			result = -1;
+		}
+	}
+	( *pooled_value )->value      = NULL;
+	( *pooled_value )->free_value = NULL;
+
+	if( ( value_pool->is_detached == 0 )
+	 && ( value_pool->number_of_unused_values < value_pool->maximum_number_of_values ) )
+	{
+		( *pooled_value )->next_pooled_value = value_pool->unused_values;
+
+		value_pool->unused_values            = *pooled_value;
+		value_pool->number_of_unused_values += 1;
+	}
+	else
+	{
+		libfdata_allocator_free(
+		 *pooled_value );
+	}
+	*pooled_value = NULL;
+
+	if( ( value_pool->is_detached != 0 )
+	 && ( value_pool->number_of_cached_values == 0 ) )
+	{
+		libfdata_allocator_free(
+		 value_pool );
+	}
+	return( result );
+}
+
+/* Retrieves the value of a pooled value
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_pooled_value_get_value(
+     libfdata_pooled_value_t *pooled_value,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libfdata_pooled_value_get_value";
+
+	if( pooled_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pooled value.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	*value = pooled_value->value;
+
+	return( 1 );
+}
+
@@ -0,0 +1,133 @@
+/*
+ * The element value pool functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFDATA_VALUE_POOL_H )
+#define _LIBFDATA_VALUE_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfdata_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfdata_value_pool libfdata_value_pool_t;
+typedef struct libfdata_pooled_value libfdata_pooled_value_t;
+
+struct libfdata_pooled_value
+{
+	/* The value pool
+	 */
+	libfdata_value_pool_t *value_pool;
+
+	/* The value
+	 */
+	intptr_t *value;
+
+	/* The free value function
+	 * or NULL if the value is not managed
+	 */
+	int (*free_value)(
+	       intptr_t **value,
+	       libcerror_error_t **error );
+
+	/* The next pooled value
+	 */
+	libfdata_pooled_value_t *next_pooled_value;
+};
+
+struct libfdata_value_pool
+{
+	/* The maximum number of (recycled) values
+	 */
+	int maximum_number_of_values;
+
+	/* The recycled values
+	 */
+	libfdata_pooled_value_t *recycled_values;
+
+	/* The number of recycled values
+	 */
+	int number_of_recycled_values;
+
+	/* The unused pooled values
+	 */
+	libfdata_pooled_value_t *unused_values;
+
+	/* The number of unused pooled values
+	 */
+	int number_of_unused_values;
+
+	/* The number of pooled values stored in a cache
+	 */
+	int number_of_cached_values;
+
+	/* Value to indicate the pool was freed by its owner
+	 */
+	uint8_t is_detached;
+};
+
+int libfdata_value_pool_initialize(
+     libfdata_value_pool_t **value_pool,
+     int maximum_number_of_values,
+     libcerror_error_t **error );
+
+int libfdata_value_pool_free(
+     libfdata_value_pool_t **value_pool,
+     libcerror_error_t **error );
+
+int libfdata_value_pool_get_recycled_value(
+     libfdata_value_pool_t *value_pool,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libfdata_value_pool_get_memory_usage(
+     libfdata_value_pool_t *value_pool,
+     size64_t *memory_usage,
+     libcerror_error_t **error );
+
+int libfdata_value_pool_wrap_value(
+     libfdata_value_pool_t *value_pool,
+     intptr_t *value,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libfdata_pooled_value_t **pooled_value,
+     libcerror_error_t **error );
+
+int libfdata_pooled_value_free(
+     libfdata_pooled_value_t **pooled_value,
+     libcerror_error_t **error );
+
+int libfdata_pooled_value_get_value(
+     libfdata_pooled_value_t *pooled_value,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFDATA_VALUE_POOL_H ) */
+
@@ -23,16 +23,22 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfdata_allocator.h"
+#include "libfdata_cache.h"
 #include "libfdata_definitions.h"
+#include "libfdata_latency_histogram.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libcnotify.h"
 #include "libfdata_libfcache.h"
 #include "libfdata_mapped_range.h"
+#include "libfdata_notify.h"
 #include "libfdata_range.h"
 #include "libfdata_segments_array.h"
+#include "libfdata_segments_table.h"
 #include "libfdata_types.h"
 #include "libfdata_unused.h"
+#include "libfdata_value_pool.h"
 #include "libfdata_vector.h"
 
 /* Creates a vector
@@ -118,7 +124,7 @@ int libfdata_vector_initialize(
 
 		return( -1 );
 	}
-	internal_vector = memory_allocate_structure(
+	internal_vector = libfdata_allocator_allocate_structure(
 	                   libfdata_internal_vector_t );
 
 	if( internal_vector == NULL )
@@ -144,40 +150,25 @@ int libfdata_vector_initialize(
 		 "%s: unable to clear vector.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_vector );
 
 		return( -1 );
 	}
-	if( libcdata_array_initialize(
-	     &( internal_vector->segments_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segments array.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcdata_array_initialize(
-	     &( internal_vector->mapped_ranges_array ),
-	     0,
+	if( libfdata_segments_table_initialize(
+	     &( internal_vector->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create mapped ranges array.",
+		 "%s: unable to create segments table.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_date_time_get_timestamp(
+	if( libfdata_cache_get_timestamp(
 	     &( internal_vector->timestamp ),
 	     error ) != 1 )
 	{
@@ -190,13 +181,27 @@ int libfdata_vector_initialize(
 
 		goto on_error;
 	}
-	internal_vector->element_data_size  = element_data_size;
-	internal_vector->flags             |= flags;
-	internal_vector->data_handle        = data_handle;
-	internal_vector->free_data_handle   = free_data_handle;
-	internal_vector->clone_data_handle  = clone_data_handle;
-	internal_vector->read_element_data  = read_element_data;
-	internal_vector->write_element_data = write_element_data;
+	internal_vector->element_data_size            = element_data_size;
+	internal_vector->number_of_elements_per_block = 1;
+	internal_vector->flags                       |= flags;
+	internal_vector->data_handle                  = data_handle;
+	internal_vector->free_data_handle             = free_data_handle;
+	internal_vector->clone_data_handle            = clone_data_handle;
+	internal_vector->read_element_data            = read_element_data;
+	internal_vector->write_element_data           = write_element_data;
+
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR,
+		 LIBFDATA_WORKLOAD_CALL_INITIALIZE,
+		 (intptr_t *) internal_vector,
+		 0,
+		 0,
+		 0,
+		 element_data_size,
+		 0 );
+	}
 
 	*vector = (libfdata_vector_t *) internal_vector;
 
@@ -205,21 +210,13 @@ int libfdata_vector_initialize(
 on_error:
 	if( internal_vector != NULL )
 	{
-		if( internal_vector->mapped_ranges_array != NULL )
-		{
-			libcdata_array_free(
-			 &( internal_vector->mapped_ranges_array ),
-			 NULL,
-			 NULL );
-		}
-		if( internal_vector->segments_array != NULL )
+		if( internal_vector->segments_table != NULL )
 		{
-			libcdata_array_free(
-			 &( internal_vector->segments_array ),
-			 NULL,
+			libfdata_segments_table_free(
+			 &( internal_vector->segments_table ),
 			 NULL );
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_vector );
 	}
 	return( -1 );
@@ -252,33 +249,47 @@ int libfdata_vector_free(
 		internal_vector = (libfdata_internal_vector_t *) *vector;
 		*vector         = NULL;
 
-		if( libcdata_array_free(
-		     &( internal_vector->segments_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
+		if( libfdata_notify_workload_function != NULL )
+		{
+			libfdata_notify_workload(
+			 LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR,
+			 LIBFDATA_WORKLOAD_CALL_FREE,
+			 (intptr_t *) internal_vector,
+			 0,
+			 0,
+			 0,
+			 0,
+			 0 );
+		}
+
+		if( libfdata_segments_table_free(
+		     &( internal_vector->segments_table ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the segments array.",
+			 "%s: unable to free the segments table.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_array_free(
-		     &( internal_vector->mapped_ranges_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-		     error ) != 1 )
+		if( internal_vector->element_value_pool != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the mapped ranges array.",
-			 function );
+			if( libfdata_value_pool_free(
+			     &( internal_vector->element_value_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free element value pool.",
+				 function );
 
-			result = -1;
+				result = -1;
+			}
 		}
 		if( ( internal_vector->flags & LIBFDATA_DATA_HANDLE_FLAG_MANAGED ) != 0 )
 		{
@@ -310,7 +321,7 @@ int libfdata_vector_free(
 				}
 			}
 		}
-		memory_free(
+		libfdata_allocator_free(
 		 internal_vector );
 	}
 	return( result );
@@ -358,7 +369,7 @@ int libfdata_vector_clone(
 	}
 	internal_source_vector = (libfdata_internal_vector_t *) source_vector;
 
-	internal_destination_vector = memory_allocate_structure(
+	internal_destination_vector = libfdata_allocator_allocate_structure(
 	                               libfdata_internal_vector_t );
 
 	if( internal_destination_vector == NULL )
@@ -384,7 +395,7 @@ int libfdata_vector_clone(
 		 "%s: unable to clear destination vector.",
 		 function );
 
-		memory_free(
+		libfdata_allocator_free(
 		 internal_destination_vector );
 
 		return( -1 );
@@ -428,46 +439,93 @@ int libfdata_vector_clone(
 			goto on_error;
 		}
 	}
-	if( libcdata_array_clone(
-	     &( internal_destination_vector->segments_array ),
-	     internal_source_vector->segments_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_range_clone,
-	     error ) != 1 )
+	if( ( internal_source_vector->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination segments array.",
-		 function );
+		/* Calculate the mapped ranges before the segments table is shared
+		 */
+		if( libfdata_segments_table_make_writable(
+		     &( internal_source_vector->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( libfdata_segments_array_calculate_mapped_ranges(
+		     internal_source_vector->segments_table->segments_array,
+		     internal_source_vector->segments_table->mapped_ranges_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate mapped ranges.",
+			 function );
+
+			goto on_error;
+		}
+		internal_source_vector->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
 	}
-	if( libcdata_array_clone(
-	     &( internal_destination_vector->mapped_ranges_array ),
-	     internal_source_vector->mapped_ranges_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfdata_mapped_range_clone,
+	if( libfdata_segments_table_reference(
+	     &( internal_destination_vector->segments_table ),
+	     internal_source_vector->segments_table,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination mapped ranges array.",
+		 "%s: unable to reference source segments table.",
 		 function );
 
 		goto on_error;
 	}
-	internal_destination_vector->element_data_size  = internal_source_vector->element_data_size;
-	internal_destination_vector->timestamp          = internal_source_vector->timestamp;
-	internal_destination_vector->flags              = internal_source_vector->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
-	internal_destination_vector->data_handle        = internal_source_vector->data_handle;
-	internal_destination_vector->free_data_handle   = internal_source_vector->free_data_handle;
-	internal_destination_vector->clone_data_handle  = internal_source_vector->clone_data_handle;
-	internal_destination_vector->read_element_data  = internal_source_vector->read_element_data;
-	internal_destination_vector->write_element_data = internal_source_vector->write_element_data;
+	if( internal_source_vector->element_value_pool != NULL )
+	{
+		if( libfdata_value_pool_initialize(
+		     &( internal_destination_vector->element_value_pool ),
+		     internal_source_vector->element_value_pool->maximum_number_of_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination element value pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_destination_vector->element_data_size            = internal_source_vector->element_data_size;
+	internal_destination_vector->timestamp                    = internal_source_vector->timestamp;
+	internal_destination_vector->number_of_elements_per_block = internal_source_vector->number_of_elements_per_block;
+	internal_destination_vector->element_value_size           = internal_source_vector->element_value_size;
+	internal_destination_vector->flags                        = internal_source_vector->flags | LIBFDATA_DATA_HANDLE_FLAG_MANAGED;
+	internal_destination_vector->data_handle                  = internal_source_vector->data_handle;
+	internal_destination_vector->free_data_handle             = internal_source_vector->free_data_handle;
+	internal_destination_vector->clone_data_handle            = internal_source_vector->clone_data_handle;
+	internal_destination_vector->read_element_data            = internal_source_vector->read_element_data;
+	internal_destination_vector->write_element_data           = internal_source_vector->write_element_data;
+
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR,
+		 LIBFDATA_WORKLOAD_CALL_CLONE,
+		 (intptr_t *) internal_destination_vector,
+		 0,
+		 0,
+		 (off64_t) (intptr_t) source_vector,
+		 0,
+		 0 );
+	}
 
 	*destination_vector = (libfdata_vector_t *) internal_destination_vector;
 
@@ -476,13 +534,6 @@ int libfdata_vector_clone(
 on_error:
 	if( internal_destination_vector != NULL )
 	{
-		if( internal_destination_vector->segments_array != NULL )
-		{
-			libcdata_array_free(
-			 &( internal_destination_vector->segments_array ),
-			 (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
-			 NULL );
-		}
 		if( ( internal_destination_vector->data_handle != NULL )
 		 && ( internal_source_vector->free_data_handle != NULL ) )
 		{
@@ -490,7 +541,13 @@ on_error:
 			 &( internal_destination_vector->data_handle ),
 			 NULL );
 		}
-		memory_free(
+		if( internal_destination_vector->segments_table != NULL )
+		{
+			libfdata_segments_table_free(
+			 &( internal_destination_vector->segments_table ),
+			 NULL );
+		}
+		libfdata_allocator_free(
 		 internal_destination_vector );
 	}
 	return( -1 );
@@ -522,30 +579,28 @@ int libfdata_vector_empty(
 	}
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
-	if( libcdata_array_empty(
-	     internal_vector->segments_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
+	if( libfdata_segments_table_make_writable(
+	     &( internal_vector->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty segments array.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_vector->mapped_ranges_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
+	if( libfdata_segments_table_empty(
+	     internal_vector->segments_table,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty mapped ranges array.",
+		 "%s: unable to empty segments table.",
 		 function );
 
 		return( -1 );
@@ -579,32 +634,29 @@ int libfdata_vector_resize(
 	}
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
-	if( libcdata_array_resize(
-	     internal_vector->segments_array,
-	     number_of_segments,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_range_free,
+	if( libfdata_segments_table_make_writable(
+	     &( internal_vector->segments_table ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize segments array.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_resize(
-	     internal_vector->mapped_ranges_array,
+	if( libfdata_segments_table_resize(
+	     internal_vector->segments_table,
 	     number_of_segments,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_mapped_range_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to resize mapped ranges array.",
+		 "%s: unable to resize segments table.",
 		 function );
 
 		return( -1 );
@@ -639,7 +691,7 @@ int libfdata_vector_get_number_of_segments(
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
 	if( libcdata_array_get_number_of_entries(
-	     internal_vector->segments_array,
+	     internal_vector->segments_table->segments_array,
 	     number_of_segments,
 	     error ) != 1 )
 	{
@@ -684,7 +736,7 @@ int libfdata_vector_get_segment_by_index(
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
 	if( libfdata_segments_array_get_segment_by_index(
-	     internal_vector->segments_array,
+	     internal_vector->segments_table->segments_array,
 	     segment_index,
 	     segment_file_index,
 	     segment_offset,
@@ -733,9 +785,24 @@ int libfdata_vector_set_segment_by_index(
 	}
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
+	if( libfdata_segments_table_make_writable(
+	     &( internal_vector->segments_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_segments_array_set_segment_by_index(
-	     internal_vector->segments_array,
-	     internal_vector->mapped_ranges_array,
+	     internal_vector->segments_table->segments_array,
+	     internal_vector->segments_table->mapped_ranges_array,
+	     internal_vector->segments_table->segments_arena,
+	     internal_vector->segments_table->mapped_ranges_arena,
 	     &( internal_vector->size ),
 	     segment_index,
 	     segment_file_index,
@@ -786,9 +853,24 @@ int libfdata_vector_prepend_segment(
 	}
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
+	if( libfdata_segments_table_make_writable(
+	     &( internal_vector->segments_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_segments_array_prepend_segment(
-	     internal_vector->segments_array,
-	     internal_vector->mapped_ranges_array,
+	     internal_vector->segments_table->segments_array,
+	     internal_vector->segments_table->mapped_ranges_array,
+	     internal_vector->segments_table->segments_arena,
+	     internal_vector->segments_table->mapped_ranges_arena,
 	     &( internal_vector->size ),
 	     segment_file_index,
 	     segment_offset,
@@ -838,9 +920,24 @@ int libfdata_vector_append_segment(
 	}
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
+	if( libfdata_segments_table_make_writable(
+	     &( internal_vector->segments_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to make segments table writable.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_segments_array_append_segment(
-	     internal_vector->segments_array,
-	     internal_vector->mapped_ranges_array,
+	     internal_vector->segments_table->segments_array,
+	     internal_vector->segments_table->mapped_ranges_array,
+	     internal_vector->segments_table->segments_arena,
+	     internal_vector->segments_table->mapped_ranges_arena,
 	     &( internal_vector->size ),
 	     segment_index,
 	     segment_file_index,
@@ -858,6 +955,18 @@ int libfdata_vector_append_segment(
 
 		return( -1 );
 	}
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR,
+		 LIBFDATA_WORKLOAD_CALL_APPEND_SEGMENT,
+		 (intptr_t *) internal_vector,
+		 *segment_index,
+		 segment_file_index,
+		 segment_offset,
+		 segment_size,
+		 0 );
+	}
 	return( 1 );
 }
 
@@ -973,39 +1082,31 @@ int libfdata_vector_get_number_of_elements(
 	return( 1 );
 }
 
-/* Mapped range functions
- */
-
-/* Retrieves the element index for a specific offset
+/* Sets the number of elements per block
+ *
+ * In block mode the read element data function is called for a block of
+ * contiguous elements, with the index and data offset of the first element
+ * of the block and the data size of all the elements in the block. The value
+ * it sets must contain the values of these elements consecutively, each of
+ * element value size bytes. Elements that cannot be read as part of a block,
+ * for example a block that spans multiple segments, are read as a block of
+ * a single element.
+ *
+ * A number of elements per block of 1 disables block mode.
+ *
+ * Element values cached before the number of elements per block was set
+ * are no longer used.
+ *
  * Returns 1 if successful or -1 on error
  */
-int libfdata_vector_get_element_index_at_offset(
+int libfdata_vector_set_number_of_elements_per_block(
      libfdata_vector_t *vector,
-     off64_t element_value_offset,
-     int *element_index,
-     off64_t *element_data_offset,
+     int number_of_elements_per_block,
+     size_t element_value_size,
      libcerror_error_t **error )
 {
 	libfdata_internal_vector_t *internal_vector = NULL;
-	libfdata_mapped_range_t *mapped_range       = NULL;
-	static char *function                       = "libfdata_vector_get_element_index_at_offset";
-	off64_t mapped_range_end_offset             = 0;
-	off64_t mapped_range_start_offset           = 0;
-	off64_t segment_data_offset                 = 0;
-	size64_t mapped_range_size                  = 0;
-	uint64_t calculated_element_index           = 0;
-	int initial_segment_index                   = 0;
-	int number_of_segments                      = 0;
-	int segment_index                           = 0;
-	int result                                  = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	libfdata_range_t *segment_data_range        = NULL;
-	off64_t segment_offset                      = 0;
-	size64_t segment_size                       = 0;
-	uint32_t segment_flags                      = 0;
-	int segment_file_index                      = -1;
-#endif
+	static char *function                       = "libfdata_vector_set_number_of_elements_per_block";
 
 	if( vector == NULL )
 	{
@@ -1020,6 +1121,82 @@ int libfdata_vector_get_element_index_at_offset(
 	}
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
+	if( number_of_elements_per_block <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of elements per block value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( element_value_size == 0 )
+	 || ( element_value_size > ( (size_t) SSIZE_MAX / number_of_elements_per_block ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element value size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure element values cached with a different block layout are not retrieved
+	 */
+	if( libfdata_cache_get_timestamp(
+	     &( internal_vector->timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	internal_vector->number_of_elements_per_block = number_of_elements_per_block;
+	internal_vector->element_value_size           = element_value_size;
+
+	return( 1 );
+}
+
+/* Retrieves the block that contains a specific element
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_get_element_block(
+     libfdata_internal_vector_t *internal_vector,
+     int element_index,
+     int *block_element_index,
+     int *number_of_block_elements,
+     int *block_data_file_index,
+     off64_t *block_data_offset,
+     uint32_t *block_data_flags,
+     libcerror_error_t **error )
+{
+	libfdata_range_t *segment_data_range = NULL;
+	static char *function                = "libfdata_vector_get_element_block";
+	off64_t element_data_offset          = 0;
+	off64_t segment_data_offset          = 0;
+	size64_t block_data_size             = 0;
+	int safe_block_element_index         = 0;
+	int safe_number_of_block_elements    = 0;
+
+	if( internal_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_vector->element_data_size == 0 )
 	{
 		libcerror_error_set(
@@ -1031,7 +1208,8 @@ int libfdata_vector_get_element_index_at_offset(
 
 		return( -1 );
 	}
-	if( internal_vector->size == 0 )
+	if( ( internal_vector->size == 0 )
+	 || ( internal_vector->size > (off64_t) INT64_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -1042,87 +1220,366 @@ int libfdata_vector_get_element_index_at_offset(
 
 		return( -1 );
 	}
-	if( element_value_offset < 0 )
+	if( ( element_index < 0 )
+	 || ( (uint64_t) element_index > ( (uint64_t) INT64_MAX / internal_vector->element_data_size ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
-		 "%s: invalid element value offset value less than zero.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( element_index == NULL )
+	if( block_element_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element index.",
+		 "%s: invalid block element index.",
 		 function );
 
 		return( -1 );
 	}
-	if( element_data_offset == NULL )
+	if( number_of_block_elements == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid element data offset.",
+		 "%s: invalid number of block elements.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_vector->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
-	{
-		if( libfdata_segments_array_calculate_mapped_ranges(
-		     internal_vector->segments_array,
-		     internal_vector->mapped_ranges_array,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to calculate mapped ranges from segments array.",
-			 function );
-
-			return( -1 );
-		}
-		internal_vector->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: requested offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-		 function,
-		 element_value_offset,
-		 element_value_offset );
-	}
-#endif
-	if( internal_vector->size == 0 )
-	{
-		return( 0 );
-	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_vector->mapped_ranges_array,
-	     &number_of_segments,
-	     error ) != 1 )
+	if( block_data_file_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from mapped ranges array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block data file index.",
 		 function );
 
 		return( -1 );
 	}
-	/* This assumes a fairly even distribution of the sizes of the segments
-	 */
+	if( block_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_data_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block data flags.",
+		 function );
+
+		return( -1 );
+	}
+	element_data_offset = (off64_t) ( element_index * internal_vector->element_data_size );
+
+	if( (size64_t) element_data_offset > internal_vector->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_vector->number_of_elements_per_block > 1 )
+	{
+		safe_block_element_index = element_index - ( element_index % internal_vector->number_of_elements_per_block );
+		element_data_offset      = (off64_t) ( safe_block_element_index * internal_vector->element_data_size );
+
+		/* The last block only contains the remaining complete elements
+		 */
+		block_data_size = ( internal_vector->size - element_data_offset ) / internal_vector->element_data_size;
+
+		if( block_data_size > (size64_t) internal_vector->number_of_elements_per_block )
+		{
+			block_data_size = (size64_t) internal_vector->number_of_elements_per_block;
+		}
+		safe_number_of_block_elements = (int) block_data_size;
+		block_data_size              *= internal_vector->element_data_size;
+
+		if( element_index < ( safe_block_element_index + safe_number_of_block_elements ) )
+		{
+			if( libfdata_segments_array_get_data_range_at_offset(
+			     internal_vector->segments_table->segments_array,
+			     element_data_offset,
+			     &segment_data_offset,
+			     &segment_data_range,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment data range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 element_data_offset,
+				 element_data_offset );
+
+				return( -1 );
+			}
+			/* The elements of a block must be stored contiguously in a single segment
+			 */
+			if( ( segment_data_range != NULL )
+			 && ( ( (size64_t) segment_data_offset > segment_data_range->size )
+			  || ( block_data_size > ( segment_data_range->size - segment_data_offset ) ) ) )
+			{
+				segment_data_range = NULL;
+			}
+		}
+		if( segment_data_range == NULL )
+		{
+			element_data_offset = (off64_t) ( element_index * internal_vector->element_data_size );
+		}
+	}
+	if( segment_data_range == NULL )
+	{
+		safe_block_element_index      = element_index;
+		safe_number_of_block_elements = 1;
+
+		if( libfdata_segments_array_get_data_range_at_offset(
+		     internal_vector->segments_table->segments_array,
+		     element_data_offset,
+		     &segment_data_offset,
+		     &segment_data_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment data range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 element_data_offset,
+			 element_data_offset );
+
+			return( -1 );
+		}
+		if( segment_data_range == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment data range.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( segment_data_range->offset > ( (off64_t) INT64_MAX - segment_data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*block_element_index      = safe_block_element_index;
+	*number_of_block_elements = safe_number_of_block_elements;
+	*block_data_file_index    = segment_data_range->file_index;
+	*block_data_offset        = segment_data_range->offset + segment_data_offset;
+	*block_data_flags         = segment_data_range->flags;
+
+	return( 1 );
+}
+
+/* Mapped range functions
+ */
+
+/* Retrieves the element index for a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_get_element_index_at_offset(
+     libfdata_vector_t *vector,
+     off64_t element_value_offset,
+     int *element_index,
+     off64_t *element_data_offset,
+     libcerror_error_t **error )
+{
+	libfdata_internal_vector_t *internal_vector = NULL;
+	libfdata_mapped_range_t *mapped_range       = NULL;
+	static char *function                       = "libfdata_vector_get_element_index_at_offset";
+	off64_t mapped_range_end_offset             = 0;
+	off64_t mapped_range_start_offset           = 0;
+	off64_t segment_data_offset                 = 0;
+	size64_t mapped_range_size                  = 0;
+	uint64_t calculated_element_index           = 0;
+	int initial_segment_index                   = 0;
+	int number_of_segments                      = 0;
+	int segment_index                           = 0;
+	int result                                  = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	libfdata_range_t *segment_data_range        = NULL;
+	off64_t segment_offset                      = 0;
+	size64_t segment_size                       = 0;
+	uint32_t segment_flags                      = 0;
+	int segment_file_index                      = -1;
+#endif
+
+	if( vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	internal_vector = (libfdata_internal_vector_t *) vector;
+
+	if( internal_vector->element_data_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid vector - element data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_vector->size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid vector - size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_value_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid element value offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element index.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_vector->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
+	{
+		if( libfdata_segments_table_make_writable(
+		     &( internal_vector->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfdata_segments_array_calculate_mapped_ranges(
+		     internal_vector->segments_table->segments_array,
+		     internal_vector->segments_table->mapped_ranges_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate mapped ranges from segments array.",
+			 function );
+
+			return( -1 );
+		}
+		internal_vector->flags &= ~( LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES );
+	}
+	if( libfdata_notify_workload_function != NULL )
+	{
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR,
+		 LIBFDATA_WORKLOAD_CALL_GET_ELEMENT_INDEX_AT_OFFSET,
+		 (intptr_t *) internal_vector,
+		 0,
+		 0,
+		 element_value_offset,
+		 0,
+		 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: requested offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 element_value_offset,
+		 element_value_offset );
+	}
+#endif
+	if( internal_vector->size == 0 )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_vector->segments_table->mapped_ranges_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from mapped ranges array.",
+		 function );
+
+		return( -1 );
+	}
+	/* This assumes a fairly even distribution of the sizes of the segments
+	 */
 	initial_segment_index = (int) ( ( number_of_segments * element_value_offset ) / internal_vector->size );
 
 	/* Look for the corresponding segment upwards in the array
@@ -1132,7 +1589,7 @@ int libfdata_vector_get_element_index_at_offset(
 	     segment_index++ )
 	{
 		if( libcdata_array_get_entry_by_index(
-		     internal_vector->mapped_ranges_array,
+		     internal_vector->segments_table->mapped_ranges_array,
 		     segment_index,
 		     (intptr_t **) &mapped_range,
 		     error ) != 1 )
@@ -1216,7 +1673,7 @@ int libfdata_vector_get_element_index_at_offset(
 		     segment_index-- )
 		{
 			if( libcdata_array_get_entry_by_index(
-			     internal_vector->mapped_ranges_array,
+			     internal_vector->segments_table->mapped_ranges_array,
 			     segment_index,
 			     (intptr_t **) &mapped_range,
 			     error ) != 1 )
@@ -1300,7 +1757,7 @@ int libfdata_vector_get_element_index_at_offset(
 		if( libcnotify_verbose != 0 )
 		{
 			if( libcdata_array_get_entry_by_index(
-			     internal_vector->segments_array,
+			     internal_vector->segments_table->segments_array,
 			     segment_index,
 			     (intptr_t **) &segment_data_range,
 			     error ) != 1 )
@@ -1392,17 +1849,29 @@ int libfdata_vector_get_element_value_by_index(
      libcerror_error_t **error )
 {
 	libfcache_cache_value_t *cache_value        = NULL;
+	libfdata_cache_t *parent_read_cache         = NULL;
 	libfdata_internal_vector_t *internal_vector = NULL;
-	libfdata_range_t *segment_data_range        = NULL;
+	intptr_t *read_element_value                = NULL;
 	static char *function                       = "libfdata_vector_get_element_value_by_index";
 	off64_t cache_value_offset                  = (off64_t) -1;
 	off64_t element_data_offset                 = 0;
+	size64_t element_data_size                  = 0;
 	int64_t cache_value_timestamp               = 0;
+	int64_t store_sequence_number               = 0;
+	int64_t trace_timestamp                     = 0;
 	uint32_t element_data_flags                 = 0;
+	int block_element_index                     = 0;
 	int cache_value_file_index                  = -1;
 	int element_data_file_index                 = -1;
+	int number_of_block_elements                = 0;
+	int parent_read_element_index               = 0;
+	int read_result                             = 0;
 	int result                                  = 0;
 
+#if defined( HAVE_IO_STATISTICS )
+	int64_t read_timestamp                      = 0;
+#endif
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	const char *hit_or_miss                     = NULL;
 #endif
@@ -1431,97 +1900,50 @@ int libfdata_vector_get_element_value_by_index(
 
 		return( -1 );
 	}
-	if( internal_vector->element_data_size == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid vector - element data size value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( internal_vector->size == 0 )
-	 || ( internal_vector->size > (off64_t) INT64_MAX ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid vector - size value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( element_index < 0 )
-	 || ( (uint64_t) element_index > ( (uint64_t) INT64_MAX / internal_vector->element_data_size ) ) )
+	if( element_value == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid element index value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
 		 function );
 
 		return( -1 );
 	}
-	element_data_offset = (off64_t) ( element_index * internal_vector->element_data_size );
-
-	if( (size64_t) element_data_offset > internal_vector->size )
+	if( libfdata_notify_workload_function != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid element index value out of bounds.",
-		 function );
-
-		return( -1 );
+		libfdata_notify_workload(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR,
+		 LIBFDATA_WORKLOAD_CALL_GET_ELEMENT_VALUE_BY_INDEX,
+		 (intptr_t *) internal_vector,
+		 element_index,
+		 0,
+		 0,
+		 0,
+		 read_flags );
 	}
-	if( libfdata_segments_array_get_data_range_at_offset(
-	     internal_vector->segments_array,
-	     element_data_offset,
+	if( libfdata_vector_get_element_block(
+	     internal_vector,
+	     element_index,
+	     &block_element_index,
+	     &number_of_block_elements,
+	     &element_data_file_index,
 	     &element_data_offset,
-	     &segment_data_range,
+	     &element_data_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment data range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to retrieve block of element: %d.",
 		 function,
-		 element_data_offset,
-		 element_data_offset );
-
-		return( -1 );
-	}
-	if( segment_data_range == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing segment data range.",
-		 function );
-
-		return( -1 );
-	}
-	if( segment_data_range->offset > ( (off64_t) INT64_MAX - element_data_offset ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid element data offset value out of bounds.",
-		 function );
+		 element_index );
 
 		return( -1 );
 	}
-	element_data_file_index = segment_data_range->file_index;
-	element_data_offset    += segment_data_range->offset;
-	element_data_flags      = segment_data_range->flags;
+	element_data_size = (size64_t) number_of_block_elements * internal_vector->element_data_size;
 
 	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
 	{
@@ -1563,6 +1985,19 @@ int libfdata_vector_get_element_value_by_index(
 		}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 	}
+	if( ( result != 0 )
+	 && ( libfdata_notify_trace_function != NULL ) )
+	{
+		libfdata_notify_trace(
+		 LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR,
+		 LIBFDATA_TRACE_OPERATION_READ,
+		 block_element_index,
+		 element_data_file_index,
+		 element_data_offset,
+		 element_data_size,
+		 LIBFDATA_TRACE_RECORD_FLAG_CACHE_HIT,
+		 0 );
+	}
 	if( result == 0 )
 	{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -1573,21 +2008,70 @@ int libfdata_vector_get_element_value_by_index(
 			 function,
 			 element_data_offset,
 			 element_data_offset,
-			 internal_vector->element_data_size );
+			 element_data_size );
 		}
 #endif
-		if( internal_vector->read_element_data(
-		     internal_vector->data_handle,
-		     file_io_handle,
-		     vector,
-		     cache,
-		     element_index,
-		     element_data_file_index,
-		     element_data_offset,
-		     internal_vector->element_data_size,
-		     element_data_flags,
-		     read_flags,
-		     error ) != 1 )
+		/* Track the element that is being read so that the value stored
+		 * by the read element data function can be returned directly
+		 */
+		parent_read_cache         = internal_vector->read_cache;
+		parent_read_element_index = internal_vector->read_element_index;
+
+		internal_vector->read_cache         = cache;
+		internal_vector->read_element_index = block_element_index;
+		internal_vector->read_element_value = NULL;
+
+		if( libfdata_notify_trace_function != NULL )
+		{
+			libfdata_notify_trace_get_timestamp(
+			 &trace_timestamp );
+		}
+#if defined( HAVE_IO_STATISTICS )
+		libfdata_latency_histogram_get_timestamp(
+		 &read_timestamp );
+#endif
+		read_result = internal_vector->read_element_data(
+		               internal_vector->data_handle,
+		               file_io_handle,
+		               vector,
+		               cache,
+		               block_element_index,
+		               element_data_file_index,
+		               element_data_offset,
+		               element_data_size,
+		               element_data_flags,
+		               read_flags,
+		               error );
+
+#if defined( HAVE_IO_STATISTICS )
+		libfdata_latency_histogram_record(
+		 internal_vector->read_latency_histogram,
+		 read_timestamp );
+#endif
+
+		read_element_value = internal_vector->read_element_value;
+
+		/* Any value stored in or cleared from a cache after the value of the element,
+		 * including by another container that shares the cache, could have evicted it
+		 */
+		if( read_element_value != NULL )
+		{
+			libfdata_cache_get_store_sequence_number(
+			 &store_sequence_number );
+
+			if( store_sequence_number != internal_vector->read_element_store_sequence_number )
+			{
+				read_element_value = NULL;
+			}
+		}
+
+		/* A nested read could have evicted the value of the parent read
+		 */
+		internal_vector->read_cache         = parent_read_cache;
+		internal_vector->read_element_index = parent_read_element_index;
+		internal_vector->read_element_value = NULL;
+
+		if( read_result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1600,66 +2084,112 @@ int libfdata_vector_get_element_value_by_index(
 
 			return( -1 );
 		}
-		if( libfcache_cache_get_value_by_identifier(
-		     (libfcache_cache_t *) cache,
-		     element_data_file_index,
-		     element_data_offset,
-		     internal_vector->timestamp,
-		     &cache_value,
-		     error ) != 1 )
+		if( libfdata_notify_trace_function != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
-			 function );
+			libfdata_notify_trace(
+			 LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR,
+			 LIBFDATA_TRACE_OPERATION_READ,
+			 block_element_index,
+			 element_data_file_index,
+			 element_data_offset,
+			 element_data_size,
+			 0,
+			 trace_timestamp );
+		}
+		if( read_element_value == NULL )
+		{
+			if( libfcache_cache_get_value_by_identifier(
+			     (libfcache_cache_t *) cache,
+			     element_data_file_index,
+			     element_data_offset,
+			     internal_vector->timestamp,
+			     &cache_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from cache.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
+			if( libfcache_cache_value_get_identifier(
+			     cache_value,
+			     &cache_value_file_index,
+			     &cache_value_offset,
+			     &cache_value_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value identifier.",
+				 function );
+
+				return( -1 );
+			}
+			if( ( element_data_file_index != cache_value_file_index )
+			 || ( element_data_offset != cache_value_offset )
+			 || ( internal_vector->timestamp != cache_value_timestamp ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid cache value - identifier value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
 		}
-		if( libfcache_cache_value_get_identifier(
+	}
+	if( read_element_value != NULL )
+	{
+		*element_value = read_element_value;
+	}
+	else
+	{
+		if( libfcache_cache_value_get_value(
 		     cache_value,
-		     &cache_value_file_index,
-		     &cache_value_offset,
-		     &cache_value_timestamp,
+		     element_value,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache value identifier.",
+			 "%s: unable to retrieve element value.",
 			 function );
 
 			return( -1 );
 		}
-		if( ( element_data_file_index != cache_value_file_index )
-		 || ( element_data_offset != cache_value_offset )
-		 || ( internal_vector->timestamp != cache_value_timestamp ) )
+		if( internal_vector->element_value_pool != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid cache value - identifier value out of bounds.",
-			 function );
+			if( libfdata_pooled_value_get_value(
+			     (libfdata_pooled_value_t *) *element_value,
+			     element_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element value from pooled value.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
 		}
 	}
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     element_value,
-	     error ) != 1 )
+	/* The value of an element in a block is stored at a fixed stride in the block value
+	 */
+	if( ( *element_value != NULL )
+	 && ( element_index > block_element_index ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element value.",
-		 function );
-
-		return( -1 );
+		*element_value = (intptr_t *) &( ( (uint8_t *) *element_value )[ (size_t) ( element_index - block_element_index ) * internal_vector->element_value_size ] );
 	}
 	return( 1 );
 }
@@ -1726,6 +2256,9 @@ int libfdata_vector_get_element_value_at_offset(
  * takes over management of the value and the value is freed when
  * no longer needed.
  *
+ * In block mode the value is that of the block that contains the element,
+ * see libfdata_vector_set_number_of_elements_per_block.
+ *
  * Returns 1 if successful or -1 on error
  */
 int libfdata_vector_set_element_value_by_index(
@@ -1741,9 +2274,14 @@ int libfdata_vector_set_element_value_by_index(
      libcerror_error_t **error )
 {
 	libfdata_internal_vector_t *internal_vector = NULL;
-	libfdata_range_t *segment_data_range        = NULL;
+	libfdata_pooled_value_t *pooled_value       = NULL;
 	static char *function                       = "libfdata_vector_set_element_value_by_index";
 	off64_t element_data_offset                 = 0;
+	int64_t store_sequence_number               = 0;
+	uint32_t element_data_flags                 = 0;
+	int block_element_index                     = 0;
+	int element_data_file_index                 = -1;
+	int number_of_block_elements                = 0;
 
 	LIBFDATA_UNREFERENCED_PARAMETER( file_io_handle )
 
@@ -1760,115 +2298,307 @@ int libfdata_vector_set_element_value_by_index(
 	}
 	internal_vector = (libfdata_internal_vector_t *) vector;
 
-	if( internal_vector->element_data_size == 0 )
+	if( libfdata_vector_get_element_block(
+	     internal_vector,
+	     element_index,
+	     &block_element_index,
+	     &number_of_block_elements,
+	     &element_data_file_index,
+	     &element_data_offset,
+	     &element_data_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid vector - element data size value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block of element: %d.",
+		 function,
+		 element_index );
+
+		return( -1 );
+	}
+	if( internal_vector->element_value_pool == NULL )
+	{
+		if( libfcache_cache_set_value_by_identifier(
+		     (libfcache_cache_t *) cache,
+		     element_data_file_index,
+		     element_data_offset,
+		     internal_vector->timestamp,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libfdata_value_pool_wrap_value(
+		     internal_vector->element_value_pool,
+		     element_value,
+		     free_element_value,
+		     write_flags,
+		     &pooled_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create pooled value.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfcache_cache_set_value_by_identifier(
+		     (libfcache_cache_t *) cache,
+		     element_data_file_index,
+		     element_data_offset,
+		     internal_vector->timestamp,
+		     (intptr_t *) pooled_value,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfdata_pooled_value_free,
+		     LIBFDATA_VECTOR_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache.",
+			 function );
+
+			/* The caller retains management of the element value on error
+			 */
+			pooled_value->free_value = NULL;
+
+			libfdata_pooled_value_free(
+			 &pooled_value,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	libfdata_cache_increment_store_sequence_number(
+	 &store_sequence_number );
+
+	/* Any other value stored in the cache while an element is being read
+	 * could evict the value of the element that is being read
+	 */
+	if( ( internal_vector->read_cache == cache )
+	 && ( internal_vector->read_element_index == block_element_index ) )
+	{
+		internal_vector->read_element_value                 = element_value;
+		internal_vector->read_element_store_sequence_number = store_sequence_number;
+	}
+	else
+	{
+		internal_vector->read_element_value = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the element value pool
+ *
+ * Managed element values that are removed from the cache are kept in the pool,
+ * up to the maximum number of values, and can be reused by the read element
+ * data function, see libfdata_vector_get_recycled_element_value.
+ *
+ * Element values cached before the pool was set are no longer used.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_set_element_value_pool(
+     libfdata_vector_t *vector,
+     int maximum_number_of_values,
+     libcerror_error_t **error )
+{
+	libfdata_internal_vector_t *internal_vector = NULL;
+	static char *function                       = "libfdata_vector_set_element_value_pool";
+
+	if( vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_vector->size == 0 )
-	 || ( internal_vector->size > (off64_t) INT64_MAX ) )
+	internal_vector = (libfdata_internal_vector_t *) vector;
+
+	if( internal_vector->element_value_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid vector - size value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid vector - element value pool value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( element_index < 0 )
-	 || ( (uint64_t) element_index > ( (uint64_t) INT64_MAX / internal_vector->element_data_size ) ) )
+	if( libfdata_value_pool_initialize(
+	     &( internal_vector->element_value_pool ),
+	     maximum_number_of_values,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid element index value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create element value pool.",
 		 function );
 
 		return( -1 );
 	}
-	element_data_offset = (off64_t) ( element_index * internal_vector->element_data_size );
+	/* Make sure element values cached without the pool are not retrieved
+	 */
+	if( libfdata_cache_get_timestamp(
+	     &( internal_vector->timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
+		 function );
 
-	if( (size64_t) element_data_offset > internal_vector->size )
+		libfdata_value_pool_free(
+		 &( internal_vector->element_value_pool ),
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a recycled element value
+ * The caller takes over management of the element value, which is normally
+ * passed back to libfdata_vector_set_element_value_by_index
+ * Returns 1 if successful, 0 if no recycled element value is available or -1 on error
+ */
+int libfdata_vector_get_recycled_element_value(
+     libfdata_vector_t *vector,
+     intptr_t **element_value,
+     libcerror_error_t **error )
+{
+	libfdata_internal_vector_t *internal_vector = NULL;
+	static char *function                       = "libfdata_vector_get_recycled_element_value";
+	int result                                  = 0;
+
+	if( vector == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid element index value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfdata_segments_array_get_data_range_at_offset(
-	     internal_vector->segments_array,
-	     element_data_offset,
-	     &element_data_offset,
-	     &segment_data_range,
-	     error ) != 1 )
+	internal_vector = (libfdata_internal_vector_t *) vector;
+
+	if( element_value == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment data range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 element_data_offset,
-		 element_data_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
 
 		return( -1 );
 	}
-	if( segment_data_range == NULL )
+	if( internal_vector->element_value_pool == NULL )
+	{
+		return( 0 );
+	}
+	result = libfdata_value_pool_get_recycled_value(
+	          internal_vector->element_value_pool,
+	          element_value,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing segment data range.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve recycled element value.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_data_range->offset > ( (off64_t) INT64_MAX - element_data_offset ) )
+	return( result );
+}
+
+/* Invalidates the cached element values that overlap with a specific range
+ * This allows to retain the other cached element values after the data
+ * in the range was changed
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_invalidate_cached_range(
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_vector_t *internal_vector = NULL;
+	static char *function                       = "libfdata_vector_invalidate_cached_range";
+	size64_t value_data_size                    = 0;
+
+	if( vector == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid element data offset value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
 		 function );
 
 		return( -1 );
 	}
-	element_data_offset += segment_data_range->offset;
+	internal_vector = (libfdata_internal_vector_t *) vector;
 
-	if( libfcache_cache_set_value_by_identifier(
-	     (libfcache_cache_t *) cache,
-	     segment_data_range->file_index,
-	     element_data_offset,
+	value_data_size = (size64_t) internal_vector->number_of_elements_per_block * internal_vector->element_data_size;
+
+	if( libfdata_cache_clear_values_in_range(
+	     cache,
+	     file_index,
+	     offset,
+	     size,
 	     internal_vector->timestamp,
-	     element_value,
-	     free_element_value,
-	     write_flags,
+	     value_data_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set value in cache.",
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to clear cached element values in range.",
 		 function );
 
 		return( -1 );
 	}
+	/* The value of an element that is being read could have been cleared
+	 */
+	internal_vector->read_element_value = NULL;
+
 	return( 1 );
 }
 
@@ -1909,9 +2639,22 @@ int libfdata_vector_get_size(
 	}
 	if( ( internal_vector->flags & LIBFDATA_FLAG_CALCULATE_MAPPED_RANGES ) != 0 )
 	{
+		if( libfdata_segments_table_make_writable(
+		     &( internal_vector->segments_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to make segments table writable.",
+			 function );
+
+			return( -1 );
+		}
 		if( libfdata_segments_array_calculate_mapped_ranges(
-		     internal_vector->segments_array,
-		     internal_vector->mapped_ranges_array,
+		     internal_vector->segments_table->segments_array,
+		     internal_vector->segments_table->mapped_ranges_array,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1930,3 +2673,208 @@ int libfdata_vector_get_size(
 	return( 1 );
 }
 
+/* Memory usage functions
+ */
+
+/* Retrieves the memory usage
+ * The structure size contains the size of the vector, its segments, mapped ranges
+ * and element value pool. The cached values size contains an estimate of the size
+ * of the element values of the vector stored in the cache, based on the element data size or, if elements are read per block, the element value size.
+ * The cache is optional, without a cache the cached values size is 0
+ * Returns 1 if successful or -1 on error
+ */
+int libfdata_vector_get_memory_usage(
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     size64_t *structure_size,
+     size64_t *cached_values_size,
+     libcerror_error_t **error )
+{
+	libfdata_internal_vector_t *internal_vector = NULL;
+	static char *function                       = "libfdata_vector_get_memory_usage";
+	size64_t memory_usage                       = 0;
+	size64_t safe_cached_values_size            = 0;
+	size64_t safe_structure_size                = 0;
+	size64_t value_size                         = 0;
+	int number_of_values                        = 0;
+
+	if( vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( structure_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid structure size.",
+		 function );
+
+		return( -1 );
+	}
+	if( cached_values_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cached values size.",
+		 function );
+
+		return( -1 );
+	}
+	internal_vector = (libfdata_internal_vector_t *) vector;
+
+	if( libfdata_segments_table_get_memory_usage(
+	     internal_vector->segments_table,
+	     &memory_usage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory usage of segments.",
+		 function );
+
+		return( -1 );
+	}
+	safe_structure_size = sizeof( libfdata_internal_vector_t ) + memory_usage;
+
+	if( internal_vector->element_value_pool != NULL )
+	{
+		if( libfdata_value_pool_get_memory_usage(
+		     internal_vector->element_value_pool,
+		     &memory_usage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve memory usage of element value pool.",
+			 function );
+
+			return( -1 );
+		}
+		safe_structure_size += memory_usage;
+	}
+	if( cache != NULL )
+	{
+		if( libfdata_cache_get_number_of_values_by_timestamp(
+		     cache,
+		     internal_vector->timestamp,
+		     &number_of_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of cached values.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_vector->number_of_elements_per_block > 1 )
+		{
+			value_size = (size64_t) internal_vector->element_value_size * internal_vector->number_of_elements_per_block;
+		}
+		else
+		{
+			value_size = internal_vector->element_data_size;
+		}
+		safe_cached_values_size = (size64_t) number_of_values * value_size;
+	}
+	*structure_size     = safe_structure_size;
+	*cached_values_size = safe_cached_values_size;
+
+	return( 1 );
+}
+
+/* IO statistics functions
+ */
+
+/* Retrieves the read latency histogram
+ * The histogram contains the number of read element data function calls per latency bucket,
+ * where bucket N contains the latencies of at least 2^(N-1) and less than 2^N nanoseconds
+ * and bucket 0 the latencies of 0. The latencies are measured with a monotonic clock.
+ * The histogram is only maintained when the library was built with IO statistics support
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfdata_vector_get_read_latency_histogram(
+     libfdata_vector_t *vector,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_IO_STATISTICS )
+	libfdata_internal_vector_t *internal_vector = NULL;
+#endif
+	static char *function                       = "libfdata_vector_get_read_latency_histogram";
+
+	if( vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of buckets value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_IO_STATISTICS )
+	internal_vector = (libfdata_internal_vector_t *) vector;
+
+	if( libfdata_latency_histogram_get_buckets(
+	     internal_vector->read_latency_histogram,
+	     histogram,
+	     number_of_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read latency histogram.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
@@ -25,11 +25,14 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfdata_definitions.h"
 #include "libfdata_extern.h"
 #include "libfdata_libcdata.h"
 #include "libfdata_libcerror.h"
 #include "libfdata_libfcache.h"
+#include "libfdata_segments_table.h"
 #include "libfdata_types.h"
+#include "libfdata_value_pool.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -47,18 +50,49 @@ struct libfdata_internal_vector
 	 */
 	size64_t size;
 
-	/* The segments array
+	/* The segments table, which can be shared with clones
 	 */
-	libcdata_array_t *segments_array;
-
-	/* The mapped ranges array
-	 */
-	libcdata_array_t *mapped_ranges_array;
+	libfdata_segments_table_t *segments_table;
 
 	/* The timestamp
 	 */
 	int64_t timestamp;
 
+	/* The cache of the element that is being read
+	 * or NULL if no element is being read
+	 */
+	libfdata_cache_t *read_cache;
+
+	/* The index of the element that is being read
+	 */
+	int read_element_index;
+
+	/* The element value set by the read element data function
+	 */
+	intptr_t *read_element_value;
+
+	/* The store sequence number after the read element value was stored
+	 */
+	int64_t read_element_store_sequence_number;
+
+	/* The element value pool
+	 */
+	libfdata_value_pool_t *element_value_pool;
+
+	/* The number of elements per block
+	 */
+	int number_of_elements_per_block;
+
+	/* The size of the value of an element in a block
+	 */
+	size_t element_value_size;
+
+#if defined( HAVE_IO_STATISTICS )
+	/* The read latency histogram
+	 */
+	uint64_t read_latency_histogram[ LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+#endif
+
 	/* The flags
 	 */
 	uint8_t flags;
@@ -233,6 +267,23 @@ int libfdata_vector_get_number_of_elements(
      int *number_of_elements,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_vector_set_number_of_elements_per_block(
+     libfdata_vector_t *vector,
+     int number_of_elements_per_block,
+     size_t element_value_size,
+     libcerror_error_t **error );
+
+int libfdata_vector_get_element_block(
+     libfdata_internal_vector_t *internal_vector,
+     int element_index,
+     int *block_element_index,
+     int *number_of_block_elements,
+     int *block_data_file_index,
+     off64_t *block_data_offset,
+     uint32_t *block_data_flags,
+     libcerror_error_t **error );
+
 /* Mapped range functions
  */
 LIBFDATA_EXTERN \
@@ -279,6 +330,27 @@ int libfdata_vector_set_element_value_by_index(
      uint8_t write_flags,
      libcerror_error_t **error );
 
+LIBFDATA_EXTERN \
+int libfdata_vector_set_element_value_pool(
+     libfdata_vector_t *vector,
+     int maximum_number_of_values,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_vector_get_recycled_element_value(
+     libfdata_vector_t *vector,
+     intptr_t **element_value,
+     libcerror_error_t **error );
+
+LIBFDATA_EXTERN \
+int libfdata_vector_invalidate_cached_range(
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
 /* IO functions
  */
 LIBFDATA_EXTERN \
@@ -287,6 +359,25 @@ int libfdata_vector_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+/* Memory usage functions
+ */
+LIBFDATA_EXTERN \
+int libfdata_vector_get_memory_usage(
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     size64_t *structure_size,
+     size64_t *cached_values_size,
+     libcerror_error_t **error );
+
+/* IO statistics functions
+ */
+LIBFDATA_EXTERN \
+int libfdata_vector_get_read_latency_histogram(
+     libfdata_vector_t *vector,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
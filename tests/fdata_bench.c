@@ -0,0 +1,505 @@
+/*
+ * Benchmark functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if !defined( WINAPI )
+#include <time.h>
+#endif
+
+#include "fdata_bench.h"
+#include "fdata_test_libcerror.h"
+#include "fdata_test_unused.h"
+
+/* Creates a data handle with synthetic data
+ * Make sure the value data_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_data_handle_initialize(
+     fdata_bench_data_handle_t **data_handle,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_data_handle_initialize";
+	size_t data_offset    = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*data_handle = memory_allocate_structure(
+	                fdata_bench_data_handle_t );
+
+	if( *data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *data_handle )->data = (uint8_t *) memory_allocate(
+	                                      sizeof( uint8_t ) * data_size );
+
+	if( ( *data_handle )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		( *data_handle )->data[ data_offset ] = (uint8_t) ( data_offset & 0xff );
+	}
+	( *data_handle )->data_size      = data_size;
+	( *data_handle )->current_offset = 0;
+
+	return( 1 );
+
+on_error:
+	if( *data_handle != NULL )
+	{
+		memory_free(
+		 *data_handle );
+
+		*data_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a data handle
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_data_handle_free(
+     fdata_bench_data_handle_t **data_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_data_handle_free";
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_handle != NULL )
+	{
+		memory_free(
+		 ( *data_handle )->data );
+
+		memory_free(
+		 *data_handle );
+
+		*data_handle = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads segment data
+ * Callback function for the stream
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t fdata_bench_data_handle_read_segment_data(
+         fdata_bench_data_handle_t *data_handle,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         uint32_t segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_data_handle_read_segment_data";
+	size_t read_size      = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) data_handle->current_offset >= data_handle->data_size )
+	{
+		return( 0 );
+	}
+	read_size = data_handle->data_size - (size_t) data_handle->current_offset;
+
+	if( read_size > segment_data_size )
+	{
+		read_size = segment_data_size;
+	}
+	if( memory_copy(
+	     segment_data,
+	     &( data_handle->data[ data_handle->current_offset ] ),
+	     read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy segment data.",
+		 function );
+
+		return( -1 );
+	}
+	data_handle->current_offset += (off64_t) read_size;
+
+	return( (ssize_t) read_size );
+}
+
+/* Seeks a certain segment offset
+ * Callback function for the stream
+ * Returns the offset or -1 on error
+ */
+off64_t fdata_bench_data_handle_seek_segment_offset(
+         fdata_bench_data_handle_t *data_handle,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         off64_t segment_offset,
+         libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_data_handle_seek_segment_offset";
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid segment offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	data_handle->current_offset = segment_offset;
+
+	return( segment_offset );
+}
+
+/* Copies element data into a newly allocated element value
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_data_handle_copy_element_data(
+     fdata_bench_data_handle_t *data_handle,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint8_t **element_value,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_data_handle_copy_element_data";
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( element_data_offset < 0 )
+	 || ( (size64_t) element_data_offset > data_handle->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( element_data_size == 0 )
+	 || ( element_data_size > ( data_handle->data_size - (size_t) element_data_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
+	*element_value = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * (size_t) element_data_size );
+
+	if( *element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     *element_value,
+	     &( data_handle->data[ element_data_offset ] ),
+	     (size_t) element_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy element data.",
+		 function );
+
+		memory_free(
+		 *element_value );
+
+		*element_value = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Frees an element value
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_element_value_free(
+     uint8_t **element_value,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_element_value_free";
+
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *element_value != NULL )
+	{
+		memory_free(
+		 *element_value );
+
+		*element_value = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves a 30-bit pseudo random value
+ * A fixed seed makes the access pattern reproducible between runs
+ * Returns the random value
+ */
+uint32_t fdata_bench_get_random_value(
+          uint32_t *seed )
+{
+	uint32_t random_value = 0;
+
+	*seed        = ( *seed * 1103515245UL ) + 12345UL;
+	random_value = ( *seed >> 16 ) & 0x7fffUL;
+
+	*seed        = ( *seed * 1103515245UL ) + 12345UL;
+	random_value = ( random_value << 15 ) | ( ( *seed >> 16 ) & 0x7fffUL );
+
+	return( random_value );
+}
+
+/* Retrieves the current time of a monotonic clock in nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_get_time(
+     uint64_t *nanoseconds )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+#endif
+
+	if( nanoseconds == NULL )
+	{
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		return( -1 );
+	}
+	*nanoseconds = (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0 ) / (double) frequency.QuadPart );
+
+#elif defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( -1 );
+	}
+	*nanoseconds = ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec;
+
+#else
+	*nanoseconds = (uint64_t) ( ( (double) clock() * 1000000000.0 ) / (double) CLOCKS_PER_SEC );
+#endif
+
+	return( 1 );
+}
+
+/* Prints the header of the benchmark results
+ * The results are printed as tab separated values
+ */
+void fdata_bench_print_header(
+      void )
+{
+	fprintf(
+	 stdout,
+	 "# benchmark\tnumber_of_elements\tnumber_of_operations\tnanoseconds\tnanoseconds_per_operation\n" );
+}
+
+/* Prints the result of a benchmark
+ */
+void fdata_bench_print_result(
+      const char *benchmark_name,
+      int number_of_elements,
+      int number_of_operations,
+      uint64_t start_time,
+      uint64_t end_time )
+{
+	uint64_t elapsed_time = 0;
+
+	if( end_time > start_time )
+	{
+		elapsed_time = end_time - start_time;
+	}
+	fprintf(
+	 stdout,
+	 "%s\t%d\t%d\t%" PRIu64 "\t%.1f\n",
+	 benchmark_name,
+	 number_of_elements,
+	 number_of_operations,
+	 elapsed_time,
+	 ( number_of_operations > 0 ) ? (double) elapsed_time / (double) number_of_operations : 0.0 );
+}
+
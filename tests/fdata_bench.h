@@ -0,0 +1,128 @@
+/*
+ * Benchmark functions
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _FDATA_BENCH_H )
+#define _FDATA_BENCH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "fdata_test_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of lookup operations per benchmark
+ */
+#define FDATA_BENCH_NUMBER_OF_OPERATIONS	65536
+
+/* The number of cache entries
+ */
+#define FDATA_BENCH_NUMBER_OF_CACHE_ENTRIES	256
+
+/* The number of elements accessed by the cache hit benchmarks,
+ * which must be less than the number of cache entries
+ */
+#define FDATA_BENCH_NUMBER_OF_HOT_ELEMENTS	128
+
+/* The random seed
+ */
+#define FDATA_BENCH_RANDOM_SEED			0x5eed1234UL
+
+typedef struct fdata_bench_data_handle fdata_bench_data_handle_t;
+
+struct fdata_bench_data_handle
+{
+	/* The (synthetic) data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+};
+
+int fdata_bench_data_handle_initialize(
+     fdata_bench_data_handle_t **data_handle,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int fdata_bench_data_handle_free(
+     fdata_bench_data_handle_t **data_handle,
+     libcerror_error_t **error );
+
+ssize_t fdata_bench_data_handle_read_segment_data(
+         fdata_bench_data_handle_t *data_handle,
+         intptr_t *file_io_handle,
+         int segment_index,
+         int segment_file_index,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         uint32_t segment_flags,
+         uint8_t read_flags,
+         libcerror_error_t **error );
+
+off64_t fdata_bench_data_handle_seek_segment_offset(
+         fdata_bench_data_handle_t *data_handle,
+         intptr_t *file_io_handle,
+         int segment_index,
+         int segment_file_index,
+         off64_t segment_offset,
+         libcerror_error_t **error );
+
+int fdata_bench_data_handle_copy_element_data(
+     fdata_bench_data_handle_t *data_handle,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint8_t **element_value,
+     libcerror_error_t **error );
+
+int fdata_bench_element_value_free(
+     uint8_t **element_value,
+     libcerror_error_t **error );
+
+uint32_t fdata_bench_get_random_value(
+          uint32_t *seed );
+
+int fdata_bench_get_time(
+     uint64_t *nanoseconds );
+
+void fdata_bench_print_header(
+      void );
+
+void fdata_bench_print_result(
+      const char *benchmark_name,
+      int number_of_elements,
+      int number_of_operations,
+      uint64_t start_time,
+      uint64_t end_time );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _FDATA_BENCH_H ) */
+
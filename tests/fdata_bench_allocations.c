@@ -0,0 +1,745 @@
+/*
+ * Library allocations benchmark program
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fdata_test_libcerror.h"
+#include "fdata_test_libfdata.h"
+#include "fdata_test_memory.h"
+#include "fdata_test_unused.h"
+
+#if defined( HAVE_FDATA_TEST_MEMORY )
+
+/* The element data size
+ */
+#define FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE	512
+
+/* Prints the header of the benchmark results
+ * The results are printed as tab separated values
+ */
+void fdata_bench_allocations_print_header(
+      void )
+{
+	fprintf(
+	 stdout,
+	 "# benchmark\tnumber_of_elements\tnumber_of_allocations\tallocations_per_element\tnumber_of_reallocations\treallocations_per_element\tallocated_size\tallocated_size_per_element\tpeak_live_size\n" );
+}
+
+/* Prints the result of a benchmark
+ */
+void fdata_bench_allocations_print_result(
+      const char *benchmark_name,
+      int number_of_elements,
+      fdata_test_memory_statistics_t *statistics )
+{
+	double divisor = 1.0;
+
+	if( number_of_elements > 0 )
+	{
+		divisor = (double) number_of_elements;
+	}
+	fprintf(
+	 stdout,
+	 "%s\t%d\t%" PRIu64 "\t%.2f\t%" PRIu64 "\t%.2f\t%" PRIu64 "\t%.1f\t%" PRIu64 "\n",
+	 benchmark_name,
+	 number_of_elements,
+	 statistics->number_of_allocations,
+	 (double) statistics->number_of_allocations / divisor,
+	 statistics->number_of_reallocations,
+	 (double) statistics->number_of_reallocations / divisor,
+	 statistics->allocated_size,
+	 (double) statistics->allocated_size / divisor,
+	 statistics->peak_live_size );
+}
+
+/* Benchmarks the allocations of appending elements to a list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_allocations_list_append_element(
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	fdata_test_memory_statistics_t statistics;
+
+	libfdata_list_t *list  = NULL;
+	static char *function  = "fdata_bench_allocations_list_append_element";
+	int element_index      = 0;
+	int list_element_index = 0;
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_memory_statistics_start();
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_list_append_element(
+		     list,
+		     &list_element_index,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	fdata_test_memory_statistics_stop(
+	 &statistics );
+
+	fdata_bench_allocations_print_result(
+	 "list_append_element",
+	 number_of_elements,
+	 &statistics );
+
+	if( libfdata_list_free(
+	     &list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	fdata_test_memory_statistics_stop(
+	 NULL );
+
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the allocations of appending elements with a mapped size to a list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_allocations_list_append_element_with_mapped_size(
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	fdata_test_memory_statistics_t statistics;
+
+	libfdata_list_t *list  = NULL;
+	static char *function  = "fdata_bench_allocations_list_append_element_with_mapped_size";
+	int element_index      = 0;
+	int list_element_index = 0;
+
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_memory_statistics_start();
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_list_append_element_with_mapped_size(
+		     list,
+		     &list_element_index,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     0,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	fdata_test_memory_statistics_stop(
+	 &statistics );
+
+	fdata_bench_allocations_print_result(
+	 "list_append_element_with_mapped_size",
+	 number_of_elements,
+	 &statistics );
+
+	if( libfdata_list_free(
+	     &list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	fdata_test_memory_statistics_stop(
+	 NULL );
+
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the allocations of inserting adjacent elements into a range list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_allocations_range_list_insert_element(
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	fdata_test_memory_statistics_t statistics;
+
+	libfdata_range_list_t *range_list = NULL;
+	static char *function             = "fdata_bench_allocations_range_list_insert_element";
+	int element_index                 = 0;
+
+	if( libfdata_range_list_initialize(
+	     &range_list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create range list.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_memory_statistics_start();
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_range_list_insert_element(
+		     range_list,
+		     (off64_t) element_index * FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert element: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	fdata_test_memory_statistics_stop(
+	 &statistics );
+
+	fdata_bench_allocations_print_result(
+	 "range_list_insert_element",
+	 number_of_elements,
+	 &statistics );
+
+	if( libfdata_range_list_free(
+	     &range_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free range list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	fdata_test_memory_statistics_stop(
+	 NULL );
+
+	if( range_list != NULL )
+	{
+		libfdata_range_list_free(
+		 &range_list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the allocations of inserting non-adjacent elements into a range list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_allocations_range_list_insert_sparse_element(
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	fdata_test_memory_statistics_t statistics;
+
+	libfdata_range_list_t *range_list = NULL;
+	static char *function             = "fdata_bench_allocations_range_list_insert_sparse_element";
+	int element_index                 = 0;
+
+	if( libfdata_range_list_initialize(
+	     &range_list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create range list.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_memory_statistics_start();
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_range_list_insert_element(
+		     range_list,
+		     (off64_t) element_index * 2 * FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert element: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	fdata_test_memory_statistics_stop(
+	 &statistics );
+
+	fdata_bench_allocations_print_result(
+	 "range_list_insert_sparse_element",
+	 number_of_elements,
+	 &statistics );
+
+	if( libfdata_range_list_free(
+	     &range_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free range list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	fdata_test_memory_statistics_stop(
+	 NULL );
+
+	if( range_list != NULL )
+	{
+		libfdata_range_list_free(
+		 &range_list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the allocations of appending segments to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_allocations_stream_append_segment(
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	fdata_test_memory_statistics_t statistics;
+
+	libfdata_stream_t *stream = NULL;
+	static char *function     = "fdata_bench_allocations_stream_append_segment";
+	int element_index         = 0;
+	int segment_index         = 0;
+
+	if( libfdata_stream_initialize(
+	     &stream,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stream.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_memory_statistics_start();
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_stream_append_segment(
+		     stream,
+		     &segment_index,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	fdata_test_memory_statistics_stop(
+	 &statistics );
+
+	fdata_bench_allocations_print_result(
+	 "stream_append_segment",
+	 number_of_elements,
+	 &statistics );
+
+	if( libfdata_stream_free(
+	     &stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stream.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	fdata_test_memory_statistics_stop(
+	 NULL );
+
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the allocations of appending segments to a vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_allocations_vector_append_segment(
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	fdata_test_memory_statistics_t statistics;
+
+	libfdata_vector_t *vector = NULL;
+	static char *function     = "fdata_bench_allocations_vector_append_segment";
+	int element_index         = 0;
+	int segment_index         = 0;
+
+	if( libfdata_vector_initialize(
+	     &vector,
+	     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create vector.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_test_memory_statistics_start();
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_vector_append_segment(
+		     vector,
+		     &segment_index,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_ALLOCATIONS_ELEMENT_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	fdata_test_memory_statistics_stop(
+	 &statistics );
+
+	fdata_bench_allocations_print_result(
+	 "vector_append_segment",
+	 number_of_elements,
+	 &statistics );
+
+	if( libfdata_vector_free(
+	     &vector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free vector.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	fdata_test_memory_statistics_stop(
+	 NULL );
+
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_FDATA_TEST_MEMORY ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( HAVE_FDATA_TEST_MEMORY )
+	int number_of_elements_values[ 2 ] = { 1024, 16384 };
+
+	libcerror_error_t *error            = NULL;
+	int number_of_elements              = 0;
+	int value_index                     = 0;
+#endif
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( argc )
+	FDATA_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_FDATA_TEST_MEMORY )
+	fdata_bench_allocations_print_header();
+
+	for( value_index = 0;
+	     value_index < 2;
+	     value_index++ )
+	{
+		number_of_elements = number_of_elements_values[ value_index ];
+
+		if( fdata_bench_allocations_list_append_element(
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_allocations_list_append_element_with_mapped_size(
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_allocations_range_list_insert_element(
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_allocations_range_list_insert_sparse_element(
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_allocations_stream_append_segment(
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_allocations_vector_append_segment(
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+#else
+	fprintf(
+	 stdout,
+	 "# allocation statistics are not supported on this platform\n" );
+#endif
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_FDATA_TEST_MEMORY )
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+#endif
+}
+
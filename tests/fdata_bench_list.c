@@ -0,0 +1,618 @@
+/*
+ * Library list type benchmark program
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fdata_bench.h"
+#include "fdata_test_libcerror.h"
+#include "fdata_test_libfdata.h"
+#include "fdata_test_unused.h"
+
+/* The element data size
+ */
+#define FDATA_BENCH_LIST_ELEMENT_DATA_SIZE	512
+
+/* Reads element data
+ * Callback function for the list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_list_read_element_data(
+     fdata_bench_data_handle_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_list_element_t *list_element,
+     libfdata_cache_t *cache,
+     int element_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint8_t *element_value = NULL;
+	static char *function  = "fdata_bench_list_read_element_data";
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+
+	if( fdata_bench_data_handle_copy_element_data(
+	     data_handle,
+	     element_data_offset,
+	     element_data_size,
+	     &element_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to copy element data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_element_set_element_value(
+	     list_element,
+	     file_io_handle,
+	     cache,
+	     (intptr_t *) element_value,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &fdata_bench_element_value_free,
+	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set element value.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( element_value != NULL )
+	{
+		memory_free(
+		 element_value );
+	}
+	return( -1 );
+}
+
+/* Creates a list with a specific number of elements
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_list_initialize(
+     libfdata_list_t **list,
+     fdata_bench_data_handle_t *data_handle,
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	static char *function  = "fdata_bench_list_initialize";
+	int element_index      = 0;
+	int list_element_index = 0;
+
+	if( libfdata_list_initialize(
+	     list,
+	     (intptr_t *) data_handle,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_bench_list_read_element_data,
+	     NULL,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		return( -1 );
+	}
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_list_append_element(
+		     *list,
+		     &list_element_index,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_LIST_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_LIST_ELEMENT_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %d.",
+			 function,
+			 element_index );
+
+			libfdata_list_free(
+			 list,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Benchmarks building a list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_list_append_element(
+     fdata_bench_data_handle_t *data_handle,
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	libfdata_list_t *list = NULL;
+	static char *function = "fdata_bench_list_append_element";
+	uint64_t end_time     = 0;
+	uint64_t start_time   = 0;
+
+	fdata_bench_get_time(
+	 &start_time );
+
+	if( fdata_bench_list_initialize(
+	     &list,
+	     data_handle,
+	     number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_bench_get_time(
+	 &end_time );
+
+	fdata_bench_print_result(
+	 "list_append_element",
+	 number_of_elements,
+	 number_of_elements,
+	 start_time,
+	 end_time );
+
+	if( libfdata_list_free(
+	     &list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks offset lookups
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_list_get_element_index_at_offset(
+     fdata_bench_data_handle_t *data_handle,
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	libfdata_list_t *list       = NULL;
+	static char *function       = "fdata_bench_list_get_element_index_at_offset";
+	off64_t element_data_offset = 0;
+	off64_t offset              = 0;
+	uint64_t end_time           = 0;
+	uint64_t start_time         = 0;
+	uint32_t random_seed        = FDATA_BENCH_RANDOM_SEED;
+	int element_index           = 0;
+	int operation_index         = 0;
+
+	if( fdata_bench_list_initialize(
+	     &list,
+	     data_handle,
+	     number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	/* The first lookup calculates the mapped ranges
+	 */
+	fdata_bench_get_time(
+	 &start_time );
+
+	if( libfdata_list_get_element_index_at_offset(
+	     list,
+	     0,
+	     &element_index,
+	     &element_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index at offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_bench_get_time(
+	 &end_time );
+
+	fdata_bench_print_result(
+	 "list_calculate_mapped_ranges",
+	 number_of_elements,
+	 1,
+	 start_time,
+	 end_time );
+
+	fdata_bench_get_time(
+	 &start_time );
+
+	for( operation_index = 0;
+	     operation_index < FDATA_BENCH_NUMBER_OF_OPERATIONS;
+	     operation_index++ )
+	{
+		offset = (off64_t) ( fdata_bench_get_random_value( &random_seed ) % ( (uint32_t) number_of_elements * FDATA_BENCH_LIST_ELEMENT_DATA_SIZE ) );
+
+		if( libfdata_list_get_element_index_at_offset(
+		     list,
+		     offset,
+		     &element_index,
+		     &element_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element index at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+	}
+	fdata_bench_get_time(
+	 &end_time );
+
+	fdata_bench_print_result(
+	 "list_get_element_index_at_offset",
+	 number_of_elements,
+	 FDATA_BENCH_NUMBER_OF_OPERATIONS,
+	 start_time,
+	 end_time );
+
+	if( libfdata_list_free(
+	     &list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks retrieving element values by index
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_list_get_element_value_by_index(
+     fdata_bench_data_handle_t *data_handle,
+     int number_of_elements,
+     libcerror_error_t **error )
+{
+	libfdata_cache_t *cache = NULL;
+	libfdata_list_t *list   = NULL;
+	intptr_t *element_value = NULL;
+	static char *function   = "fdata_bench_list_get_element_value_by_index";
+	uint64_t end_time       = 0;
+	uint64_t start_time     = 0;
+	int element_index       = 0;
+	int operation_index     = 0;
+
+	if( fdata_bench_list_initialize(
+	     &list,
+	     data_handle,
+	     number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     FDATA_BENCH_NUMBER_OF_CACHE_ENTRIES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	/* Reading all elements in sequence does not fit in the cache
+	 */
+	fdata_bench_get_time(
+	 &start_time );
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     list,
+		     NULL,
+		     cache,
+		     element_index,
+		     &element_value,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	fdata_bench_get_time(
+	 &end_time );
+
+	fdata_bench_print_result(
+	 "list_get_element_value_by_index_cache_miss",
+	 number_of_elements,
+	 number_of_elements,
+	 start_time,
+	 end_time );
+
+	/* Reading the same elements repeatedly is served by the cache
+	 */
+	fdata_bench_get_time(
+	 &start_time );
+
+	for( operation_index = 0;
+	     operation_index < FDATA_BENCH_NUMBER_OF_OPERATIONS;
+	     operation_index++ )
+	{
+		element_index = operation_index % FDATA_BENCH_NUMBER_OF_HOT_ELEMENTS;
+
+		if( libfdata_list_get_element_value_by_index(
+		     list,
+		     NULL,
+		     cache,
+		     element_index,
+		     &element_value,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	fdata_bench_get_time(
+	 &end_time );
+
+	fdata_bench_print_result(
+	 "list_get_element_value_by_index_cache_hit",
+	 number_of_elements,
+	 FDATA_BENCH_NUMBER_OF_OPERATIONS,
+	 start_time,
+	 end_time );
+
+	if( libfdata_cache_free(
+	     &cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_free(
+	     &list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	int number_of_elements_values[ 2 ]    = { 1024, 16384 };
+
+	fdata_bench_data_handle_t *data_handle = NULL;
+	libcerror_error_t *error               = NULL;
+	int number_of_elements                 = 0;
+	int value_index                        = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( argc )
+	FDATA_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fdata_bench_print_header();
+
+	for( value_index = 0;
+	     value_index < 2;
+	     value_index++ )
+	{
+		number_of_elements = number_of_elements_values[ value_index ];
+
+		if( fdata_bench_data_handle_initialize(
+		     &data_handle,
+		     (size_t) number_of_elements * FDATA_BENCH_LIST_ELEMENT_DATA_SIZE,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_list_append_element(
+		     data_handle,
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_list_get_element_index_at_offset(
+		     data_handle,
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_list_get_element_value_by_index(
+		     data_handle,
+		     number_of_elements,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_data_handle_free(
+		     &data_handle,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_handle != NULL )
+	{
+		fdata_bench_data_handle_free(
+		 &data_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1890 @@
+/*
+ * Library workload replay benchmark program
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fdata_bench.h"
+#include "fdata_test_libcerror.h"
+#include "fdata_test_libfdata.h"
+#include "fdata_test_unused.h"
+
+/* The maximum number of containers that can be replayed at the same time
+ */
+#define FDATA_BENCH_REPLAY_MAXIMUM_NUMBER_OF_CONTAINERS		1024
+
+/* The maximum size of a buffer read from a stream
+ */
+#define FDATA_BENCH_REPLAY_MAXIMUM_BUFFER_SIZE			( 1024 * 1024 )
+
+/* The maximum size of an element value
+ */
+#define FDATA_BENCH_REPLAY_MAXIMUM_ELEMENT_VALUE_SIZE		( 64 * 1024 )
+
+/* The element data size of the synthetic workload
+ */
+#define FDATA_BENCH_REPLAY_ELEMENT_DATA_SIZE			128
+
+/* The number of elements of the synthetic workload
+ */
+#define FDATA_BENCH_REPLAY_NUMBER_OF_ELEMENTS			4096
+
+/* The number of elements accessed by the synthetic workload
+ */
+#define FDATA_BENCH_REPLAY_NUMBER_OF_HOT_ELEMENTS		512
+
+/* The segment size of the synthetic workload
+ */
+#define FDATA_BENCH_REPLAY_SEGMENT_SIZE				4096
+
+/* The filename of the recording of the synthetic workload
+ */
+#define FDATA_BENCH_REPLAY_WORKLOAD_FILENAME			"fdata_bench_replay.workload"
+
+typedef struct fdata_bench_replay_container fdata_bench_replay_container_t;
+
+struct fdata_bench_replay_container
+{
+	/* The container identifier in the recording
+	 */
+	uint64_t identifier;
+
+	/* The container type
+	 */
+	uint8_t container_type;
+
+	/* The (replayed) container
+	 */
+	intptr_t *container;
+
+	/* The cache of the container
+	 */
+	libfdata_cache_t *cache;
+};
+
+typedef struct fdata_bench_replay fdata_bench_replay_t;
+
+struct fdata_bench_replay
+{
+	/* The containers
+	 */
+	fdata_bench_replay_container_t containers[ FDATA_BENCH_REPLAY_MAXIMUM_NUMBER_OF_CONTAINERS ];
+
+	/* The number of containers
+	 */
+	int number_of_containers;
+
+	/* The number of containers created during the replay
+	 */
+	int number_of_created_containers;
+
+	/* The number of cache entries of a container
+	 */
+	int number_of_cache_entries;
+
+	/* The buffer used for stream reads
+	 */
+	uint8_t *buffer;
+
+	/* The number of skipped records
+	 */
+	int number_of_skipped_records;
+};
+
+/* Reads segment data
+ * The data is synthesized, not read
+ * Callback function for the stream
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t fdata_bench_replay_read_segment_data(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         uint32_t segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_replay_read_segment_data";
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+
+	if( segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     segment_data,
+	     (int) ( segment_index & 0xff ),
+	     segment_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set segment data.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) segment_data_size );
+}
+
+/* Seeks a certain segment offset
+ * Callback function for the stream
+ * Returns the offset or -1 on error
+ */
+off64_t fdata_bench_replay_seek_segment_offset(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         off64_t segment_offset,
+         libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_replay_seek_segment_offset";
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+
+	if( segment_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid segment offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	return( segment_offset );
+}
+
+/* Creates a synthesized element value
+ * The size of the element value is limited to FDATA_BENCH_REPLAY_MAXIMUM_ELEMENT_VALUE_SIZE
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_create_element_value(
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint8_t **element_value,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_replay_create_element_value";
+	size_t value_size     = 1;
+
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_data_size > FDATA_BENCH_REPLAY_MAXIMUM_ELEMENT_VALUE_SIZE )
+	{
+		value_size = FDATA_BENCH_REPLAY_MAXIMUM_ELEMENT_VALUE_SIZE;
+	}
+	else if( element_data_size > 0 )
+	{
+		value_size = (size_t) element_data_size;
+	}
+	*element_value = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * value_size );
+
+	if( *element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *element_value,
+	     (int) ( element_data_offset & 0xff ),
+	     value_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set element value.",
+		 function );
+
+		memory_free(
+		 *element_value );
+
+		*element_value = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads element data
+ * The data is synthesized, not read
+ * Callback function for the vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_read_vector_element_data(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint8_t *element_value = NULL;
+	static char *function  = "fdata_bench_replay_read_vector_element_data";
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+
+	if( fdata_bench_replay_create_element_value(
+	     element_data_offset,
+	     element_data_size,
+	     &element_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create element value.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_set_element_value_by_index(
+	     vector,
+	     file_io_handle,
+	     cache,
+	     element_index,
+	     (intptr_t *) element_value,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &fdata_bench_element_value_free,
+	     LIBFDATA_VECTOR_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set element value: %d.",
+		 function,
+		 element_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( element_value != NULL )
+	{
+		memory_free(
+		 element_value );
+	}
+	return( -1 );
+}
+
+/* Reads element data
+ * The data is synthesized, not read
+ * Callback function for the list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_read_list_element_data(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle,
+     libfdata_list_element_t *list_element,
+     libfdata_cache_t *cache,
+     int element_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint8_t *element_value = NULL;
+	static char *function  = "fdata_bench_replay_read_list_element_data";
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+
+	if( fdata_bench_replay_create_element_value(
+	     element_data_offset,
+	     element_data_size,
+	     &element_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create element value.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_element_set_element_value(
+	     list_element,
+	     file_io_handle,
+	     cache,
+	     (intptr_t *) element_value,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &fdata_bench_element_value_free,
+	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set element value.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( element_value != NULL )
+	{
+		memory_free(
+		 element_value );
+	}
+	return( -1 );
+}
+
+/* Creates a replay
+ * Make sure the value replay is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_initialize(
+     fdata_bench_replay_t **replay,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_replay_initialize";
+
+	if( replay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay.",
+		 function );
+
+		return( -1 );
+	}
+	if( *replay != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*replay = memory_allocate_structure(
+	           fdata_bench_replay_t );
+
+	if( *replay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create replay.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *replay,
+	     0,
+	     sizeof( fdata_bench_replay_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear replay.",
+		 function );
+
+		memory_free(
+		 *replay );
+
+		*replay = NULL;
+
+		return( -1 );
+	}
+	( *replay )->buffer = (uint8_t *) memory_allocate(
+	                                   sizeof( uint8_t ) * FDATA_BENCH_REPLAY_MAXIMUM_BUFFER_SIZE );
+
+	if( ( *replay )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *replay )->number_of_cache_entries = number_of_cache_entries;
+
+	return( 1 );
+
+on_error:
+	if( *replay != NULL )
+	{
+		memory_free(
+		 *replay );
+
+		*replay = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a replayed container
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_container_free(
+     fdata_bench_replay_container_t *replay_container,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_replay_container_free";
+	int result            = 1;
+
+	if( replay_container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay container.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_container->container != NULL )
+	{
+		switch( replay_container->container_type )
+		{
+			case LIBFDATA_TRACE_CONTAINER_TYPE_LIST:
+				result = libfdata_list_free(
+				          (libfdata_list_t **) &( replay_container->container ),
+				          error );
+				break;
+
+			case LIBFDATA_TRACE_CONTAINER_TYPE_STREAM:
+				result = libfdata_stream_free(
+				          (libfdata_stream_t **) &( replay_container->container ),
+				          error );
+				break;
+
+			case LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR:
+				result = libfdata_vector_free(
+				          (libfdata_vector_t **) &( replay_container->container ),
+				          error );
+				break;
+
+			default:
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free container.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( replay_container->cache != NULL )
+	{
+		if( libfdata_cache_free(
+		     &( replay_container->cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Frees a replay
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_free(
+     fdata_bench_replay_t **replay,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_replay_free";
+	int container_index   = 0;
+	int result            = 1;
+
+	if( replay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay.",
+		 function );
+
+		return( -1 );
+	}
+	if( *replay != NULL )
+	{
+		for( container_index = 0;
+		     container_index < ( *replay )->number_of_containers;
+		     container_index++ )
+		{
+			if( fdata_bench_replay_container_free(
+			     &( ( *replay )->containers[ container_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free container: %d.",
+				 function,
+				 container_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *replay )->buffer );
+
+		memory_free(
+		 *replay );
+
+		*replay = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the replayed container of a specific identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int fdata_bench_replay_get_container(
+     fdata_bench_replay_t *replay,
+     uint64_t identifier,
+     uint8_t container_type,
+     fdata_bench_replay_container_t **replay_container,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_replay_get_container";
+	int container_index   = 0;
+
+	if( replay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay container.",
+		 function );
+
+		return( -1 );
+	}
+	/* Search backwards since recently created containers are the most likely to be used
+	 */
+	for( container_index = replay->number_of_containers - 1;
+	     container_index >= 0;
+	     container_index-- )
+	{
+		if( ( replay->containers[ container_index ].identifier == identifier )
+		 && ( replay->containers[ container_index ].container_type == container_type ) )
+		{
+			*replay_container = &( replay->containers[ container_index ] );
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Appends a replayed container
+ * Returns 1 if successful, 0 if the maximum number of containers was reached or -1 on error
+ */
+int fdata_bench_replay_append_container(
+     fdata_bench_replay_t *replay,
+     uint64_t identifier,
+     uint8_t container_type,
+     size64_t element_data_size,
+     intptr_t *source_container,
+     libcerror_error_t **error )
+{
+	fdata_bench_replay_container_t *replay_container = NULL;
+	static char *function                            = "fdata_bench_replay_append_container";
+	int result                                       = 0;
+
+	if( replay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay->number_of_containers >= FDATA_BENCH_REPLAY_MAXIMUM_NUMBER_OF_CONTAINERS )
+	{
+		return( 0 );
+	}
+	replay_container = &( replay->containers[ replay->number_of_containers ] );
+
+	replay_container->identifier     = identifier;
+	replay_container->container_type = container_type;
+	replay_container->container      = NULL;
+	replay_container->cache          = NULL;
+
+	switch( container_type )
+	{
+		case LIBFDATA_TRACE_CONTAINER_TYPE_LIST:
+			if( source_container != NULL )
+			{
+				result = libfdata_list_clone(
+				          (libfdata_list_t **) &( replay_container->container ),
+				          (libfdata_list_t *) source_container,
+				          error );
+			}
+			else
+			{
+				result = libfdata_list_initialize(
+				          (libfdata_list_t **) &( replay_container->container ),
+				          NULL,
+				          NULL,
+				          NULL,
+				          &fdata_bench_replay_read_list_element_data,
+				          NULL,
+				          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+				          error );
+			}
+			break;
+
+		case LIBFDATA_TRACE_CONTAINER_TYPE_STREAM:
+			if( source_container != NULL )
+			{
+				result = libfdata_stream_clone(
+				          (libfdata_stream_t **) &( replay_container->container ),
+				          (libfdata_stream_t *) source_container,
+				          error );
+			}
+			else
+			{
+				result = libfdata_stream_initialize(
+				          (libfdata_stream_t **) &( replay_container->container ),
+				          NULL,
+				          NULL,
+				          NULL,
+				          NULL,
+				          &fdata_bench_replay_read_segment_data,
+				          NULL,
+				          &fdata_bench_replay_seek_segment_offset,
+				          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+				          error );
+			}
+			break;
+
+		case LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR:
+			if( source_container != NULL )
+			{
+				result = libfdata_vector_clone(
+				          (libfdata_vector_t **) &( replay_container->container ),
+				          (libfdata_vector_t *) source_container,
+				          error );
+			}
+			else
+			{
+				result = libfdata_vector_initialize(
+				          (libfdata_vector_t **) &( replay_container->container ),
+				          element_data_size,
+				          NULL,
+				          NULL,
+				          NULL,
+				          &fdata_bench_replay_read_vector_element_data,
+				          NULL,
+				          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+				          error );
+			}
+			break;
+
+		default:
+			return( 0 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create container.",
+		 function );
+
+		goto on_error;
+	}
+	if( container_type != LIBFDATA_TRACE_CONTAINER_TYPE_STREAM )
+	{
+		if( libfdata_cache_initialize(
+		     &( replay_container->cache ),
+		     replay->number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	replay->number_of_containers += 1;
+	replay->number_of_created_containers += 1;
+
+	return( 1 );
+
+on_error:
+	fdata_bench_replay_container_free(
+	 replay_container,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Removes a replayed container
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_remove_container(
+     fdata_bench_replay_t *replay,
+     fdata_bench_replay_container_t *replay_container,
+     libcerror_error_t **error )
+{
+	static char *function = "fdata_bench_replay_remove_container";
+	int container_index   = 0;
+
+	if( replay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay.",
+		 function );
+
+		return( -1 );
+	}
+	if( fdata_bench_replay_container_free(
+	     replay_container,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free container.",
+		 function );
+
+		return( -1 );
+	}
+	container_index = (int) ( replay_container - replay->containers );
+
+	replay->number_of_containers -= 1;
+
+	if( container_index < replay->number_of_containers )
+	{
+		if( memory_copy(
+		     &( replay->containers[ container_index ] ),
+		     &( replay->containers[ container_index + 1 ] ),
+		     sizeof( fdata_bench_replay_container_t ) * ( replay->number_of_containers - container_index ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to move containers.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Replays a workload record
+ * Calls that fail during the replay or that refer to containers unknown to the replay
+ * are skipped
+ * Returns 1 if successful, 0 if the record was skipped or -1 on error
+ */
+int fdata_bench_replay_record(
+     fdata_bench_replay_t *replay,
+     const uint8_t *record_data,
+     libcerror_error_t **error )
+{
+	fdata_bench_replay_container_t *replay_container = NULL;
+	fdata_bench_replay_container_t *source_container = NULL;
+	libcerror_error_t *call_error                    = NULL;
+	intptr_t *element_value                          = NULL;
+	static char *function                            = "fdata_bench_replay_record";
+	off64_t element_data_offset                      = 0;
+	size64_t size                                    = 0;
+	uint64_t identifier                              = 0;
+	uint64_t offset                                  = 0;
+	uint32_t file_index                              = 0;
+	uint32_t index                                   = 0;
+	uint8_t call                                     = 0;
+	uint8_t container_type                           = 0;
+	uint8_t flags                                    = 0;
+	int element_index                                = 0;
+	int result                                       = 0;
+
+	if( replay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	container_type = record_data[ 0 ];
+	call           = record_data[ 1 ];
+	flags          = record_data[ 2 ];
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 4 ] ),
+	 index );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 8 ] ),
+	 file_index );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 12 ] ),
+	 offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 20 ] ),
+	 size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 28 ] ),
+	 identifier );
+
+	if( call == LIBFDATA_WORKLOAD_CALL_INITIALIZE )
+	{
+		return( fdata_bench_replay_append_container(
+		         replay,
+		         identifier,
+		         container_type,
+		         size,
+		         NULL,
+		         error ) );
+	}
+	if( call == LIBFDATA_WORKLOAD_CALL_CLONE )
+	{
+		result = fdata_bench_replay_get_container(
+		          replay,
+		          offset,
+		          container_type,
+		          &source_container,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		return( fdata_bench_replay_append_container(
+		         replay,
+		         identifier,
+		         container_type,
+		         0,
+		         source_container->container,
+		         error ) );
+	}
+	result = fdata_bench_replay_get_container(
+	          replay,
+	          identifier,
+	          container_type,
+	          &replay_container,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	if( call == LIBFDATA_WORKLOAD_CALL_FREE )
+	{
+		return( fdata_bench_replay_remove_container(
+		         replay,
+		         replay_container,
+		         error ) );
+	}
+	result = -1;
+
+	switch( container_type )
+	{
+		case LIBFDATA_TRACE_CONTAINER_TYPE_LIST:
+			if( call == LIBFDATA_WORKLOAD_CALL_APPEND_ELEMENT )
+			{
+				result = libfdata_list_append_element(
+				          (libfdata_list_t *) replay_container->container,
+				          &element_index,
+				          (int) file_index,
+				          (off64_t) offset,
+				          size,
+				          0,
+				          &call_error );
+			}
+			else if( call == LIBFDATA_WORKLOAD_CALL_GET_ELEMENT_VALUE_BY_INDEX )
+			{
+				result = libfdata_list_get_element_value_by_index(
+				          (libfdata_list_t *) replay_container->container,
+				          NULL,
+				          replay_container->cache,
+				          (int) index,
+				          &element_value,
+				          flags,
+				          &call_error );
+			}
+			else if( call == LIBFDATA_WORKLOAD_CALL_GET_ELEMENT_VALUE_AT_OFFSET )
+			{
+				result = libfdata_list_get_element_value_at_offset(
+				          (libfdata_list_t *) replay_container->container,
+				          NULL,
+				          replay_container->cache,
+				          (off64_t) offset,
+				          &element_index,
+				          &element_data_offset,
+				          &element_value,
+				          flags,
+				          &call_error );
+			}
+			break;
+
+		case LIBFDATA_TRACE_CONTAINER_TYPE_STREAM:
+			if( call == LIBFDATA_WORKLOAD_CALL_APPEND_SEGMENT )
+			{
+				result = libfdata_stream_append_segment(
+				          (libfdata_stream_t *) replay_container->container,
+				          &element_index,
+				          (int) file_index,
+				          (off64_t) offset,
+				          size,
+				          0,
+				          &call_error );
+			}
+			else if( call == LIBFDATA_WORKLOAD_CALL_READ_BUFFER )
+			{
+				if( size > FDATA_BENCH_REPLAY_MAXIMUM_BUFFER_SIZE )
+				{
+					size = FDATA_BENCH_REPLAY_MAXIMUM_BUFFER_SIZE;
+				}
+				if( libfdata_stream_read_buffer(
+				     (libfdata_stream_t *) replay_container->container,
+				     NULL,
+				     replay->buffer,
+				     (size_t) size,
+				     flags,
+				     &call_error ) >= 0 )
+				{
+					result = 1;
+				}
+			}
+			else if( call == LIBFDATA_WORKLOAD_CALL_SEEK_OFFSET )
+			{
+				if( libfdata_stream_seek_offset(
+				     (libfdata_stream_t *) replay_container->container,
+				     (off64_t) offset,
+				     (int) flags,
+				     &call_error ) >= 0 )
+				{
+					result = 1;
+				}
+			}
+			break;
+
+		case LIBFDATA_TRACE_CONTAINER_TYPE_VECTOR:
+			if( call == LIBFDATA_WORKLOAD_CALL_APPEND_SEGMENT )
+			{
+				result = libfdata_vector_append_segment(
+				          (libfdata_vector_t *) replay_container->container,
+				          &element_index,
+				          (int) file_index,
+				          (off64_t) offset,
+				          size,
+				          0,
+				          &call_error );
+			}
+			else if( call == LIBFDATA_WORKLOAD_CALL_GET_ELEMENT_INDEX_AT_OFFSET )
+			{
+				result = libfdata_vector_get_element_index_at_offset(
+				          (libfdata_vector_t *) replay_container->container,
+				          (off64_t) offset,
+				          &element_index,
+				          &element_data_offset,
+				          &call_error );
+			}
+			else if( call == LIBFDATA_WORKLOAD_CALL_GET_ELEMENT_VALUE_BY_INDEX )
+			{
+				result = libfdata_vector_get_element_value_by_index(
+				          (libfdata_vector_t *) replay_container->container,
+				          NULL,
+				          replay_container->cache,
+				          (int) index,
+				          &element_value,
+				          flags,
+				          &call_error );
+			}
+			break;
+
+		default:
+			break;
+	}
+	if( call_error != NULL )
+	{
+		libcerror_error_free(
+		 &call_error );
+	}
+	if( result == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the workload records from a file
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_read_file(
+     const system_character_t *filename,
+     uint8_t **records_data,
+     int *number_of_records,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation  = NULL;
+	FILE *file_stream      = NULL;
+	static char *function  = "fdata_bench_replay_read_file";
+	size_t allocated_size  = 0;
+	size_t data_size       = 0;
+	size_t read_count      = 0;
+
+	if( records_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid records data.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_records == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of records.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               L"rb" );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               "rb" );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		if( data_size == allocated_size )
+		{
+			allocated_size += 4096 * LIBFDATA_WORKLOAD_RECORD_SIZE;
+
+			if( allocated_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid records data size value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			reallocation = (uint8_t *) memory_reallocate(
+			                            *records_data,
+			                            sizeof( uint8_t ) * allocated_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize records data.",
+				 function );
+
+				goto on_error;
+			}
+			*records_data = reallocation;
+		}
+		read_count = file_stream_read(
+		              file_stream,
+		              &( ( *records_data )[ data_size ] ),
+		              allocated_size - data_size );
+
+		data_size += read_count;
+	}
+	while( read_count > 0 );
+
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		file_stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	*number_of_records = (int) ( data_size / LIBFDATA_WORKLOAD_RECORD_SIZE );
+
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( *records_data != NULL )
+	{
+		memory_free(
+		 *records_data );
+
+		*records_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Replays the workload records with a specific number of cache entries per container
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_records(
+     const uint8_t *records_data,
+     int number_of_records,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	char benchmark_name[ 32 ];
+
+	fdata_bench_replay_t *replay = NULL;
+	static char *function        = "fdata_bench_replay_records";
+	uint64_t end_time            = 0;
+	uint64_t start_time          = 0;
+	int record_index             = 0;
+	int result                   = 0;
+
+	if( records_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid records data.",
+		 function );
+
+		return( -1 );
+	}
+	if( fdata_bench_replay_initialize(
+	     &replay,
+	     number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create replay.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_bench_get_time(
+	 &start_time );
+
+	for( record_index = 0;
+	     record_index < number_of_records;
+	     record_index++ )
+	{
+		result = fdata_bench_replay_record(
+		          replay,
+		          &( records_data[ record_index * LIBFDATA_WORKLOAD_RECORD_SIZE ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to replay record: %d.",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			replay->number_of_skipped_records += 1;
+		}
+	}
+	fdata_bench_get_time(
+	 &end_time );
+
+	narrow_string_snprintf(
+	 benchmark_name,
+	 32,
+	 "replay_cache_%d",
+	 number_of_cache_entries );
+
+	fdata_bench_print_result(
+	 benchmark_name,
+	 replay->number_of_created_containers,
+	 number_of_records,
+	 start_time,
+	 end_time );
+
+	if( replay->number_of_skipped_records > 0 )
+	{
+		fprintf(
+		 stdout,
+		 "# %s: skipped %d records\n",
+		 benchmark_name,
+		 replay->number_of_skipped_records );
+	}
+	if( fdata_bench_replay_free(
+	     &replay,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free replay.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( replay != NULL )
+	{
+		fdata_bench_replay_free(
+		 &replay,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Records a synthetic workload to a file
+ * The workload consists of random element value reads from a vector and a list
+ * and random buffer reads from a stream
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_replay_record_workload(
+     const char *filename,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ 64 ];
+
+	libfdata_cache_t *cache      = NULL;
+	libfdata_list_t *list        = NULL;
+	libfdata_stream_t *stream    = NULL;
+	libfdata_vector_t *vector    = NULL;
+	intptr_t *element_value      = NULL;
+	static char *function        = "fdata_bench_replay_record_workload";
+	off64_t element_data_offset  = 0;
+	off64_t offset               = 0;
+	uint32_t random_seed         = FDATA_BENCH_RANDOM_SEED;
+	int element_index            = 0;
+	int list_element_index       = 0;
+	int operation_index          = 0;
+	int segment_index            = 0;
+
+	if( libfdata_notify_workload_open(
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open workload stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_initialize(
+	     &cache,
+	     FDATA_BENCH_NUMBER_OF_CACHE_ENTRIES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_initialize(
+	     &vector,
+	     FDATA_BENCH_REPLAY_ELEMENT_DATA_SIZE,
+	     NULL,
+	     NULL,
+	     NULL,
+	     &fdata_bench_replay_read_vector_element_data,
+	     NULL,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_append_segment(
+	     vector,
+	     &segment_index,
+	     0,
+	     0,
+	     (size64_t) FDATA_BENCH_REPLAY_NUMBER_OF_ELEMENTS * FDATA_BENCH_REPLAY_ELEMENT_DATA_SIZE,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append vector segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_initialize(
+	     &list,
+	     NULL,
+	     NULL,
+	     NULL,
+	     &fdata_bench_replay_read_list_element_data,
+	     NULL,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list.",
+		 function );
+
+		goto on_error;
+	}
+	for( element_index = 0;
+	     element_index < FDATA_BENCH_REPLAY_NUMBER_OF_ELEMENTS;
+	     element_index++ )
+	{
+		if( libfdata_list_append_element(
+		     list,
+		     &list_element_index,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_REPLAY_ELEMENT_DATA_SIZE,
+		     FDATA_BENCH_REPLAY_ELEMENT_DATA_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append list element: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	if( libfdata_stream_initialize(
+	     &stream,
+	     NULL,
+	     NULL,
+	     NULL,
+	     NULL,
+	     &fdata_bench_replay_read_segment_data,
+	     NULL,
+	     &fdata_bench_replay_seek_segment_offset,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stream.",
+		 function );
+
+		goto on_error;
+	}
+	for( element_index = 0;
+	     element_index < FDATA_BENCH_REPLAY_NUMBER_OF_ELEMENTS / 32;
+	     element_index++ )
+	{
+		if( libfdata_stream_append_segment(
+		     stream,
+		     &segment_index,
+		     0,
+		     (off64_t) element_index * FDATA_BENCH_REPLAY_SEGMENT_SIZE,
+		     FDATA_BENCH_REPLAY_SEGMENT_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append stream segment: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	for( operation_index = 0;
+	     operation_index < FDATA_BENCH_NUMBER_OF_OPERATIONS;
+	     operation_index++ )
+	{
+		element_index = (int) ( fdata_bench_get_random_value( &random_seed ) % FDATA_BENCH_REPLAY_NUMBER_OF_HOT_ELEMENTS );
+
+		switch( operation_index % 4 )
+		{
+			case 0:
+				if( libfdata_vector_get_element_value_by_index(
+				     vector,
+				     NULL,
+				     cache,
+				     element_index,
+				     &element_value,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve vector element: %d value.",
+					 function,
+					 element_index );
+
+					goto on_error;
+				}
+				break;
+
+			case 1:
+				offset = ( (off64_t) element_index * FDATA_BENCH_REPLAY_ELEMENT_DATA_SIZE ) + 1;
+
+				if( libfdata_vector_get_element_value_at_offset(
+				     vector,
+				     NULL,
+				     cache,
+				     offset,
+				     &element_data_offset,
+				     &element_value,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve vector element value at offset: %" PRIi64 ".",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+				break;
+
+			case 2:
+				if( libfdata_list_get_element_value_by_index(
+				     list,
+				     NULL,
+				     cache,
+				     element_index,
+				     &element_value,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve list element: %d value.",
+					 function,
+					 element_index );
+
+					goto on_error;
+				}
+				break;
+
+			default:
+				offset = (off64_t) element_index * ( FDATA_BENCH_REPLAY_SEGMENT_SIZE / 8 );
+
+				if( libfdata_stream_read_buffer_at_offset(
+				     stream,
+				     NULL,
+				     buffer,
+				     64,
+				     offset,
+				     0,
+				     error ) != 64 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer at offset: %" PRIi64 ".",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+				break;
+		}
+	}
+	if( libfdata_stream_free(
+	     &stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_free(
+	     &list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_free(
+	     &vector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_cache_free(
+	     &cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_notify_workload_close(
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close workload stream.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	libfdata_notify_workload_close(
+	 NULL );
+
+	return( -1 );
+}
+
+/* The main program
+ * Replays the workload recording passed as argument or a recording of a synthetic workload
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	int number_of_cache_entries_values[ 3 ] = { 64, 256, 1024 };
+
+	libcerror_error_t *error                = NULL;
+	uint8_t *records_data                   = NULL;
+	int number_of_records                   = 0;
+	int value_index                         = 0;
+
+	if( argc > 1 )
+	{
+		if( fdata_bench_replay_read_file(
+		     argv[ 1 ],
+		     &records_data,
+		     &number_of_records,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( fdata_bench_replay_record_workload(
+		     FDATA_BENCH_REPLAY_WORKLOAD_FILENAME,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_replay_read_file(
+		     _SYSTEM_STRING( FDATA_BENCH_REPLAY_WORKLOAD_FILENAME ),
+		     &records_data,
+		     &number_of_records,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	fdata_bench_print_header();
+
+	for( value_index = 0;
+	     value_index < 3;
+	     value_index++ )
+	{
+		if( fdata_bench_replay_records(
+		     records_data,
+		     number_of_records,
+		     number_of_cache_entries_values[ value_index ],
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( records_data != NULL )
+	{
+		memory_free(
+		 records_data );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( records_data != NULL )
+	{
+		memory_free(
+		 records_data );
+	}
+	return( EXIT_FAILURE );
+}
+
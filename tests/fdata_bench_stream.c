@@ -0,0 +1,399 @@
+/*
+ * Library stream type benchmark program
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fdata_bench.h"
+#include "fdata_test_libcerror.h"
+#include "fdata_test_libfdata.h"
+#include "fdata_test_unused.h"
+
+/* The segment size
+ */
+#define FDATA_BENCH_STREAM_SEGMENT_SIZE		512
+
+/* The size of the buffer used for sequential reads
+ */
+#define FDATA_BENCH_STREAM_BUFFER_SIZE		4096
+
+/* The size of the buffer used for random reads
+ */
+#define FDATA_BENCH_STREAM_RANDOM_READ_SIZE	64
+
+/* Creates a stream with a specific number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_stream_initialize(
+     libfdata_stream_t **stream,
+     fdata_bench_data_handle_t *data_handle,
+     int number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function    = "fdata_bench_stream_initialize";
+	int segment_index        = 0;
+	int stream_segment_index = 0;
+
+	if( libfdata_stream_initialize(
+	     stream,
+	     (intptr_t *) data_handle,
+	     NULL,
+	     NULL,
+	     NULL,
+	     (ssize_t (*)(intptr_t *, intptr_t *, int, int, uint8_t *, size_t, uint32_t, uint8_t, libcerror_error_t **)) &fdata_bench_data_handle_read_segment_data,
+	     NULL,
+	     (off64_t (*)(intptr_t *, intptr_t *, int, int, off64_t, libcerror_error_t **)) &fdata_bench_data_handle_seek_segment_offset,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stream.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libfdata_stream_append_segment(
+		     *stream,
+		     &stream_segment_index,
+		     0,
+		     (off64_t) segment_index * FDATA_BENCH_STREAM_SEGMENT_SIZE,
+		     FDATA_BENCH_STREAM_SEGMENT_SIZE,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment: %d.",
+			 function,
+			 segment_index );
+
+			libfdata_stream_free(
+			 stream,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Benchmarks building a stream
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_stream_append_segment(
+     fdata_bench_data_handle_t *data_handle,
+     int number_of_segments,
+     libcerror_error_t **error )
+{
+	libfdata_stream_t *stream = NULL;
+	static char *function     = "fdata_bench_stream_append_segment";
+	uint64_t end_time         = 0;
+	uint64_t start_time       = 0;
+
+	fdata_bench_get_time(
+	 &start_time );
+
+	if( fdata_bench_stream_initialize(
+	     &stream,
+	     data_handle,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stream.",
+		 function );
+
+		goto on_error;
+	}
+	fdata_bench_get_time(
+	 &end_time );
+
+	fdata_bench_print_result(
+	 "stream_append_segment",
+	 number_of_segments,
+	 number_of_segments,
+	 start_time,
+	 end_time );
+
+	if( libfdata_stream_free(
+	     &stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stream.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks reading a stream
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_bench_stream_read_buffer(
+     fdata_bench_data_handle_t *data_handle,
+     int number_of_segments,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ FDATA_BENCH_STREAM_BUFFER_SIZE ];
+
+	libfdata_stream_t *stream = NULL;
+	static char *function     = "fdata_bench_stream_read_buffer";
+	size64_t stream_size      = 0;
+	ssize_t read_count        = 0;
+	off64_t offset            = 0;
+	uint64_t end_time         = 0;
+	uint64_t start_time       = 0;
+	uint32_t random_seed      = FDATA_BENCH_RANDOM_SEED;
+	int number_of_operations  = 0;
+	int operation_index       = 0;
+
+	if( fdata_bench_stream_initialize(
+	     &stream,
+	     data_handle,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stream.",
+		 function );
+
+		goto on_error;
+	}
+	stream_size = (size64_t) number_of_segments * FDATA_BENCH_STREAM_SEGMENT_SIZE;
+
+	fdata_bench_get_time(
+	 &start_time );
+
+	do
+	{
+		read_count = libfdata_stream_read_buffer(
+		              stream,
+		              NULL,
+		              buffer,
+		              FDATA_BENCH_STREAM_BUFFER_SIZE,
+		              0,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from stream.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_operations++;
+	}
+	while( read_count > 0 );
+
+	fdata_bench_get_time(
+	 &end_time );
+
+	fdata_bench_print_result(
+	 "stream_read_buffer_sequential",
+	 number_of_segments,
+	 number_of_operations,
+	 start_time,
+	 end_time );
+
+	fdata_bench_get_time(
+	 &start_time );
+
+	for( operation_index = 0;
+	     operation_index < FDATA_BENCH_NUMBER_OF_OPERATIONS;
+	     operation_index++ )
+	{
+		offset = (off64_t) ( fdata_bench_get_random_value( &random_seed ) % (uint32_t) ( stream_size - FDATA_BENCH_STREAM_RANDOM_READ_SIZE ) );
+
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              stream,
+		              NULL,
+		              buffer,
+		              FDATA_BENCH_STREAM_RANDOM_READ_SIZE,
+		              offset,
+		              0,
+		              error );
+
+		if( read_count != (ssize_t) FDATA_BENCH_STREAM_RANDOM_READ_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from stream at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+	}
+	fdata_bench_get_time(
+	 &end_time );
+
+	fdata_bench_print_result(
+	 "stream_read_buffer_at_offset_random",
+	 number_of_segments,
+	 FDATA_BENCH_NUMBER_OF_OPERATIONS,
+	 start_time,
+	 end_time );
+
+	if( libfdata_stream_free(
+	     &stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stream.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	int number_of_segments_values[ 2 ]    = { 1024, 16384 };
+
+	fdata_bench_data_handle_t *data_handle = NULL;
+	libcerror_error_t *error               = NULL;
+	int number_of_segments                 = 0;
+	int value_index                        = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( argc )
+	FDATA_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fdata_bench_print_header();
+
+	for( value_index = 0;
+	     value_index < 2;
+	     value_index++ )
+	{
+		number_of_segments = number_of_segments_values[ value_index ];
+
+		if( fdata_bench_data_handle_initialize(
+		     &data_handle,
+		     (size_t) number_of_segments * FDATA_BENCH_STREAM_SEGMENT_SIZE,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_stream_append_segment(
+		     data_handle,
+		     number_of_segments,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_stream_read_buffer(
+		     data_handle,
+		     number_of_segments,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( fdata_bench_data_handle_free(
+		     &data_handle,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_handle != NULL )
+	{
+		fdata_bench_data_handle_free(
+		 &data_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
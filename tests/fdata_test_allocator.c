@@ -0,0 +1,352 @@
+/*
+ * Library allocator functions test program
+ *
+ * Copyright (C) 2010-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fdata_test_libcerror.h"
+#include "fdata_test_libfdata.h"
+#include "fdata_test_macros.h"
+#include "fdata_test_unused.h"
+
+int fdata_test_allocator_number_of_allocations = 0;
+
+int fdata_test_allocator_number_of_frees = 0;
+
+/* Test allocate function
+ */
+void *fdata_test_allocator_allocate_function(
+       intptr_t *allocator_data,
+       size_t size )
+{
+	if( allocator_data != (intptr_t *) &fdata_test_allocator_number_of_allocations )
+	{
+		return( NULL );
+	}
+	fdata_test_allocator_number_of_allocations++;
+
+	return( memory_allocate(
+	         size ) );
+}
+
+/* Test reallocate function
+ */
+void *fdata_test_allocator_reallocate_function(
+       intptr_t *allocator_data,
+       void *memory,
+       size_t size )
+{
+	if( allocator_data != (intptr_t *) &fdata_test_allocator_number_of_allocations )
+	{
+		return( NULL );
+	}
+	if( memory == NULL )
+	{
+		fdata_test_allocator_number_of_allocations++;
+	}
+	return( memory_reallocate(
+	         memory,
+	         size ) );
+}
+
+/* Test free function
+ */
+void fdata_test_allocator_free_function(
+      intptr_t *allocator_data FDATA_TEST_ATTRIBUTE_UNUSED,
+      void *memory )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( allocator_data )
+
+	fdata_test_allocator_number_of_frees++;
+
+	memory_free(
+	 memory );
+}
+
+/* Tests the libfdata_allocator_set_functions function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_allocator_set_functions(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Test regular cases
+	 */
+	result = libfdata_allocator_set_functions(
+	          &fdata_test_allocator_allocate_function,
+	          &fdata_test_allocator_reallocate_function,
+	          &fdata_test_allocator_free_function,
+	          (intptr_t *) &fdata_test_allocator_number_of_allocations,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          0,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( fdata_test_allocator_number_of_allocations > 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_allocator_number_of_frees",
+	 fdata_test_allocator_number_of_frees,
+	 fdata_test_allocator_number_of_allocations );
+
+	/* Unset the allocator functions
+	 */
+	result = libfdata_allocator_set_functions(
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fdata_test_allocator_number_of_allocations = 0;
+
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_allocator_number_of_allocations",
+	 fdata_test_allocator_number_of_allocations,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfdata_allocator_set_functions(
+	          NULL,
+	          &fdata_test_allocator_reallocate_function,
+	          &fdata_test_allocator_free_function,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_allocator_set_functions(
+	          &fdata_test_allocator_allocate_function,
+	          NULL,
+	          &fdata_test_allocator_free_function,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_allocator_set_functions(
+	          &fdata_test_allocator_allocate_function,
+	          &fdata_test_allocator_reallocate_function,
+	          NULL,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	libfdata_allocator_set_functions(
+	 NULL,
+	 NULL,
+	 NULL,
+	 NULL,
+	 NULL );
+
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FDATA_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FDATA_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( argc )
+	FDATA_TEST_UNREFERENCED_PARAMETER( argv )
+
+	FDATA_TEST_RUN(
+	 "libfdata_allocator_set_functions",
+	 fdata_test_allocator_set_functions );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -41,6 +41,10 @@ int fdata_test_area_data_handle_free_function_return_value   = 1;
 int fdata_test_area_data_handle_clone_function_return_value  = 1;
 int fdata_test_area_element_value_free_function_return_value = 1;
 
+int fdata_test_area_read_element_data_free_element_value     = 0;
+
+libfdata_area_t *fdata_test_area_nested_area                 = NULL;
+
 /* Test data handle free function
  * Returns 1 if successful or -1 on error
  */
@@ -82,6 +86,29 @@ int fdata_test_area_element_value_free_function(
 	return( fdata_test_area_element_value_free_function_return_value );
 }
 
+/* Test element value free function that frees the element value
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_area_element_value_memory_free_function(
+     intptr_t **element_value,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( element_value == NULL )
+	{
+		return( -1 );
+	}
+	if( *element_value != NULL )
+	{
+		memory_free(
+		 *element_value );
+
+		*element_value = NULL;
+	}
+	return( 1 );
+}
+
 /* Reads element data
  * Callback function for the area
  * Returns 1 if successful or -1 on error
@@ -103,6 +130,10 @@ int fdata_test_area_read_element_data(
 	static char *function  = "fdata_test_area_read_element_data";
 	uint32_t element_index = 0;
 
+	int (*free_element_value)(
+	       intptr_t **element_value,
+	       libcerror_error_t **error ) = (int (*)(intptr_t **, libcerror_error_t **)) &fdata_test_area_element_value_free_function;
+
 	if( data_handle != NULL )
 	{
 		libcerror_error_set(
@@ -190,13 +221,17 @@ int fdata_test_area_read_element_data(
 	 element_value,
 	 element_index );
 
+	if( fdata_test_area_read_element_data_free_element_value != 0 )
+	{
+		free_element_value = &fdata_test_area_element_value_memory_free_function;
+	}
 	if( libfdata_area_set_element_value_at_offset(
 	     area,
 	     file_io_handle,
 	     cache,
 	     element_value_offset,
 	     (intptr_t *) element_value,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &fdata_test_area_element_value_free_function,
+	     free_element_value,
 	     LIBFDATA_AREA_ELEMENT_VALUE_FLAG_MANAGED,
 	     error ) != 1 )
 	{
@@ -221,6 +256,55 @@ on_error:
 	return( -1 );
 }
 
+/* Reads element data and reads the next element of fdata_test_area_nested_area,
+ * using the same cache
+ * Callback function for the area
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_area_read_element_data_and_read_nested(
+     intptr_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_area_t *area,
+     libfdata_cache_t *cache,
+     off64_t element_value_offset,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	intptr_t *nested_element_value = NULL;
+
+	if( fdata_test_area_read_element_data(
+	     data_handle,
+	     file_io_handle,
+	     area,
+	     cache,
+	     element_value_offset,
+	     element_data_file_index,
+	     element_data_offset,
+	     element_data_size,
+	     element_data_flags,
+	     read_flags,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libfdata_area_get_element_value_at_offset(
+	     fdata_test_area_nested_area,
+	     file_io_handle,
+	     cache,
+	     element_value_offset + 128,
+	     &nested_element_value,
+	     read_flags,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Tests the libfdata_area_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -2124,6 +2208,319 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfdata_area_get_element_value_at_offset function with a nested read
+ * of another area that shares the cache
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_area_get_element_value_at_offset_shared_cache(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libfdata_area_t *area          = NULL;
+	libfdata_area_t *nested_area   = NULL;
+	libfdata_cache_t *cache        = NULL;
+	libfdata_cache_t *single_cache = NULL;
+	intptr_t *element_value        = NULL;
+	uint32_t value_32bit           = 0;
+	int result                     = 0;
+	int segment_index              = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_cache_initialize(
+	          &cache,
+	          16,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_initialize(
+	          &single_cache,
+	          1,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "single_cache",
+	 single_cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_area_initialize(
+	          &area,
+	          128,
+	          NULL,
+	          &fdata_test_area_data_handle_free_function,
+	          &fdata_test_area_data_handle_clone_function,
+	          &fdata_test_area_read_element_data_and_read_nested,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "area",
+	 area );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_area_append_segment(
+	          area,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_area_initialize(
+	          &nested_area,
+	          128,
+	          NULL,
+	          &fdata_test_area_data_handle_free_function,
+	          &fdata_test_area_data_handle_clone_function,
+	          &fdata_test_area_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "nested_area",
+	 nested_area );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_area_append_segment(
+	          nested_area,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fdata_test_area_nested_area                          = nested_area;
+	fdata_test_area_read_element_data_free_element_value = 1;
+
+	/* Test a nested read of another area that shares the cache
+	 */
+	element_value = NULL;
+
+	result = libfdata_area_get_element_value_at_offset(
+	          area,
+	          NULL,
+	          cache,
+	          256,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 2 );
+
+	/* Test a nested read of another area that shares the cache and evicts the value
+	 */
+	element_value = NULL;
+
+	result = libfdata_area_get_element_value_at_offset(
+	          area,
+	          NULL,
+	          single_cache,
+	          512,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	fdata_test_area_nested_area                          = NULL;
+	fdata_test_area_read_element_data_free_element_value = 0;
+
+	/* Clean up
+	 */
+	result = libfdata_area_free(
+	          &nested_area,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "nested_area",
+	 nested_area );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_area_free(
+	          &area,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "area",
+	 area );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_free(
+	          &single_cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "single_cache",
+	 single_cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_free(
+	          &cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	fdata_test_area_nested_area                          = NULL;
+	fdata_test_area_read_element_data_free_element_value = 0;
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( nested_area != NULL )
+	{
+		libfdata_area_free(
+		 &nested_area,
+		 NULL );
+	}
+	if( area != NULL )
+	{
+		libfdata_area_free(
+		 &area,
+		 NULL );
+	}
+	if( single_cache != NULL )
+	{
+		libfdata_cache_free(
+		 &single_cache,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libfdata_area_set_element_value_at_offset function
  * Returns 1 if successful or 0 if not
  */
@@ -2508,6 +2905,10 @@ int main(
 	 "libfdata_area_get_element_value_at_offset",
 	 fdata_test_area_get_element_value_at_offset );
 
+	FDATA_TEST_RUN(
+	 "libfdata_area_get_element_value_at_offset_shared_cache",
+	 fdata_test_area_get_element_value_at_offset_shared_cache );
+
 	FDATA_TEST_RUN(
 	 "libfdata_area_set_element_value_at_offset",
 	 fdata_test_area_set_element_value_at_offset );
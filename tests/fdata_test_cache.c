@@ -33,6 +33,8 @@
 #include "fdata_test_memory.h"
 #include "fdata_test_unused.h"
 
+#include "../libfdata/libfdata_cache.h"
+
 /* Tests the libfdata_cache_free function
  * Returns 1 if successful or 0 if not
  */
@@ -71,6 +73,85 @@ on_error:
 	return( 0 );
 }
 
+#if defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT )
+
+/* Tests the libfdata_cache_get_timestamp function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_cache_get_timestamp(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int64_t timestamp1       = 0;
+	int64_t timestamp2       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfdata_cache_get_timestamp(
+	          &timestamp1,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Consecutive timestamps are unique even within the same clock tick
+	 */
+	result = libfdata_cache_get_timestamp(
+	          &timestamp2,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "timestamp2",
+	 timestamp2,
+	 timestamp1 );
+
+	/* Test error cases
+	 */
+	result = libfdata_cache_get_timestamp(
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -92,6 +173,14 @@ int main(
 	 "libfdata_cache_free",
 	 fdata_test_cache_free );
 
+#if defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT )
+
+	FDATA_TEST_RUN(
+	 "libfdata_cache_get_timestamp",
+	 fdata_test_cache_get_timestamp );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) */
+
 	return( EXIT_SUCCESS );
 
 on_error:
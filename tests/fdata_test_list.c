@@ -41,6 +41,10 @@ int fdata_test_list_data_handle_free_function_return_value   = 1;
 int fdata_test_list_data_handle_clone_function_return_value  = 1;
 int fdata_test_list_element_value_free_function_return_value = 1;
 
+int fdata_test_list_read_element_data_free_element_value     = 0;
+
+libfdata_list_t *fdata_test_list_nested_list                 = NULL;
+
 /* Test data handle free function
  * Returns 1 if successful or -1 on error
  */
@@ -82,6 +86,29 @@ int fdata_test_list_element_value_free_function(
 	return( fdata_test_list_element_value_free_function_return_value );
 }
 
+/* Test element value free function that frees the element value
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_list_element_value_memory_free_function(
+     intptr_t **element_value,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( element_value == NULL )
+	{
+		return( -1 );
+	}
+	if( *element_value != NULL )
+	{
+		memory_free(
+		 *element_value );
+
+		*element_value = NULL;
+	}
+	return( 1 );
+}
+
 /* Reads element data
  * Callback function for the list
  * Returns 1 if successful or -1 on error
@@ -102,6 +129,10 @@ int fdata_test_list_read_element_data(
 	static char *function  = "fdata_test_list_read_element_data";
 	uint32_t element_index = 0;
 
+	int (*free_element_value)(
+	       intptr_t **element_value,
+	       libcerror_error_t **error ) = (int (*)(intptr_t **, libcerror_error_t **)) &fdata_test_list_element_value_free_function;
+
 	if( data_handle != NULL )
 	{
 		libcerror_error_set(
@@ -189,12 +220,16 @@ int fdata_test_list_read_element_data(
 	 element_value,
 	 element_index );
 
+	if( fdata_test_list_read_element_data_free_element_value != 0 )
+	{
+		free_element_value = &fdata_test_list_element_value_memory_free_function;
+	}
 	if( libfdata_list_element_set_element_value(
 	     list_element,
 	     file_io_handle,
 	     cache,
 	     (intptr_t *) element_value,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &fdata_test_list_element_value_free_function,
+	     free_element_value,
 	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
 	     error ) != 1 )
 	{
@@ -218,6 +253,53 @@ on_error:
 	return( -1 );
 }
 
+/* Reads element data and reads the second element of fdata_test_list_nested_list,
+ * using the same cache
+ * Callback function for the list
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_list_read_element_data_and_read_nested(
+     intptr_t *data_handle,
+     intptr_t *file_io_handle,
+     libfdata_list_element_t *list_element,
+     libfdata_cache_t *cache,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t element_data_size,
+     uint32_t element_data_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	intptr_t *nested_element_value = NULL;
+
+	if( fdata_test_list_read_element_data(
+	     data_handle,
+	     file_io_handle,
+	     list_element,
+	     cache,
+	     element_data_file_index,
+	     element_data_offset,
+	     element_data_size,
+	     element_data_flags,
+	     read_flags,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     fdata_test_list_nested_list,
+	     file_io_handle,
+	     cache,
+	     1,
+	     &nested_element_value,
+	     read_flags,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Tests the libfdata_list_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -3930,19 +4012,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_list_get_element_value_at_offset function
+/* Tests the libfdata_list_get_element_value_by_index function with a nested read
+ * of another list that shares the cache
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_list_get_element_value_at_offset(
+int fdata_test_list_get_element_value_by_index_shared_cache(
      void )
 {
-	libcerror_error_t *error    = NULL;
-	libfdata_cache_t *cache     = NULL;
-	libfdata_list_t *list       = NULL;
-	intptr_t *element_value     = NULL;
-	off64_t element_data_offset = 0;
-	int element_index           = 0;
-	int result                  = 0;
+	libcerror_error_t *error       = NULL;
+	libfdata_cache_t *cache        = NULL;
+	libfdata_cache_t *single_cache = NULL;
+	libfdata_list_t *list          = NULL;
+	libfdata_list_t *nested_list   = NULL;
+	intptr_t *element_value        = NULL;
+	uint32_t value_32bit           = 0;
+	int element_index              = 0;
+	int result                     = 0;
 
 	/* Initialize test
 	 */
@@ -3964,12 +4049,30 @@ int fdata_test_list_get_element_value_at_offset(
 	 "error",
 	 error );
 
+	result = libfdata_cache_initialize(
+	          &single_cache,
+	          1,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "single_cache",
+	 single_cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfdata_list_initialize(
 	          &list,
 	          NULL,
 	          &fdata_test_list_data_handle_free_function,
 	          &fdata_test_list_data_handle_clone_function,
-	          &fdata_test_list_read_element_data,
+	          &fdata_test_list_read_element_data_and_read_nested,
 	          NULL,
 	          0,
 	          &error );
@@ -4005,18 +4108,13 @@ int fdata_test_list_get_element_value_at_offset(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	element_value = NULL;
-
-	result = libfdata_list_get_element_value_at_offset(
-	          list,
+	result = libfdata_list_initialize(
+	          &nested_list,
+	          NULL,
+	          &fdata_test_list_data_handle_free_function,
+	          &fdata_test_list_data_handle_clone_function,
+	          &fdata_test_list_read_element_data,
 	          NULL,
-	          (libfdata_cache_t *) cache,
-	          0,
-	          &element_index,
-	          &element_data_offset,
-	          &element_value,
 	          0,
 	          &error );
 
@@ -4026,76 +4124,61 @@ int fdata_test_list_get_element_value_at_offset(
 	 1 );
 
 	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "element_value",
-	 element_value );
+	 "nested_list",
+	 nested_list );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	memory_free(
-	 element_value );
-
-	element_value = NULL;
-
-	result = libfdata_list_get_element_value_at_offset(
-	          list,
-	          NULL,
-	          (libfdata_cache_t *) cache,
-	          4096,
+	result = libfdata_list_append_element(
+	          nested_list,
 	          &element_index,
-	          &element_data_offset,
-	          &element_value,
+	          1,
+	          1024,
+	          128,
 	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
-
-	FDATA_TEST_ASSERT_IS_NULL(
-	 "element_value",
-	 element_value );
+	 1 );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	element_value = NULL;
-
-	result = libfdata_list_get_element_value_at_offset(
-	          NULL,
-	          NULL,
-	          (libfdata_cache_t *) cache,
-	          0,
+	result = libfdata_list_append_element(
+	          nested_list,
 	          &element_index,
-	          &element_data_offset,
-	          &element_value,
+	          1,
+	          1024,
+	          128,
 	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	fdata_test_list_nested_list                          = nested_list;
+	fdata_test_list_read_element_data_free_element_value = 1;
 
-	result = libfdata_list_get_element_value_at_offset(
+	/* Test a nested read of another list that shares the cache
+	 */
+	element_value = NULL;
+
+	result = libfdata_list_get_element_value_by_index(
 	          list,
 	          NULL,
-	          (libfdata_cache_t *) cache,
+	          cache,
 	          0,
-	          NULL,
-	          &element_data_offset,
 	          &element_value,
 	          0,
 	          &error );
@@ -4103,23 +4186,35 @@ int fdata_test_list_get_element_value_at_offset(
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
 
-	result = libfdata_list_get_element_value_at_offset(
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0 );
+
+	/* Test a nested read of another list that shares the cache and evicts the value
+	 */
+	element_value = NULL;
+
+	result = libfdata_list_get_element_value_by_index(
 	          list,
 	          NULL,
-	          (libfdata_cache_t *) cache,
+	          single_cache,
 	          0,
-	          &element_index,
-	          &element_data_offset,
-	          NULL,
+	          &element_value,
 	          0,
 	          &error );
 
@@ -4135,8 +4230,28 @@ int fdata_test_list_get_element_value_at_offset(
 	libcerror_error_free(
 	 &error );
 
+	fdata_test_list_nested_list                          = NULL;
+	fdata_test_list_read_element_data_free_element_value = 0;
+
 	/* Clean up
 	 */
+	result = libfdata_list_free(
+	          &nested_list,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "nested_list",
+	 nested_list );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfdata_list_free(
 	          &list,
 	          &error );
@@ -4154,6 +4269,23 @@ int fdata_test_list_get_element_value_at_offset(
 	 "error",
 	 error );
 
+	result = libfdata_cache_free(
+	          &single_cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "single_cache",
+	 single_cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfdata_cache_free(
 	          &cache,
 	          &error );
@@ -4174,17 +4306,32 @@ int fdata_test_list_get_element_value_at_offset(
 	return( 1 );
 
 on_error:
+	fdata_test_list_nested_list                          = NULL;
+	fdata_test_list_read_element_data_free_element_value = 0;
+
 	if( error != NULL )
 	{
 		libcerror_error_free(
 		 &error );
 	}
+	if( nested_list != NULL )
+	{
+		libfdata_list_free(
+		 &nested_list,
+		 NULL );
+	}
 	if( list != NULL )
 	{
 		libfdata_list_free(
 		 &list,
 		 NULL );
 	}
+	if( single_cache != NULL )
+	{
+		libfdata_cache_free(
+		 &single_cache,
+		 NULL );
+	}
 	if( cache != NULL )
 	{
 		libfdata_cache_free(
@@ -4194,19 +4341,40 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_list_set_element_value_by_index function
+/* Tests the libfdata_list_get_element_value_at_offset function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_list_set_element_value_by_index(
+int fdata_test_list_get_element_value_at_offset(
      void )
 {
-	libcerror_error_t *error = NULL;
-	libfdata_list_t *list    = NULL;
-	int result               = 0;
-	int value1               = 1;
+	libcerror_error_t *error    = NULL;
+	libfdata_cache_t *cache     = NULL;
+	libfdata_list_t *list       = NULL;
+	intptr_t *element_value     = NULL;
+	off64_t element_data_offset = 0;
+	int element_index           = 0;
+	int result                  = 0;
 
 	/* Initialize test
 	 */
+	result = libfdata_cache_initialize(
+	          &cache,
+	          16,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfdata_list_initialize(
 	          &list,
 	          NULL,
@@ -4230,18 +4398,361 @@ int fdata_test_list_set_element_value_by_index(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-/* TODO implement */
-
-	/* Test error cases
-	 */
-	result = libfdata_list_set_element_value_by_index(
-	          NULL,
-	          NULL,
-	          NULL,
+	result = libfdata_list_append_element(
+	          list,
+	          &element_index,
+	          1,
+	          1024,
+	          128,
 	          0,
-	          (intptr_t *) &value1,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	element_value = NULL;
+
+	result = libfdata_list_get_element_value_at_offset(
+	          list,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_index,
+	          &element_data_offset,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 element_value );
+
+	element_value = NULL;
+
+	result = libfdata_list_get_element_value_at_offset(
+	          list,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          4096,
+	          &element_index,
+	          &element_data_offset,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	element_value = NULL;
+
+	result = libfdata_list_get_element_value_at_offset(
+	          NULL,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_index,
+	          &element_data_offset,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_list_get_element_value_at_offset(
+	          list,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          NULL,
+	          &element_data_offset,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_list_get_element_value_at_offset(
+	          list,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_index,
+	          &element_data_offset,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_list_free(
+	          &list,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "list",
+	 list );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_free(
+	          &cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_list_set_element_value_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_list_set_element_value_by_index(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libfdata_list_t *list    = NULL;
+	int result               = 0;
+	int value1               = 1;
+
+	/* Initialize test
+	 */
+	result = libfdata_list_initialize(
+	          &list,
+	          NULL,
+	          &fdata_test_list_data_handle_free_function,
+	          &fdata_test_list_data_handle_clone_function,
+	          &fdata_test_list_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "list",
+	 list );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libfdata_list_set_element_value_by_index(
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          (intptr_t *) &value1,
+	          &fdata_test_list_element_value_free_function,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_list_free(
+	          &list,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "list",
+	 list );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( list != NULL )
+	{
+		libfdata_list_free(
+		 &list,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_list_set_element_value_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_list_set_element_value_at_offset(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libfdata_list_t *list    = NULL;
+	int result               = 0;
+	int value1               = 1;
+
+	/* Initialize test
+	 */
+	result = libfdata_list_initialize(
+	          &list,
+	          NULL,
+	          &fdata_test_list_data_handle_free_function,
+	          &fdata_test_list_data_handle_clone_function,
+	          &fdata_test_list_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "list",
+	 list );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libfdata_list_set_element_value_at_offset(
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          (intptr_t *) &value1,
 	          &fdata_test_list_element_value_free_function,
 	          0,
 	          &error );
@@ -4294,16 +4805,17 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_list_set_element_value_at_offset function
+/* Tests the libfdata_list_get_size function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_list_set_element_value_at_offset(
+int fdata_test_list_get_size(
      void )
 {
 	libcerror_error_t *error = NULL;
 	libfdata_list_t *list    = NULL;
+	size64_t size            = 0;
+	int element_index        = 0;
 	int result               = 0;
-	int value1               = 1;
 
 	/* Initialize test
 	 */
@@ -4330,20 +4842,67 @@ int fdata_test_list_set_element_value_at_offset(
 	 "error",
 	 error );
 
+	result = libfdata_list_append_element(
+	          list,
+	          &element_index,
+	          1,
+	          1024,
+	          128,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test regular cases
 	 */
-/* TODO implement */
+	result = libfdata_list_get_size(
+	          list,
+	          &size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 128 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libfdata_list_set_element_value_at_offset(
-	          NULL,
+	result = libfdata_list_get_size(
 	          NULL,
+	          &size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_list_get_size(
+	          list,
 	          NULL,
-	          0,
-	          (intptr_t *) &value1,
-	          &fdata_test_list_element_value_free_function,
-	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -4394,20 +4953,41 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_list_get_size function
+/* Tests the libfdata_list_get_memory_usage function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_list_get_size(
+int fdata_test_list_get_memory_usage(
      void )
 {
-	libcerror_error_t *error = NULL;
-	libfdata_list_t *list    = NULL;
-	size64_t size            = 0;
-	int element_index        = 0;
-	int result               = 0;
+	libcerror_error_t *error    = NULL;
+	libfdata_cache_t *cache     = NULL;
+	libfdata_list_t *list       = NULL;
+	intptr_t *element_value     = NULL;
+	size64_t cached_values_size = 0;
+	size64_t structure_size     = 0;
+	int element_index           = 0;
+	int result                  = 0;
 
 	/* Initialize test
 	 */
+	result = libfdata_cache_initialize(
+	          &cache,
+	          16,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfdata_list_initialize(
 	          &list,
 	          NULL,
@@ -4451,9 +5031,11 @@ int fdata_test_list_get_size(
 
 	/* Test regular cases
 	 */
-	result = libfdata_list_get_size(
+	result = libfdata_list_get_memory_usage(
 	          list,
-	          &size,
+	          NULL,
+	          &structure_size,
+	          &cached_values_size,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -4461,20 +5043,96 @@ int fdata_test_list_get_size(
 	 result,
 	 1 );
 
+	FDATA_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "structure_size",
+	 (int64_t) structure_size,
+	 (int64_t) 0 );
+
 	FDATA_TEST_ASSERT_EQUAL_UINT64(
-	 "size",
-	 (uint64_t) size,
+	 "cached_values_size",
+	 (uint64_t) cached_values_size,
+	 (uint64_t) 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_get_memory_usage(
+	          list,
+	          cache,
+	          &structure_size,
+	          &cached_values_size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "cached_values_size",
+	 (uint64_t) cached_values_size,
+	 (uint64_t) 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_get_element_value_by_index(
+	          list,
+	          NULL,
+	          cache,
+	          0,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_list_get_memory_usage(
+	          list,
+	          cache,
+	          &structure_size,
+	          &cached_values_size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "cached_values_size",
+	 (uint64_t) cached_values_size,
 	 (uint64_t) 128 );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	memory_free(
+	 element_value );
+
+	element_value = NULL;
+
 	/* Test error cases
 	 */
-	result = libfdata_list_get_size(
+	result = libfdata_list_get_memory_usage(
 	          NULL,
-	          &size,
+	          cache,
+	          &structure_size,
+	          &cached_values_size,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -4489,8 +5147,29 @@ int fdata_test_list_get_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_list_get_size(
+	result = libfdata_list_get_memory_usage(
+	          list,
+	          cache,
+	          NULL,
+	          &cached_values_size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_list_get_memory_usage(
 	          list,
+	          cache,
+	          &structure_size,
 	          NULL,
 	          &error );
 
@@ -4525,6 +5204,23 @@ int fdata_test_list_get_size(
 	 "error",
 	 error );
 
+	result = libfdata_cache_free(
+	          &cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -4533,12 +5229,23 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( element_value != NULL )
+	{
+		memory_free(
+		 element_value );
+	}
 	if( list != NULL )
 	{
 		libfdata_list_free(
 		 &list,
 		 NULL );
 	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
 	return( 0 );
 }
 
@@ -4673,6 +5380,10 @@ int main(
 	 "libfdata_list_get_element_value_by_index",
 	 fdata_test_list_get_element_value_by_index );
 
+	FDATA_TEST_RUN(
+	 "libfdata_list_get_element_value_by_index_shared_cache",
+	 fdata_test_list_get_element_value_by_index_shared_cache );
+
 	FDATA_TEST_RUN(
 	 "libfdata_list_get_element_value_at_offset",
 	 fdata_test_list_get_element_value_at_offset );
@@ -4695,6 +5406,10 @@ int main(
 	 "libfdata_list_get_size",
 	 fdata_test_list_get_size );
 
+	FDATA_TEST_RUN(
+	 "libfdata_list_get_memory_usage",
+	 fdata_test_list_get_memory_usage );
+
 	return( EXIT_SUCCESS );
 
 on_error:
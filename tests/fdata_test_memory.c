@@ -29,12 +29,15 @@
 #define __USE_GNU
 #include <dlfcn.h>
 #undef __USE_GNU
+
+#include <malloc.h>
 #endif
 
 #include "fdata_test_memory.h"
 
 #if defined( HAVE_FDATA_TEST_MEMORY )
 
+static void (*fdata_test_real_free)(void *)                          = NULL;
 static void *(*fdata_test_real_malloc)(size_t)                       = NULL;
 static void *(*fdata_test_real_memcpy)(void *, const void *, size_t) = NULL;
 static void *(*fdata_test_real_memset)(void *, int, size_t)          = NULL;
@@ -45,7 +48,79 @@ int fdata_test_memcpy_attempts_before_fail                           = -1;
 int fdata_test_memset_attempts_before_fail                           = -1;
 int fdata_test_realloc_attempts_before_fail                          = -1;
 
-/* Custom malloc for testing memory error cases
+static fdata_test_memory_statistics_t fdata_test_memory_statistics;
+
+static int fdata_test_memory_statistics_enabled                      = 0;
+static int64_t fdata_test_memory_live_size                           = 0;
+
+/* Adds a change in the number of live bytes to the memory statistics
+ */
+static void fdata_test_memory_statistics_add_live_size(
+             int64_t size )
+{
+	fdata_test_memory_live_size += size;
+
+	if( ( fdata_test_memory_live_size > 0 )
+	 && ( (uint64_t) fdata_test_memory_live_size > fdata_test_memory_statistics.peak_live_size ) )
+	{
+		fdata_test_memory_statistics.peak_live_size = (uint64_t) fdata_test_memory_live_size;
+	}
+}
+
+/* Starts collecting memory statistics
+ * The allocation functions count the allocations until the statistics are stopped
+ */
+void fdata_test_memory_statistics_start(
+      void )
+{
+	fdata_test_memory_statistics.number_of_allocations   = 0;
+	fdata_test_memory_statistics.number_of_reallocations = 0;
+	fdata_test_memory_statistics.number_of_frees         = 0;
+	fdata_test_memory_statistics.allocated_size          = 0;
+	fdata_test_memory_statistics.peak_live_size          = 0;
+
+	fdata_test_memory_live_size          = 0;
+	fdata_test_memory_statistics_enabled = 1;
+}
+
+/* Stops collecting memory statistics and retrieves the statistics
+ * The live sizes are based on the usable size of the allocations
+ */
+void fdata_test_memory_statistics_stop(
+      fdata_test_memory_statistics_t *statistics )
+{
+	fdata_test_memory_statistics_enabled = 0;
+
+	if( statistics != NULL )
+	{
+		*statistics = fdata_test_memory_statistics;
+	}
+}
+
+/* Custom free for collecting memory statistics
+ */
+void free(
+      void *ptr )
+{
+	if( fdata_test_real_free == NULL )
+	{
+		fdata_test_real_free = dlsym(
+		                        RTLD_NEXT,
+		                        "free" );
+	}
+	if( ( fdata_test_memory_statistics_enabled != 0 )
+	 && ( ptr != NULL ) )
+	{
+		fdata_test_memory_statistics.number_of_frees += 1;
+
+		fdata_test_memory_statistics_add_live_size(
+		 -( (int64_t) malloc_usable_size( ptr ) ) );
+	}
+	fdata_test_real_free(
+	 ptr );
+}
+
+/* Custom malloc for testing memory error cases and collecting memory statistics
  * Note this function might fail if compiled with optimation
  * Returns a pointer to newly allocated data or NULL
  */
@@ -73,6 +148,15 @@ void *malloc(
 	ptr = fdata_test_real_malloc(
 	       size );
 
+	if( ( fdata_test_memory_statistics_enabled != 0 )
+	 && ( ptr != NULL ) )
+	{
+		fdata_test_memory_statistics.number_of_allocations += 1;
+		fdata_test_memory_statistics.allocated_size        += size;
+
+		fdata_test_memory_statistics_add_live_size(
+		 (int64_t) malloc_usable_size( ptr ) );
+	}
 	return( ptr );
 }
 
@@ -142,7 +226,7 @@ void *memset(
 	return( ptr );
 }
 
-/* Custom realloc for testing memory error cases
+/* Custom realloc for testing memory error cases and collecting memory statistics
  * Note this function might fail if compiled with optimation
  * Returns a pointer to reallocated data or NULL
  */
@@ -150,6 +234,9 @@ void *realloc(
        void *ptr,
        size_t size )
 {
+	void *reallocated_ptr = NULL;
+	size_t usable_size    = 0;
+
 	if( fdata_test_real_realloc == NULL )
 	{
 		fdata_test_real_realloc = dlsym(
@@ -166,11 +253,33 @@ void *realloc(
 	{
 		fdata_test_realloc_attempts_before_fail--;
 	}
-	ptr = fdata_test_real_realloc(
-	       ptr,
-	       size );
+	if( ( fdata_test_memory_statistics_enabled != 0 )
+	 && ( ptr != NULL ) )
+	{
+		usable_size = malloc_usable_size(
+		               ptr );
+	}
+	reallocated_ptr = fdata_test_real_realloc(
+	                   ptr,
+	                   size );
 
-	return( ptr );
+	if( ( fdata_test_memory_statistics_enabled != 0 )
+	 && ( reallocated_ptr != NULL ) )
+	{
+		if( ptr == NULL )
+		{
+			fdata_test_memory_statistics.number_of_allocations += 1;
+		}
+		else
+		{
+			fdata_test_memory_statistics.number_of_reallocations += 1;
+		}
+		fdata_test_memory_statistics.allocated_size += size;
+
+		fdata_test_memory_statistics_add_live_size(
+		 (int64_t) malloc_usable_size( reallocated_ptr ) - (int64_t) usable_size );
+	}
+	return( reallocated_ptr );
 }
 
 #endif /* defined( HAVE_FDATA_TEST_MEMORY ) */
@@ -23,6 +23,7 @@
 #define _FDATA_TEST_MEMORY_H
 
 #include <common.h>
+#include <types.h>
 
 #if defined( __cplusplus )
 extern "C" {
@@ -42,6 +43,38 @@ extern int fdata_test_memset_attempts_before_fail;
 
 extern int fdata_test_realloc_attempts_before_fail;
 
+typedef struct fdata_test_memory_statistics fdata_test_memory_statistics_t;
+
+struct fdata_test_memory_statistics
+{
+	/* The number of allocations
+	 */
+	uint64_t number_of_allocations;
+
+	/* The number of reallocations
+	 */
+	uint64_t number_of_reallocations;
+
+	/* The number of frees
+	 */
+	uint64_t number_of_frees;
+
+	/* The number of bytes requested to be allocated
+	 */
+	uint64_t allocated_size;
+
+	/* The peak number of bytes allocated and not freed
+	 * since the statistics were started
+	 */
+	uint64_t peak_live_size;
+};
+
+void fdata_test_memory_statistics_start(
+      void );
+
+void fdata_test_memory_statistics_stop(
+      fdata_test_memory_statistics_t *statistics );
+
 #endif /* defined( HAVE_FDATA_TEST_MEMORY ) */
 
 #if defined( __cplusplus )
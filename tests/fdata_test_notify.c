@@ -19,8 +19,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -32,6 +34,104 @@
 #include "fdata_test_macros.h"
 #include "fdata_test_unused.h"
 
+uint8_t fdata_test_notify_trace_record_data[ LIBFDATA_TRACE_RECORD_SIZE ];
+
+int fdata_test_notify_trace_number_of_records = 0;
+
+uint8_t fdata_test_notify_workload_record_data[ LIBFDATA_WORKLOAD_RECORD_SIZE ];
+
+int fdata_test_notify_workload_number_of_records = 0;
+
+/* Test trace function
+ */
+void fdata_test_notify_trace_function(
+      intptr_t *trace_data FDATA_TEST_ATTRIBUTE_UNUSED,
+      const uint8_t *record_data,
+      size_t record_data_size )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( trace_data )
+
+	if( record_data_size == LIBFDATA_TRACE_RECORD_SIZE )
+	{
+		memory_copy(
+		 fdata_test_notify_trace_record_data,
+		 record_data,
+		 LIBFDATA_TRACE_RECORD_SIZE );
+	}
+	fdata_test_notify_trace_number_of_records++;
+}
+
+/* Test workload function
+ */
+void fdata_test_notify_workload_function(
+      intptr_t *workload_data FDATA_TEST_ATTRIBUTE_UNUSED,
+      const uint8_t *record_data,
+      size_t record_data_size )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( workload_data )
+
+	if( record_data_size == LIBFDATA_WORKLOAD_RECORD_SIZE )
+	{
+		memory_copy(
+		 fdata_test_notify_workload_record_data,
+		 record_data,
+		 LIBFDATA_WORKLOAD_RECORD_SIZE );
+	}
+	fdata_test_notify_workload_number_of_records++;
+}
+
+/* Test read segment data function
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t fdata_test_notify_read_segment_data_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         uint32_t segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( memory_set(
+	     segment_data,
+	     0,
+	     segment_data_size ) == NULL )
+	{
+		return( -1 );
+	}
+	return( (ssize_t) segment_data_size );
+}
+
+/* Test seek segment offset function
+ * Returns the offset or -1 on error
+ */
+off64_t fdata_test_notify_seek_segment_offset_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         off64_t segment_offset,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	return( segment_offset );
+}
+
 /* Tests the libfdata_notify_set_verbose function
  * Returns 1 if successful or 0 if not
  */
@@ -190,6 +290,478 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfdata_notify_set_trace_function function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_notify_set_trace_function(
+     void )
+{
+	uint8_t data[ 16 ];
+
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	uint64_t value_64bit      = 0;
+	uint32_t value_32bit      = 0;
+	ssize_t read_count        = 0;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &fdata_test_notify_read_segment_data_function,
+	          NULL,
+	          &fdata_test_notify_seek_segment_offset_function,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          2,
+	          512,
+	          64,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	fdata_test_notify_trace_number_of_records = 0;
+
+	libfdata_notify_set_trace_function(
+	 &fdata_test_notify_trace_function,
+	 NULL );
+
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              data,
+	              16,
+	              0,
+	              &error );
+
+	libfdata_notify_set_trace_function(
+	 NULL,
+	 NULL );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A seek and a read are traced
+	 */
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_notify_trace_number_of_records",
+	 fdata_test_notify_trace_number_of_records,
+	 2 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "container_type",
+	 fdata_test_notify_trace_record_data[ 0 ],
+	 (uint8_t) LIBFDATA_TRACE_CONTAINER_TYPE_STREAM );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "operation",
+	 fdata_test_notify_trace_record_data[ 1 ],
+	 (uint8_t) LIBFDATA_TRACE_OPERATION_READ );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "flags",
+	 fdata_test_notify_trace_record_data[ 2 ],
+	 (uint8_t) 0 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( fdata_test_notify_trace_record_data[ 8 ] ),
+	 value_32bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "file_index",
+	 value_32bit,
+	 (uint32_t) 2 );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( fdata_test_notify_trace_record_data[ 12 ] ),
+	 value_64bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "offset",
+	 value_64bit,
+	 (uint64_t) 512 );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( fdata_test_notify_trace_record_data[ 20 ] ),
+	 value_64bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 value_64bit,
+	 (uint64_t) 16 );
+
+	/* Reads are not traced after the trace function was unset
+	 */
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              data,
+	              16,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_notify_trace_number_of_records",
+	 fdata_test_notify_trace_number_of_records,
+	 2 );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	libfdata_notify_set_trace_function(
+	 NULL,
+	 NULL );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_notify_set_workload_function function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_notify_set_workload_function(
+     void )
+{
+	uint8_t data[ 16 ];
+
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	uint64_t value_64bit      = 0;
+	ssize_t read_count        = 0;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	fdata_test_notify_workload_number_of_records = 0;
+
+	libfdata_notify_set_workload_function(
+	 &fdata_test_notify_workload_function,
+	 NULL );
+
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &fdata_test_notify_read_segment_data_function,
+	          NULL,
+	          &fdata_test_notify_seek_segment_offset_function,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          2,
+	          512,
+	          64,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              stream,
+	              NULL,
+	              data,
+	              16,
+	              8,
+	              0,
+	              &error );
+
+	libfdata_notify_set_workload_function(
+	 NULL,
+	 NULL );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The initialize, append segment, seek offset and read buffer calls are recorded
+	 */
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_notify_workload_number_of_records",
+	 fdata_test_notify_workload_number_of_records,
+	 4 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "container_type",
+	 fdata_test_notify_workload_record_data[ 0 ],
+	 (uint8_t) LIBFDATA_TRACE_CONTAINER_TYPE_STREAM );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "call",
+	 fdata_test_notify_workload_record_data[ 1 ],
+	 (uint8_t) LIBFDATA_WORKLOAD_CALL_READ_BUFFER );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( fdata_test_notify_workload_record_data[ 12 ] ),
+	 value_64bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "offset",
+	 value_64bit,
+	 (uint64_t) 8 );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( fdata_test_notify_workload_record_data[ 20 ] ),
+	 value_64bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 value_64bit,
+	 (uint64_t) 16 );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( fdata_test_notify_workload_record_data[ 28 ] ),
+	 value_64bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "identifier",
+	 value_64bit,
+	 (uint64_t) (intptr_t) stream );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Calls are not recorded after the workload function was unset
+	 */
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_notify_workload_number_of_records",
+	 fdata_test_notify_workload_number_of_records,
+	 4 );
+
+	return( 1 );
+
+on_error:
+	libfdata_notify_set_workload_function(
+	 NULL,
+	 NULL );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_notify_workload_open and libfdata_notify_workload_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_notify_workload_open(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfdata_notify_workload_open(
+	          "notify_workload.bin",
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_notify_workload_open(
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test workload stream value already set
+	 */
+	result = libfdata_notify_workload_open(
+	          "notify_workload.bin",
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_notify_workload_close(
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libfdata_notify_workload_close(
+	 NULL );
+
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -221,6 +793,18 @@ int main(
 	 "libfdata_notify_stream_close",
 	 fdata_test_notify_stream_close )
 
+	FDATA_TEST_RUN(
+	 "libfdata_notify_set_trace_function",
+	 fdata_test_notify_set_trace_function )
+
+	FDATA_TEST_RUN(
+	 "libfdata_notify_set_workload_function",
+	 fdata_test_notify_set_workload_function )
+
+	FDATA_TEST_RUN(
+	 "libfdata_notify_workload_open",
+	 fdata_test_notify_workload_open )
+
 	return( EXIT_SUCCESS );
 
 on_error:
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -38,6 +39,20 @@
 int fdata_test_stream_data_handle_free_function_return_value   = 1;
 int fdata_test_stream_data_handle_clone_function_return_value  = 1;
 int fdata_test_stream_element_value_free_function_return_value = 1;
+int fdata_test_stream_number_of_create_segment_run_calls       = 0;
+int fdata_test_stream_number_of_read_calls                     = 0;
+int fdata_test_stream_number_of_read_batch_calls               = 0;
+int fdata_test_stream_number_of_batch_segment_reads            = 0;
+int fdata_test_stream_number_of_write_calls                    = 0;
+off64_t fdata_test_stream_aligned_segment_offset               = 0;
+off64_t fdata_test_stream_backing_data_offset                  = 0;
+int fdata_test_stream_maximum_number_of_matches                = 0;
+int fdata_test_stream_number_of_matches                        = 0;
+
+off64_t fdata_test_stream_match_offsets[ 4 ];
+int fdata_test_stream_match_pattern_indexes[ 4 ];
+
+uint8_t fdata_test_stream_backing_data[ 4096 ];
 
 /* Test data handle free function
  * Returns 1 if successful or -1 on error
@@ -80,6 +95,391 @@ int fdata_test_stream_element_value_free_function(
 	return( fdata_test_stream_element_value_free_function_return_value );
 }
 
+/* Test read segment data function
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t fdata_test_stream_read_segment_data_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         uint32_t segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	fdata_test_stream_number_of_read_calls++;
+
+	if( memory_set(
+	     segment_data,
+	     0,
+	     segment_data_size ) == NULL )
+	{
+		return( -1 );
+	}
+	return( (ssize_t) segment_data_size );
+}
+
+/* Test seek segment offset function
+ * Returns the offset or -1 on error
+ */
+off64_t fdata_test_stream_seek_segment_offset_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         off64_t segment_offset,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	return( segment_offset );
+}
+
+/* Test read segment data batch function
+ * Fills the data of every segment read with its segment index + 1
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_stream_read_segment_data_batch_function(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     int number_of_segment_reads,
+     int *segment_indexes,
+     int *segment_file_indexes FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t *segment_offsets FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t **segment_data,
+     size_t *segment_data_sizes,
+     uint32_t *segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	int segment_read_index = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_indexes )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_offsets )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	fdata_test_stream_number_of_read_batch_calls++;
+
+	for( segment_read_index = 0;
+	     segment_read_index < number_of_segment_reads;
+	     segment_read_index++ )
+	{
+		if( memory_set(
+		     segment_data[ segment_read_index ],
+		     segment_indexes[ segment_read_index ] + 1,
+		     segment_data_sizes[ segment_read_index ] ) == NULL )
+		{
+			return( -1 );
+		}
+		fdata_test_stream_number_of_batch_segment_reads++;
+	}
+	return( 1 );
+}
+
+/* Test read aligned segment data function
+ * Fails if the data or its size are not aligned to 512 bytes
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t fdata_test_stream_read_aligned_segment_data_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         uint32_t segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	size_t data_offset = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( ( ( segment_data_size % 512 ) != 0 )
+	 || ( ( (size_t) ( (intptr_t) segment_data ) % 512 ) != 0 ) )
+	{
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < segment_data_size;
+	     data_offset++ )
+	{
+		segment_data[ data_offset ] = (uint8_t) ( fdata_test_stream_aligned_segment_offset + data_offset );
+	}
+	fdata_test_stream_aligned_segment_offset += segment_data_size;
+
+	return( (ssize_t) segment_data_size );
+}
+
+/* Test seek aligned segment offset function
+ * Fails if the offset is not aligned to 512 bytes
+ * Returns the offset or -1 on error
+ */
+off64_t fdata_test_stream_seek_aligned_segment_offset_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         off64_t segment_offset,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( ( segment_offset % 512 ) != 0 )
+	{
+		return( -1 );
+	}
+	fdata_test_stream_aligned_segment_offset = segment_offset;
+
+	return( segment_offset );
+}
+
+/* Test create segment function
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_stream_create_segment_function(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     int segment_index,
+     int *segment_file_index,
+     off64_t *segment_offset,
+     size64_t *segment_size,
+     uint32_t *segment_flags,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	*segment_file_index = 0;
+	*segment_offset     = (off64_t) segment_index * 2048;
+	*segment_size       = 2048;
+	*segment_flags      = 0;
+
+	return( 1 );
+}
+
+/* Test create segment run function
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_stream_create_segment_run_function(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     int segment_index,
+     int maximum_number_of_segments,
+     int *segment_file_index,
+     off64_t *segment_offset,
+     size64_t *segment_size,
+     uint32_t *segment_flags,
+     int *number_of_segments,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	fdata_test_stream_number_of_create_segment_run_calls++;
+
+	*segment_file_index = 0;
+	*segment_offset     = (off64_t) segment_index * 512;
+	*segment_size       = 512;
+	*segment_flags      = 0;
+	*number_of_segments = maximum_number_of_segments;
+
+	return( 1 );
+}
+
+/* Test write segment data function
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t fdata_test_stream_write_segment_data_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         const uint8_t *segment_data FDATA_TEST_ATTRIBUTE_UNUSED,
+         size_t segment_data_size,
+         uint32_t segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t write_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_data )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( write_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	fdata_test_stream_number_of_write_calls++;
+
+	return( (ssize_t) segment_data_size );
+}
+
+/* Test seek backing data function
+ * Returns the offset or -1 on error
+ */
+off64_t fdata_test_stream_seek_backing_data_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         off64_t segment_offset,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( ( segment_offset < 0 )
+	 || ( segment_offset > 4096 ) )
+	{
+		return( -1 );
+	}
+	fdata_test_stream_backing_data_offset = segment_offset;
+
+	return( segment_offset );
+}
+
+/* Test read backing data function
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t fdata_test_stream_read_backing_data_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         uint32_t segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( segment_data_size > (size_t) ( 4096 - fdata_test_stream_backing_data_offset ) )
+	{
+		return( -1 );
+	}
+	fdata_test_stream_number_of_read_calls++;
+
+	if( memory_copy(
+	     segment_data,
+	     &( fdata_test_stream_backing_data[ fdata_test_stream_backing_data_offset ] ),
+	     segment_data_size ) == NULL )
+	{
+		return( -1 );
+	}
+	fdata_test_stream_backing_data_offset += (off64_t) segment_data_size;
+
+	return( (ssize_t) segment_data_size );
+}
+
+/* Test write backing data function
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t fdata_test_stream_write_backing_data_function(
+         intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         intptr_t *file_io_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         int segment_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+         const uint8_t *segment_data,
+         size_t segment_data_size,
+         uint32_t segment_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         uint8_t write_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( file_io_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( segment_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( write_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( segment_data_size > (size_t) ( 4096 - fdata_test_stream_backing_data_offset ) )
+	{
+		return( -1 );
+	}
+	fdata_test_stream_number_of_write_calls++;
+
+	if( memory_copy(
+	     &( fdata_test_stream_backing_data[ fdata_test_stream_backing_data_offset ] ),
+	     segment_data,
+	     segment_data_size ) == NULL )
+	{
+		return( -1 );
+	}
+	fdata_test_stream_backing_data_offset += (off64_t) segment_data_size;
+
+	return( (ssize_t) segment_data_size );
+}
+
+/* Test match callback function
+ * Returns 1 to continue, 0 to stop or -1 on error
+ */
+int fdata_test_stream_match_callback_function(
+     intptr_t *callback_data FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t match_offset,
+     int pattern_index,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( callback_data )
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( fdata_test_stream_number_of_matches >= 4 )
+	{
+		return( -1 );
+	}
+	fdata_test_stream_match_offsets[ fdata_test_stream_number_of_matches ]         = match_offset;
+	fdata_test_stream_match_pattern_indexes[ fdata_test_stream_number_of_matches ] = pattern_index;
+
+	fdata_test_stream_number_of_matches++;
+
+	if( fdata_test_stream_number_of_matches >= fdata_test_stream_maximum_number_of_matches )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Tests the libfdata_stream_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -368,7 +768,9 @@ int fdata_test_stream_clone(
 	libcerror_error_t *error              = NULL;
 	libfdata_stream_t *destination_stream = NULL;
 	libfdata_stream_t *source_stream      = NULL;
+	int number_of_segments                = 0;
 	int result                            = 0;
+	int segment_index                     = 0;
 
 	/* Initialize test
 	 */
@@ -417,6 +819,64 @@ int fdata_test_stream_clone(
 	 "error",
 	 error );
 
+	/* Test that changing the destination stream does not change the source stream
+	 */
+	result = libfdata_stream_append_segment(
+	          destination_stream,
+	          &segment_index,
+	          0,
+	          0,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_number_of_segments(
+	          destination_stream,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_number_of_segments(
+	          source_stream,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfdata_stream_free(
 	          &destination_stream,
 	          &error );
@@ -618,15 +1078,24 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_empty function
+/* Tests the libfdata_stream_initialize_slice function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_empty(
+int fdata_test_stream_initialize_slice(
      void )
 {
-	libcerror_error_t *error  = NULL;
-	libfdata_stream_t *stream = NULL;
-	int result                = 0;
+	libcerror_error_t *error         = NULL;
+	libfdata_stream_t *nested_stream = NULL;
+	libfdata_stream_t *slice_stream  = NULL;
+	libfdata_stream_t *stream        = NULL;
+	off64_t extent_offset            = 0;
+	off64_t offset                   = 0;
+	size64_t extent_size             = 0;
+	size64_t size                    = 0;
+	uint32_t extent_flags            = 0;
+	int extent_file_index            = 0;
+	int result                       = 0;
+	int segment_index                = 0;
 
 	/* Initialize test
 	 */
@@ -655,10 +1124,13 @@ int fdata_test_stream_empty(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	result = libfdata_stream_empty(
+	result = libfdata_stream_append_segment(
 	          stream,
+	          &segment_index,
+	          0,
+	          0,
+	          1024,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -670,28 +1142,49 @@ int fdata_test_stream_empty(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libfdata_stream_empty(
-	          NULL,
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          1024,
+	          1024,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          2048,
+	          1024,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
 
-	/* Clean up
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
 	 */
-	result = libfdata_stream_free(
-	          &stream,
+	result = libfdata_stream_initialize_slice(
+	          &slice_stream,
+	          stream,
+	          1536,
+	          1024,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -699,17 +1192,4585 @@ int fdata_test_stream_empty(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
-	 "stream",
-	 stream );
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "slice_stream",
+	 slice_stream );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	return( 1 );
+	result = libfdata_stream_get_size(
+	          slice_stream,
+	          &size,
+	          &error );
 
-on_error:
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 size,
+	 (uint64_t) 1024 );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          slice_stream,
+	          0,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 1536 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 512 );
+
+	result = libfdata_stream_get_hole_offset(
+	          slice_stream,
+	          0,
+	          &offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 512 );
+
+	result = libfdata_stream_get_data_offset(
+	          slice_stream,
+	          512,
+	          &offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libfdata_stream_seek_offset(
+	          slice_stream,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 1024 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_set_mapped_size(
+	          slice_stream,
+	          512,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a slice of a slice
+	 */
+	result = libfdata_stream_initialize_slice(
+	          &nested_stream,
+	          slice_stream,
+	          256,
+	          512,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "nested_stream",
+	 nested_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          nested_stream,
+	          0,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 1792 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 256 );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          nested_stream,
+	          256,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 2048 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 256 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 (uint32_t) LIBFDATA_RANGE_FLAG_IS_SPARSE );
+
+	result = libfdata_stream_free(
+	          &nested_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_initialize_slice(
+	          NULL,
+	          stream,
+	          0,
+	          1024,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_initialize_slice(
+	          &slice_stream,
+	          stream,
+	          0,
+	          1024,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_initialize_slice(
+	          &nested_stream,
+	          NULL,
+	          0,
+	          1024,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_initialize_slice(
+	          &nested_stream,
+	          stream,
+	          -1,
+	          1024,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_initialize_slice(
+	          &nested_stream,
+	          stream,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_initialize_slice(
+	          &nested_stream,
+	          slice_stream,
+	          512,
+	          1024,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &slice_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "slice_stream",
+	 slice_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( nested_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &nested_stream,
+		 NULL );
+	}
+	if( slice_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &slice_stream,
+		 NULL );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_initialize_composed function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_initialize_composed(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libfdata_stream_t *composed_stream = NULL;
+	libfdata_stream_t *lower_stream    = NULL;
+	libfdata_stream_t *upper_stream    = NULL;
+	off64_t segment_offset             = 0;
+	size64_t segment_size              = 0;
+	size64_t size                      = 0;
+	uint32_t segment_flags             = 0;
+	int number_of_segments             = 0;
+	int result                         = 0;
+	int segment_file_index             = 0;
+	int segment_index                  = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &lower_stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "lower_stream",
+	 lower_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          lower_stream,
+	          &segment_index,
+	          0,
+	          4096,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          lower_stream,
+	          &segment_index,
+	          0,
+	          5120,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          lower_stream,
+	          &segment_index,
+	          1,
+	          0,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_initialize(
+	          &upper_stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "upper_stream",
+	 upper_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          upper_stream,
+	          &segment_index,
+	          0,
+	          512,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          upper_stream,
+	          &segment_index,
+	          0,
+	          1536,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          upper_stream,
+	          &segment_index,
+	          0,
+	          0,
+	          512,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_initialize_composed(
+	          &composed_stream,
+	          upper_stream,
+	          lower_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "composed_stream",
+	 composed_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_size(
+	          composed_stream,
+	          &size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 size,
+	 (uint64_t) 2560 );
+
+	result = libfdata_stream_get_number_of_segments(
+	          composed_stream,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 3 );
+
+	result = libfdata_stream_get_segment_by_index(
+	          composed_stream,
+	          0,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "segment_file_index",
+	 segment_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "segment_offset",
+	 (int64_t) segment_offset,
+	 (int64_t) 4608 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_size",
+	 segment_size,
+	 (uint64_t) 1536 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_flags",
+	 segment_flags,
+	 (uint32_t) 0 );
+
+	result = libfdata_stream_get_segment_by_index(
+	          composed_stream,
+	          1,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "segment_file_index",
+	 segment_file_index,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "segment_offset",
+	 (int64_t) segment_offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_size",
+	 segment_size,
+	 (uint64_t) 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_flags",
+	 segment_flags,
+	 (uint32_t) 0 );
+
+	result = libfdata_stream_get_segment_by_index(
+	          composed_stream,
+	          2,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "segment_file_index",
+	 segment_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "segment_offset",
+	 (int64_t) segment_offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_size",
+	 segment_size,
+	 (uint64_t) 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_flags",
+	 segment_flags,
+	 (uint32_t) LIBFDATA_RANGE_FLAG_IS_SPARSE );
+
+	result = libfdata_stream_free(
+	          &composed_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "composed_stream",
+	 composed_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_initialize_composed(
+	          NULL,
+	          upper_stream,
+	          lower_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_initialize_composed(
+	          &composed_stream,
+	          NULL,
+	          lower_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_initialize_composed(
+	          &composed_stream,
+	          upper_stream,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfdata_stream_initialize_composed with an upper segment beyond the end of the lower stream
+	 */
+	result = libfdata_stream_append_segment(
+	          upper_stream,
+	          &segment_index,
+	          0,
+	          2560,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_initialize_composed(
+	          &composed_stream,
+	          upper_stream,
+	          lower_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "composed_stream",
+	 composed_stream );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &upper_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "upper_stream",
+	 upper_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_free(
+	          &lower_stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "lower_stream",
+	 lower_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( composed_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &composed_stream,
+		 NULL );
+	}
+	if( upper_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &upper_stream,
+		 NULL );
+	}
+	if( lower_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &lower_stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_empty function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_empty(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_empty(
+	          stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_empty(
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_resize function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_resize(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_resize(
+	          stream,
+	          10,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_resize(
+	          NULL,
+	          10,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_resize(
+	          stream,
+	          -1,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_get_number_of_segments function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_get_number_of_segments(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int number_of_segments    = 0;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_number_of_segments(
+	          stream,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_number_of_segments(
+	          stream,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_number_of_segments(
+	          NULL,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_number_of_segments(
+	          stream,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_get_segment_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_get_segment_by_index(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	size64_t segment_size     = 0;
+	off64_t segment_offset    = 0;
+	uint32_t segment_flags    = 0;
+	int result                = 0;
+	int segment_file_index    = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_segment_by_index(
+	          stream,
+	          0,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "segment_file_index",
+	 segment_file_index,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "segment_offset",
+	 (int64_t) segment_offset,
+	 (int64_t) 1024 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_size",
+	 (uint64_t) segment_size,
+	 (uint64_t) 2048 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_flags",
+	 (uint32_t) segment_flags,
+	 (uint32_t) 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_segment_by_index(
+	          NULL,
+	          0,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_segment_by_index(
+	          stream,
+	          -1,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_set_segment_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_set_segment_by_index(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_resize(
+	          stream,
+	          1,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_set_segment_by_index(
+	          stream,
+	          0,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_set_segment_by_index(
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_set_segment_by_index(
+	          stream,
+	          -1,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_prepend_segment function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_prepend_segment(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_prepend_segment(
+	          stream,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_prepend_segment(
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_append_segment function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_append_segment(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_append_segment(
+	          NULL,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          NULL,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_set_mapped_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_set_mapped_size(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_set_mapped_size(
+	          stream,
+	          512,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_set_mapped_size(
+	          NULL,
+	          512,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_set_mapped_size(
+	          stream,
+	          4096,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_set_create_segment_run_function function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_set_create_segment_run_function(
+     void )
+{
+	uint8_t buffer[ 1536 ];
+
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	size64_t size             = 0;
+	ssize_t write_count       = 0;
+	int number_of_segments    = 0;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          &fdata_test_stream_read_segment_data_function,
+	          &fdata_test_stream_write_segment_data_function,
+	          &fdata_test_stream_seek_segment_offset_function,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_set(
+	          buffer,
+	          0,
+	          1536 ) != NULL;
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_set_create_segment_run_function(
+	          stream,
+	          &fdata_test_stream_create_segment_run_function,
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fdata_test_stream_number_of_create_segment_run_calls = 0;
+
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               buffer,
+	               512,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 512 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_create_segment_run_calls",
+	 fdata_test_stream_number_of_create_segment_run_calls,
+	 1 );
+
+	/* Test that only the segments used by the write are appended
+	 */
+	result = libfdata_stream_get_number_of_segments(
+	          stream,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 2 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_size(
+	          stream,
+	          &size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 size,
+	 (uint64_t) 1024 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               buffer,
+	               1536,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 1536 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_create_segment_run_calls",
+	 fdata_test_stream_number_of_create_segment_run_calls,
+	 2 );
+
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               buffer,
+	               512,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 512 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_create_segment_run_calls",
+	 fdata_test_stream_number_of_create_segment_run_calls,
+	 2 );
+
+	result = libfdata_stream_get_number_of_segments(
+	          stream,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 6 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_set_create_segment_run_function(
+	          NULL,
+	          &fdata_test_stream_create_segment_run_function,
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_set_create_segment_run_function(
+	          stream,
+	          &fdata_test_stream_create_segment_run_function,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_get_segment_mapped_range function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_get_segment_mapped_range(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libfdata_stream_t *stream   = NULL;
+	size64_t mapped_range_size  = 0;
+	off64_t mapped_range_offset = 0;
+	int result                  = 0;
+	int segment_index           = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_segment_mapped_range(
+	          stream,
+	          0,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "mapped_range_offset",
+	 (int64_t) mapped_range_offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "mapped_range_size",
+	 (uint64_t) mapped_range_size,
+	 (uint64_t) 2048 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_segment_mapped_range(
+	          NULL,
+	          0,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_segment_mapped_range(
+	          stream,
+	          -1,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_segment_mapped_range(
+	          stream,
+	          0,
+	          NULL,
+	          &mapped_range_size,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_get_segment_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_get_segment_index_at_offset(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libfdata_stream_t *stream   = NULL;
+	off64_t segment_data_offset = 0;
+	int result                  = 0;
+	int segment_index           = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_segment_index_at_offset(
+	          stream,
+	          0,
+	          &segment_index,
+	          &segment_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "segment_index",
+	 segment_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "segment_data_offset",
+	 (int64_t) segment_data_offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#ifdef TODO
+/* TODO fix libfdata_stream_get_segment_index_at_offset
+ * libcdata_array_get_entry_by_index: invalid entry index value out of bounds.
+ */
+	result = libfdata_stream_get_segment_index_at_offset(
+	          stream,
+	          4096,
+	          &segment_index,
+	          &segment_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#endif
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_segment_index_at_offset(
+	          NULL,
+	          0,
+	          &segment_index,
+	          &segment_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_segment_index_at_offset(
+	          stream,
+	          -1,
+	          &segment_index,
+	          &segment_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_segment_index_at_offset(
+	          stream,
+	          0,
+	          NULL,
+	          &segment_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_segment_index_at_offset(
+	          stream,
+	          0,
+	          &segment_index,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_get_segment_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_get_segment_at_offset(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libfdata_stream_t *stream   = NULL;
+	size64_t segment_size       = 0;
+	off64_t segment_data_offset = 0;
+	off64_t segment_offset      = 0;
+	uint32_t segment_flags      = 0;
+	int result                  = 0;
+	int segment_file_index      = 0;
+	int segment_index           = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_segment_at_offset(
+	          stream,
+	          0,
+	          &segment_index,
+	          &segment_data_offset,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "segment_index",
+	 segment_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "segment_data_offset",
+	 (int64_t) segment_data_offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "segment_file_index",
+	 segment_file_index,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "segment_offset",
+	 (int64_t) segment_offset,
+	 (int64_t) 1024 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_size",
+	 (uint64_t) segment_size,
+	 (uint64_t) 2048 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_flags",
+	 (uint32_t) segment_flags,
+	 (uint32_t) 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#ifdef TODO
+/* TODO fix libfdata_stream_get_segment_at_offset
+ * libcdata_array_get_entry_by_index: invalid entry index value out of bounds.
+ */
+	result = libfdata_stream_get_segment_at_offset(
+	          stream,
+	          4096,
+	          &segment_index,
+	          &segment_data_offset,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#endif
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_segment_at_offset(
+	          NULL,
+	          0,
+	          &segment_index,
+	          &segment_data_offset,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_segment_at_offset(
+	          stream,
+	          -1,
+	          &segment_index,
+	          &segment_data_offset,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_segment_at_offset(
+	          stream,
+	          0,
+	          NULL,
+	          &segment_data_offset,
+	          &segment_file_index,
+	          &segment_offset,
+	          &segment_size,
+	          &segment_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_get_data_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_get_data_offset(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	off64_t data_offset       = 0;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          0,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          1024,
+	          2048,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          3072,
+	          512,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          3584,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          4608,
+	          512,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_data_offset(
+	          stream,
+	          0,
+	          &data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "data_offset",
+	 (int64_t) data_offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_data_offset(
+	          stream,
+	          1500,
+	          &data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "data_offset",
+	 (int64_t) data_offset,
+	 (int64_t) 3584 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_data_offset(
+	          stream,
+	          4700,
+	          &data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_data_offset(
+	          stream,
+	          5120,
+	          &data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_data_offset(
+	          NULL,
+	          0,
+	          &data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_data_offset(
+	          stream,
+	          -1,
+	          &data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_data_offset(
+	          stream,
+	          0,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_get_hole_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_get_hole_offset(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	off64_t hole_offset       = 0;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          0,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          1024,
+	          2048,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          3072,
+	          512,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          3584,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          4608,
+	          512,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_hole_offset(
+	          stream,
+	          0,
+	          &hole_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "hole_offset",
+	 (int64_t) hole_offset,
+	 (int64_t) 1024 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_hole_offset(
+	          stream,
+	          1500,
+	          &hole_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "hole_offset",
+	 (int64_t) hole_offset,
+	 (int64_t) 1500 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_hole_offset(
+	          stream,
+	          3600,
+	          &hole_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "hole_offset",
+	 (int64_t) hole_offset,
+	 (int64_t) 4608 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_hole_offset(
+	          stream,
+	          5120,
+	          &hole_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the end of the mapped stream is considered a hole
+	 */
+	result = libfdata_stream_set_mapped_size(
+	          stream,
+	          4096,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_hole_offset(
+	          stream,
+	          3600,
+	          &hole_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "hole_offset",
+	 (int64_t) hole_offset,
+	 (int64_t) 4096 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_hole_offset(
+	          NULL,
+	          0,
+	          &hole_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_hole_offset(
+	          stream,
+	          -1,
+	          &hole_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_hole_offset(
+	          stream,
+	          0,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_get_extent_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_get_extent_at_offset(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	off64_t extent_offset     = 0;
+	size64_t extent_size      = 0;
+	uint32_t extent_flags     = 0;
+	int extent_file_index     = 0;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          0,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          1024,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          4096,
+	          512,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          2048,
+	          512,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          8192,
+	          512,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          16384,
+	          512,
+	          LIBFDATA_RANGE_FLAG_IS_SPARSE,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          0,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 2048 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 (uint32_t) 0 );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          512,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 1536 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 (uint32_t) 0 );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          512,
+	          100,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 100 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 (uint32_t) 0 );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          2048,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 4096 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 (uint32_t) 0 );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          2560,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 2048 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 (uint32_t) 0 );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          3072,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 8192 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 1024 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 (uint32_t) LIBFDATA_RANGE_FLAG_IS_SPARSE );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          4096,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the extent is limited to the mapped size
+	 */
+	result = libfdata_stream_set_mapped_size(
+	          stream,
+	          3300,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          3072,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "extent_file_index",
+	 extent_file_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 8192 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 228 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "extent_flags",
+	 extent_flags,
+	 (uint32_t) LIBFDATA_RANGE_FLAG_IS_SPARSE );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_extent_at_offset(
+	          NULL,
+	          0,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          -1,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          0,
+	          4096,
+	          NULL,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          0,
+	          4096,
+	          &extent_file_index,
+	          NULL,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          0,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          NULL,
+	          &extent_flags,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_extent_at_offset(
+	          stream,
+	          0,
+	          4096,
+	          &extent_file_index,
+	          &extent_offset,
+	          &extent_size,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_read_buffer(
+     void )
+{
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_read_buffer(
+	          NULL,
+	          NULL,
+	          data,
+	          32,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffer(
+	          stream,
+	          NULL,
+	          NULL,
+	          32,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffer(
+	          stream,
+	          NULL,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream != NULL )
+	{
+		libfdata_stream_free(
+		 &stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_stream_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_stream_read_buffer_at_offset(
+     void )
+{
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_read_buffer_at_offset(
+	          NULL,
+	          NULL,
+	          data,
+	          32,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffer_at_offset(
+	          stream,
+	          NULL,
+	          NULL,
+	          32,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffer_at_offset(
+	          stream,
+	          NULL,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffer_at_offset(
+	          stream,
+	          NULL,
+	          data,
+	          32,
+	          -1,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_stream_free(
+	          &stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
 	if( error != NULL )
 	{
 		libcerror_error_free(
@@ -724,64 +5785,279 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_resize function
+/* Tests the libfdata_stream_read_buffers_at_offsets function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_resize(
+int fdata_test_stream_read_buffers_at_offsets(
      void )
 {
+	uint8_t buffer1[ 512 ];
+	uint8_t buffer2[ 128 ];
+	uint8_t buffer3[ 32 ];
+
+	uint8_t *buffers[ 3 ]     = { buffer1, buffer2, buffer3 };
+	size_t buffer_sizes[ 3 ]  = { 512, 128, 32 };
+	off64_t offsets[ 3 ]      = { 768, 1984, 4096 };
+	ssize_t read_counts[ 3 ]  = { 0, 0, 0 };
 	libcerror_error_t *error  = NULL;
 	libfdata_stream_t *stream = NULL;
+	off64_t offset            = 0;
 	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_stream_initialize(
+	          &stream,
+	          NULL,
+	          &fdata_test_stream_data_handle_free_function,
+	          &fdata_test_stream_data_handle_clone_function,
+	          NULL,
+	          &fdata_test_stream_read_segment_data_function,
+	          NULL,
+	          &fdata_test_stream_seek_segment_offset_function,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "stream",
+	 stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          0,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          2048,
+	          1024,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	fdata_test_stream_number_of_read_calls = 0;
+
+	result = libfdata_stream_read_buffers_at_offsets(
+	          stream,
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 0 ]",
+	 read_counts[ 0 ],
+	 (ssize_t) 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 1 ]",
+	 read_counts[ 1 ],
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 2 ]",
+	 read_counts[ 2 ],
+	 (ssize_t) 0 );
+
+	/* Test that the read spanning 2 segments results in 2 segment reads
+	 */
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_calls",
+	 fdata_test_stream_number_of_read_calls,
+	 3 );
+
+	/* Test that the current offset is not changed
+	 */
+	result = libfdata_stream_get_offset(
+	          stream,
+	          &offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_read_buffers_at_offsets(
+	          stream,
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          0,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* Initialize test
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
 	 */
-	result = libfdata_stream_initialize(
-	          &stream,
-	          NULL,
-	          &fdata_test_stream_data_handle_free_function,
-	          &fdata_test_stream_data_handle_clone_function,
+	result = libfdata_stream_read_buffers_at_offsets(
 	          NULL,
 	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffers_at_offsets(
+	          stream,
 	          NULL,
 	          NULL,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
 	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "stream",
-	 stream );
+	 "error",
+	 error );
 
-	FDATA_TEST_ASSERT_IS_NULL(
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffers_at_offsets(
+	          stream,
+	          NULL,
+	          buffers,
+	          NULL,
+	          offsets,
+	          read_counts,
+	          3,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	result = libfdata_stream_resize(
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffers_at_offsets(
 	          stream,
-	          10,
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          NULL,
+	          read_counts,
+	          3,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libfdata_stream_resize(
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_read_buffers_at_offsets(
+	          stream,
 	          NULL,
-	          10,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          NULL,
+	          3,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -796,11 +6072,44 @@ int fdata_test_stream_resize(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_resize(
+	result = libfdata_stream_read_buffers_at_offsets(
 	          stream,
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
 	          -1,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 1 ] = -1;
+
+	result = libfdata_stream_read_buffers_at_offsets(
+	          stream,
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
+	          0,
 	          &error );
 
+	offsets[ 1 ] = 1984;
+
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -849,17 +6158,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_get_number_of_segments function
+/* Tests the libfdata_stream_find_patterns function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_get_number_of_segments(
+int fdata_test_stream_find_patterns(
      void )
 {
-	libcerror_error_t *error  = NULL;
-	libfdata_stream_t *stream = NULL;
-	int number_of_segments    = 0;
-	int result                = 0;
-	int segment_index         = 0;
+	uint8_t pattern1[ 3 ]        = { 0x02, 0x02, 0x03 };
+	uint8_t pattern2[ 2 ]        = { 0x01, 0x02 };
+	const uint8_t *patterns[ 2 ] = { pattern1, pattern2 };
+	size_t pattern_sizes[ 2 ]    = { 3, 2 };
+	libcerror_error_t *error     = NULL;
+	libfdata_stream_t *stream    = NULL;
+	off64_t match_offset         = 0;
+	int pattern_index            = 0;
+	int result                   = 0;
+	int segment_index            = 0;
 
 	/* Initialize test
 	 */
@@ -888,11 +6202,90 @@ int fdata_test_stream_get_number_of_segments(
 	 "error",
 	 error );
 
+	result = libfdata_stream_set_read_segment_data_batch_function(
+	          stream,
+	          &fdata_test_stream_read_segment_data_batch_function,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The segment boundaries are positioned so that the matches span
+	 * both a segment boundary and the boundary of a search block
+	 */
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          0,
+	          65535,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          65536,
+	          65535,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          131072,
+	          1000,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test regular cases
 	 */
-	result = libfdata_stream_get_number_of_segments(
+	result = libfdata_stream_find_patterns(
 	          stream,
-	          &number_of_segments,
+	          NULL,
+	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          2,
+	          &match_offset,
+	          &pattern_index,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -900,63 +6293,217 @@ int fdata_test_stream_get_number_of_segments(
 	 result,
 	 1 );
 
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "match_offset",
+	 (int64_t) match_offset,
+	 (int64_t) 65534 );
+
 	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "number_of_segments",
-	 number_of_segments,
+	 "pattern_index",
+	 pattern_index,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_find_patterns(
+	          stream,
+	          NULL,
+	          65535,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          2,
+	          &match_offset,
+	          &pattern_index,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "match_offset",
+	 (int64_t) match_offset,
+	 (int64_t) 131068 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "pattern_index",
+	 pattern_index,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a match that is not contained in the range is not found
+	 */
+	result = libfdata_stream_find_patterns(
+	          stream,
+	          NULL,
+	          0,
+	          65535,
+	          patterns,
+	          pattern_sizes,
+	          2,
+	          &match_offset,
+	          &pattern_index,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_find_patterns(
+	          stream,
+	          NULL,
+	          132070,
+	          1024,
+	          patterns,
+	          pattern_sizes,
+	          2,
+	          &match_offset,
+	          &pattern_index,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
 	 0 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_find_patterns(
+	          NULL,
+	          NULL,
+	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          2,
+	          &match_offset,
+	          &pattern_index,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_find_patterns(
+	          stream,
+	          NULL,
+	          -1,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          2,
+	          &match_offset,
+	          &pattern_index,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Initialize test
-	 */
-	result = libfdata_stream_append_segment(
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_find_patterns(
 	          stream,
-	          &segment_index,
-	          1,
-	          1024,
-	          2048,
+	          NULL,
+	          0,
+	          132070,
+	          NULL,
+	          pattern_sizes,
+	          2,
+	          &match_offset,
+	          &pattern_index,
 	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	result = libfdata_stream_get_number_of_segments(
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_find_patterns(
 	          stream,
-	          &number_of_segments,
+	          NULL,
+	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          0,
+	          &match_offset,
+	          &pattern_index,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "number_of_segments",
-	 number_of_segments,
-	 1 );
+	 -1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libfdata_stream_get_number_of_segments(
+	libcerror_error_free(
+	 &error );
+
+	pattern_sizes[ 1 ] = 0;
+
+	result = libfdata_stream_find_patterns(
+	          stream,
 	          NULL,
-	          &number_of_segments,
+	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          2,
+	          &match_offset,
+	          &pattern_index,
+	          0,
 	          &error );
 
+	pattern_sizes[ 1 ] = 2;
+
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -969,9 +6516,17 @@ int fdata_test_stream_get_number_of_segments(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_get_number_of_segments(
+	result = libfdata_stream_find_patterns(
 	          stream,
 	          NULL,
+	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          2,
+	          NULL,
+	          &pattern_index,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1022,20 +6577,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_get_segment_by_index function
+/* Tests the libfdata_stream_find_all_patterns function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_get_segment_by_index(
+int fdata_test_stream_find_all_patterns(
      void )
 {
-	libcerror_error_t *error  = NULL;
-	libfdata_stream_t *stream = NULL;
-	size64_t segment_size     = 0;
-	off64_t segment_offset    = 0;
-	uint32_t segment_flags    = 0;
-	int result                = 0;
-	int segment_file_index    = 0;
-	int segment_index         = 0;
+	uint8_t pattern1[ 3 ]        = { 0x02, 0x02, 0x03 };
+	uint8_t pattern2[ 2 ]        = { 0x01, 0x02 };
+	uint8_t pattern3[ 2 ]        = { 0x02, 0x03 };
+	const uint8_t *patterns[ 3 ] = { pattern1, pattern2, pattern3 };
+	size_t pattern_sizes[ 3 ]    = { 3, 2, 2 };
+	libcerror_error_t *error     = NULL;
+	libfdata_stream_t *stream    = NULL;
+	int result                   = 0;
+	int segment_index            = 0;
 
 	/* Initialize test
 	 */
@@ -1064,13 +6620,9 @@ int fdata_test_stream_get_segment_by_index(
 	 "error",
 	 error );
 
-	result = libfdata_stream_append_segment(
+	result = libfdata_stream_set_read_segment_data_batch_function(
 	          stream,
-	          &segment_index,
-	          1,
-	          1024,
-	          2048,
-	          0,
+	          &fdata_test_stream_read_segment_data_batch_function,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1082,15 +6634,13 @@ int fdata_test_stream_get_segment_by_index(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	result = libfdata_stream_get_segment_by_index(
+	result = libfdata_stream_append_segment(
 	          stream,
+	          &segment_index,
+	          0,
+	          0,
+	          65535,
 	          0,
-	          &segment_file_index,
-	          &segment_offset,
-	          &segment_size,
-	          &segment_flags,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1098,78 +6648,63 @@ int fdata_test_stream_get_segment_by_index(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "segment_file_index",
-	 segment_file_index,
-	 1 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT64(
-	 "segment_offset",
-	 (int64_t) segment_offset,
-	 (int64_t) 1024 );
-
-	FDATA_TEST_ASSERT_EQUAL_UINT64(
-	 "segment_size",
-	 (uint64_t) segment_size,
-	 (uint64_t) 2048 );
-
-	FDATA_TEST_ASSERT_EQUAL_UINT32(
-	 "segment_flags",
-	 (uint32_t) segment_flags,
-	 (uint32_t) 0 );
-
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libfdata_stream_get_segment_by_index(
-	          NULL,
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          65536,
+	          65535,
 	          0,
-	          &segment_file_index,
-	          &segment_offset,
-	          &segment_size,
-	          &segment_flags,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libfdata_stream_get_segment_by_index(
+	result = libfdata_stream_append_segment(
 	          stream,
-	          -1,
-	          &segment_file_index,
-	          &segment_offset,
-	          &segment_size,
-	          &segment_flags,
+	          &segment_index,
+	          0,
+	          131072,
+	          1000,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	/* Clean up
+	/* Test regular cases
 	 */
-	result = libfdata_stream_free(
-	          &stream,
+	fdata_test_stream_number_of_read_batch_calls = 0;
+	fdata_test_stream_maximum_number_of_matches  = 4;
+	fdata_test_stream_number_of_matches          = 0;
+
+	result = libfdata_stream_find_all_patterns(
+	          stream,
+	          NULL,
+	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          3,
+	          &fdata_test_stream_match_callback_function,
+	          NULL,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1177,51 +6712,66 @@ int fdata_test_stream_get_segment_by_index(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
-	 "stream",
-	 stream );
-
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	return( 1 );
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_matches",
+	 fdata_test_stream_number_of_matches,
+	 3 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( stream != NULL )
-	{
-		libfdata_stream_free(
-		 &stream,
-		 NULL );
-	}
-	return( 0 );
-}
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "fdata_test_stream_match_offsets[ 0 ]",
+	 (int64_t) fdata_test_stream_match_offsets[ 0 ],
+	 (int64_t) 65534 );
 
-/* Tests the libfdata_stream_set_segment_by_index function
- * Returns 1 if successful or 0 if not
- */
-int fdata_test_stream_set_segment_by_index(
-     void )
-{
-	libcerror_error_t *error  = NULL;
-	libfdata_stream_t *stream = NULL;
-	int result                = 0;
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_match_pattern_indexes[ 0 ]",
+	 fdata_test_stream_match_pattern_indexes[ 0 ],
+	 1 );
 
-	/* Initialize test
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "fdata_test_stream_match_offsets[ 1 ]",
+	 (int64_t) fdata_test_stream_match_offsets[ 1 ],
+	 (int64_t) 131068 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_match_pattern_indexes[ 1 ]",
+	 fdata_test_stream_match_pattern_indexes[ 1 ],
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "fdata_test_stream_match_offsets[ 2 ]",
+	 (int64_t) fdata_test_stream_match_offsets[ 2 ],
+	 (int64_t) 131069 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_match_pattern_indexes[ 2 ]",
+	 fdata_test_stream_match_pattern_indexes[ 2 ],
+	 2 );
+
+	/* Test that the range is read once
 	 */
-	result = libfdata_stream_initialize(
-	          &stream,
-	          NULL,
-	          &fdata_test_stream_data_handle_free_function,
-	          &fdata_test_stream_data_handle_clone_function,
-	          NULL,
-	          NULL,
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_batch_calls",
+	 fdata_test_stream_number_of_read_batch_calls,
+	 3 );
+
+	/* Test that the match callback function can stop the search
+	 */
+	fdata_test_stream_maximum_number_of_matches = 1;
+	fdata_test_stream_number_of_matches         = 0;
+
+	result = libfdata_stream_find_all_patterns(
+	          stream,
 	          NULL,
+	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          3,
+	          &fdata_test_stream_match_callback_function,
 	          NULL,
 	          0,
 	          &error );
@@ -1231,56 +6781,52 @@ int fdata_test_stream_set_segment_by_index(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "stream",
-	 stream );
-
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libfdata_stream_resize(
-	          stream,
-	          1,
-	          &error );
-
 	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
+	 "fdata_test_stream_number_of_matches",
+	 fdata_test_stream_number_of_matches,
 	 1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
-	/* Test regular cases
+	/* Test error cases
 	 */
-	result = libfdata_stream_set_segment_by_index(
-	          stream,
-	          0,
-	          0,
-	          0,
+	result = libfdata_stream_find_all_patterns(
+	          NULL,
+	          NULL,
 	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          3,
+	          &fdata_test_stream_match_callback_function,
+	          NULL,
 	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libfdata_stream_set_segment_by_index(
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_find_all_patterns(
+	          stream,
 	          NULL,
 	          0,
-	          0,
-	          0,
-	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          3,
+	          NULL,
+	          NULL,
 	          0,
 	          &error );
 
@@ -1296,12 +6842,21 @@ int fdata_test_stream_set_segment_by_index(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_set_segment_by_index(
+	/* Test that an error of the match callback function is returned
+	 */
+	fdata_test_stream_maximum_number_of_matches = 4;
+	fdata_test_stream_number_of_matches         = 4;
+
+	result = libfdata_stream_find_all_patterns(
 	          stream,
-	          -1,
-	          0,
-	          0,
+	          NULL,
 	          0,
+	          132070,
+	          patterns,
+	          pattern_sizes,
+	          3,
+	          &fdata_test_stream_match_callback_function,
+	          NULL,
 	          0,
 	          &error );
 
@@ -1353,14 +6908,19 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_prepend_segment function
+/* Tests the libfdata_stream_write_buffer function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_prepend_segment(
+int fdata_test_stream_write_buffer(
      void )
 {
+	uint8_t buffer[ 64 ];
+
 	libcerror_error_t *error  = NULL;
 	libfdata_stream_t *stream = NULL;
+	off64_t offset            = 0;
+	ssize_t write_count       = 0;
+	int index                 = 0;
 	int result                = 0;
 
 	/* Initialize test
@@ -1370,10 +6930,10 @@ int fdata_test_stream_prepend_segment(
 	          NULL,
 	          &fdata_test_stream_data_handle_free_function,
 	          &fdata_test_stream_data_handle_clone_function,
-	          NULL,
-	          NULL,
-	          NULL,
-	          NULL,
+	          &fdata_test_stream_create_segment_function,
+	          &fdata_test_stream_read_segment_data_function,
+	          &fdata_test_stream_write_segment_data_function,
+	          &fdata_test_stream_seek_segment_offset_function,
 	          0,
 	          &error );
 
@@ -1390,51 +6950,88 @@ int fdata_test_stream_prepend_segment(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	result = libfdata_stream_prepend_segment(
-	          stream,
-	          0,
-	          0,
-	          0,
+	result = memory_set(
+	          buffer,
 	          0,
-	          &error );
+	          64 ) != NULL;
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
+	/* Test regular cases
+	 */
+	fdata_test_stream_number_of_write_calls = 0;
+
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               buffer,
+	               64,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 64 );
+
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_write_calls",
+	 fdata_test_stream_number_of_write_calls,
+	 1 );
+
+	/* Test that contiguous writes are combined in the write buffer
 	 */
-	result = libfdata_stream_prepend_segment(
-	          NULL,
-	          0,
-	          0,
-	          0,
-	          0,
+	result = libfdata_stream_set_write_buffer_size(
+	          stream,
+	          1024,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	fdata_test_stream_number_of_write_calls = 0;
 
-	/* Clean up
-	 */
-	result = libfdata_stream_free(
-	          &stream,
+	for( index = 0;
+	     index < 8;
+	     index++ )
+	{
+		write_count = libfdata_stream_write_buffer(
+		               stream,
+		               NULL,
+		               buffer,
+		               64,
+		               0,
+		               &error );
+
+		FDATA_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) 64 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_write_calls",
+	 fdata_test_stream_number_of_write_calls,
+	 0 );
+
+	result = libfdata_stream_flush_write_buffer(
+	          stream,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1442,78 +7039,64 @@ int fdata_test_stream_prepend_segment(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
-	 "stream",
-	 stream );
-
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( stream != NULL )
-	{
-		libfdata_stream_free(
-		 &stream,
-		 NULL );
-	}
-	return( 0 );
-}
-
-/* Tests the libfdata_stream_append_segment function
- * Returns 1 if successful or 0 if not
- */
-int fdata_test_stream_append_segment(
-     void )
-{
-	libcerror_error_t *error  = NULL;
-	libfdata_stream_t *stream = NULL;
-	int result                = 0;
-	int segment_index         = 0;
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_write_calls",
+	 fdata_test_stream_number_of_write_calls,
+	 1 );
 
-	/* Initialize test
+	/* Test that seeking another offset flushes the write buffer
 	 */
-	result = libfdata_stream_initialize(
-	          &stream,
-	          NULL,
-	          &fdata_test_stream_data_handle_free_function,
-	          &fdata_test_stream_data_handle_clone_function,
-	          NULL,
-	          NULL,
-	          NULL,
-	          NULL,
-	          0,
-	          &error );
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               buffer,
+	               64,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
+	 "fdata_test_stream_number_of_write_calls",
+	 fdata_test_stream_number_of_write_calls,
 	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "stream",
-	 stream );
+	offset = libfdata_stream_seek_offset(
+	          stream,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_write_calls",
+	 fdata_test_stream_number_of_write_calls,
+	 2 );
+
+	/* Test that writes larger than the write buffer are not buffered
 	 */
-	result = libfdata_stream_append_segment(
+	result = libfdata_stream_set_write_buffer_size(
 	          stream,
-	          &segment_index,
-	          1,
-	          1024,
-	          2048,
-	          0,
+	          32,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1525,15 +7108,72 @@ int fdata_test_stream_append_segment(
 	 "error",
 	 error );
 
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               buffer,
+	               64,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_write_calls",
+	 fdata_test_stream_number_of_write_calls,
+	 3 );
+
 	/* Test error cases
 	 */
-	result = libfdata_stream_append_segment(
+	write_count = libfdata_stream_write_buffer(
+	               NULL,
+	               NULL,
+	               buffer,
+	               64,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               NULL,
+	               64,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_flush_write_buffer(
 	          NULL,
-	          &segment_index,
-	          1,
-	          1024,
-	          2048,
-	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1548,13 +7188,9 @@ int fdata_test_stream_append_segment(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_append_segment(
-	          stream,
+	result = libfdata_stream_set_write_buffer_size(
 	          NULL,
-	          1,
 	          1024,
-	          2048,
-	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1605,28 +7241,43 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_set_mapped_size function
+/* Tests the libfdata_stream_flush_write_buffer function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_set_mapped_size(
+int fdata_test_stream_flush_write_buffer(
      void )
 {
-	libcerror_error_t *error  = NULL;
-	libfdata_stream_t *stream = NULL;
-	int result                = 0;
-	int segment_index         = 0;
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error        = NULL;
+	libfdata_stream_t *clone_stream = NULL;
+	libfdata_stream_t *stream       = NULL;
+	ssize_t read_count              = 0;
+	ssize_t write_count             = 0;
+	int result                      = 0;
+	int segment_index               = 0;
 
 	/* Initialize test
 	 */
+	result = memory_set(
+	          fdata_test_stream_backing_data,
+	          0,
+	          4096 ) != NULL;
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
 	result = libfdata_stream_initialize(
 	          &stream,
 	          NULL,
 	          &fdata_test_stream_data_handle_free_function,
 	          &fdata_test_stream_data_handle_clone_function,
-	          NULL,
-	          NULL,
-	          NULL,
-	          NULL,
+	          &fdata_test_stream_create_segment_function,
+	          &fdata_test_stream_read_backing_data_function,
+	          &fdata_test_stream_write_backing_data_function,
+	          &fdata_test_stream_seek_backing_data_function,
 	          0,
 	          &error );
 
@@ -1646,10 +7297,42 @@ int fdata_test_stream_set_mapped_size(
 	result = libfdata_stream_append_segment(
 	          stream,
 	          &segment_index,
-	          1,
-	          1024,
-	          2048,
 	          0,
+	          0,
+	          4096,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_clone(
+	          &clone_stream,
+	          stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "clone_stream",
+	 clone_stream );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_set_write_buffer_size(
+	          stream,
+	          1024,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1663,9 +7346,60 @@ int fdata_test_stream_set_mapped_size(
 
 	/* Test regular cases
 	 */
-	result = libfdata_stream_set_mapped_size(
+	result = memory_set(
+	          buffer,
+	          0xaa,
+	          64 ) != NULL;
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               buffer,
+	               64,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a clone reads the data as it was before the buffered write
+	 */
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              clone_stream,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 0x00 );
+
+	result = libfdata_stream_flush_write_buffer(
 	          stream,
-	          512,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1677,11 +7411,59 @@ int fdata_test_stream_set_mapped_size(
 	 "error",
 	 error );
 
-	/* Test error cases
+	/* Test that a clone reads the written data after the flush
 	 */
-	result = libfdata_stream_set_mapped_size(
-	          NULL,
-	          512,
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              clone_stream,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 0xaa );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 63 ]",
+	 buffer[ 63 ],
+	 (uint8_t) 0xaa );
+
+	/* Test that freeing a stream with unflushed data fails
+	 */
+	write_count = libfdata_stream_write_buffer(
+	               stream,
+	               NULL,
+	               buffer,
+	               64,
+	               0,
+	               &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fdata_test_stream_number_of_write_calls = 0;
+
+	result = libfdata_stream_free(
+	          &stream,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1689,6 +7471,10 @@ int fdata_test_stream_set_mapped_size(
 	 result,
 	 -1 );
 
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "stream",
+	 stream );
+
 	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1696,9 +7482,15 @@ int fdata_test_stream_set_mapped_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_set_mapped_size(
-	          stream,
-	          4096,
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_write_calls",
+	 fdata_test_stream_number_of_write_calls,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_flush_write_buffer(
+	          NULL,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1716,7 +7508,7 @@ int fdata_test_stream_set_mapped_size(
 	/* Clean up
 	 */
 	result = libfdata_stream_free(
-	          &stream,
+	          &clone_stream,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1725,8 +7517,8 @@ int fdata_test_stream_set_mapped_size(
 	 1 );
 
 	FDATA_TEST_ASSERT_IS_NULL(
-	 "stream",
-	 stream );
+	 "clone_stream",
+	 clone_stream );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -1740,8 +7532,17 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( clone_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &clone_stream,
+		 NULL );
+	}
 	if( stream != NULL )
 	{
+		libfdata_stream_flush_write_buffer(
+		 stream,
+		 NULL );
 		libfdata_stream_free(
 		 &stream,
 		 NULL );
@@ -1749,18 +7550,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_get_segment_mapped_range function
+/* Tests the libfdata_stream_set_maximum_read_ahead_size function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_get_segment_mapped_range(
+int fdata_test_stream_set_maximum_read_ahead_size(
      void )
 {
-	libcerror_error_t *error    = NULL;
-	libfdata_stream_t *stream   = NULL;
-	size64_t mapped_range_size  = 0;
-	off64_t mapped_range_offset = 0;
-	int result                  = 0;
-	int segment_index           = 0;
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	off64_t offset            = 0;
+	ssize_t read_count        = 0;
+	int index                 = 0;
+	int result                = 0;
+	int segment_index         = 0;
 
 	/* Initialize test
 	 */
@@ -1770,9 +7574,9 @@ int fdata_test_stream_get_segment_mapped_range(
 	          &fdata_test_stream_data_handle_free_function,
 	          &fdata_test_stream_data_handle_clone_function,
 	          NULL,
+	          &fdata_test_stream_read_segment_data_function,
 	          NULL,
-	          NULL,
-	          NULL,
+	          &fdata_test_stream_seek_segment_offset_function,
 	          0,
 	          &error );
 
@@ -1792,9 +7596,9 @@ int fdata_test_stream_get_segment_mapped_range(
 	result = libfdata_stream_append_segment(
 	          stream,
 	          &segment_index,
-	          1,
-	          1024,
-	          2048,
+	          0,
+	          0,
+	          4096,
 	          0,
 	          &error );
 
@@ -1809,11 +7613,9 @@ int fdata_test_stream_get_segment_mapped_range(
 
 	/* Test regular cases
 	 */
-	result = libfdata_stream_get_segment_mapped_range(
+	result = libfdata_stream_set_maximum_read_ahead_size(
 	          stream,
-	          0,
-	          &mapped_range_offset,
-	          &mapped_range_size,
+	          1024,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1821,65 +7623,249 @@ int fdata_test_stream_get_segment_mapped_range(
 	 result,
 	 1 );
 
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fdata_test_stream_number_of_read_calls = 0;
+
+	/* Sequential reads grow the read-ahead window
+	 */
+	for( index = 0;
+	     index < 16;
+	     index++ )
+	{
+		read_count = libfdata_stream_read_buffer(
+		              stream,
+		              NULL,
+		              buffer,
+		              64,
+		              0,
+		              &error );
+
+		FDATA_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 64 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_calls",
+	 fdata_test_stream_number_of_read_calls,
+	 3 );
+
+	/* A non-sequential read is not served from the read-ahead buffer
+	 */
+	offset = libfdata_stream_seek_offset(
+	          stream,
+	          3000,
+	          SEEK_SET,
+	          &error );
+
 	FDATA_TEST_ASSERT_EQUAL_INT64(
-	 "mapped_range_offset",
-	 (int64_t) mapped_range_offset,
-	 (int64_t) 0 );
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 3000 );
 
-	FDATA_TEST_ASSERT_EQUAL_UINT64(
-	 "mapped_range_size",
-	 (uint64_t) mapped_range_size,
-	 (uint64_t) 2048 );
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_calls",
+	 fdata_test_stream_number_of_read_calls,
+	 4 );
+
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_calls",
+	 fdata_test_stream_number_of_read_calls,
+	 4 );
+
+	/* A read that ignores the cache is not served from the read-ahead buffer
 	 */
-	result = libfdata_stream_get_segment_mapped_range(
-	          NULL,
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              buffer,
+	              64,
+	              LIBFDATA_READ_FLAG_IGNORE_CACHE,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_calls",
+	 fdata_test_stream_number_of_read_calls,
+	 5 );
+
+	/* Changing a segment discards the read-ahead buffer
+	 */
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_calls",
+	 fdata_test_stream_number_of_read_calls,
+	 6 );
+
+	result = libfdata_stream_set_segment_by_index(
+	          stream,
+	          0,
+	          0,
+	          0,
+	          4096,
 	          0,
-	          &mapped_range_offset,
-	          &mapped_range_size,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              &error );
 
-	result = libfdata_stream_get_segment_mapped_range(
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_calls",
+	 fdata_test_stream_number_of_read_calls,
+	 7 );
+
+	/* Disable read-ahead
+	 */
+	result = libfdata_stream_set_maximum_read_ahead_size(
 	          stream,
-	          -1,
-	          &mapped_range_offset,
-	          &mapped_range_size,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              &error );
 
-	result = libfdata_stream_get_segment_mapped_range(
-	          stream,
-	          0,
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              buffer,
+	              64,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_calls",
+	 fdata_test_stream_number_of_read_calls,
+	 9 );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_set_maximum_read_ahead_size(
 	          NULL,
-	          &mapped_range_size,
+	          1024,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1930,17 +7916,20 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_get_segment_index_at_offset function
+/* Tests the libfdata_stream_set_read_alignment function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_get_segment_index_at_offset(
+int fdata_test_stream_set_read_alignment(
      void )
 {
-	libcerror_error_t *error    = NULL;
-	libfdata_stream_t *stream   = NULL;
-	off64_t segment_data_offset = 0;
-	int result                  = 0;
-	int segment_index           = 0;
+	uint8_t buffer[ 1000 ];
+
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	ssize_t read_count        = 0;
+	int index                 = 0;
+	int result                = 0;
+	int segment_index         = 0;
 
 	/* Initialize test
 	 */
@@ -1950,9 +7939,9 @@ int fdata_test_stream_get_segment_index_at_offset(
 	          &fdata_test_stream_data_handle_free_function,
 	          &fdata_test_stream_data_handle_clone_function,
 	          NULL,
+	          &fdata_test_stream_read_aligned_segment_data_function,
 	          NULL,
-	          NULL,
-	          NULL,
+	          &fdata_test_stream_seek_aligned_segment_offset_function,
 	          0,
 	          &error );
 
@@ -1972,9 +7961,9 @@ int fdata_test_stream_get_segment_index_at_offset(
 	result = libfdata_stream_append_segment(
 	          stream,
 	          &segment_index,
-	          1,
-	          1024,
-	          2048,
+	          0,
+	          1536,
+	          16384,
 	          0,
 	          &error );
 
@@ -1987,100 +7976,116 @@ int fdata_test_stream_get_segment_index_at_offset(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	/* Test that an unaligned read fails without a read alignment
 	 */
-	result = libfdata_stream_get_segment_index_at_offset(
-	          stream,
-	          0,
-	          &segment_index,
-	          &segment_data_offset,
-	          &error );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "segment_index",
-	 segment_index,
-	 0 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT64(
-	 "segment_data_offset",
-	 (int64_t) segment_data_offset,
-	 (int64_t) 0 );
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              stream,
+	              NULL,
+	              buffer,
+	              1000,
+	              100,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-#ifdef TODO
-/* TODO fix libfdata_stream_get_segment_index_at_offset
- * libcdata_array_get_entry_by_index: invalid entry index value out of bounds.
- */
-	result = libfdata_stream_get_segment_index_at_offset(
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_stream_set_read_alignment(
 	          stream,
-	          4096,
-	          &segment_index,
-	          &segment_data_offset,
+	          512,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 1 );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
-#endif
 
-	/* Test error cases
-	 */
-	result = libfdata_stream_get_segment_index_at_offset(
-	          NULL,
-	          0,
-	          &segment_index,
-	          &segment_data_offset,
-	          &error );
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              stream,
+	              NULL,
+	              buffer,
+	              1000,
+	              100,
+	              0,
+	              &error );
 
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 1000 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libfdata_stream_get_segment_index_at_offset(
-	          stream,
-	          -1,
-	          &segment_index,
-	          &segment_data_offset,
-	          &error );
-
+	for( index = 0;
+	     index < 1000;
+	     index++ )
+	{
+		if( buffer[ index ] != (uint8_t) ( 1636 + index ) )
+		{
+			break;
+		}
+	}
 	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	 "index",
+	 index,
+	 1000 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	/* Test a read at an aligned segment offset
+	 */
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              stream,
+	              NULL,
+	              buffer,
+	              1000,
+	              0,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 1000 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	for( index = 0;
+	     index < 1000;
+	     index++ )
+	{
+		if( buffer[ index ] != (uint8_t) ( 1536 + index ) )
+		{
+			break;
+		}
+	}
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "index",
+	 index,
+	 1000 );
 
-	result = libfdata_stream_get_segment_index_at_offset(
-	          stream,
-	          0,
+	/* Test error cases
+	 */
+	result = libfdata_stream_set_read_alignment(
 	          NULL,
-	          &segment_data_offset,
+	          512,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2095,11 +8100,9 @@ int fdata_test_stream_get_segment_index_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_get_segment_index_at_offset(
+	result = libfdata_stream_set_read_alignment(
 	          stream,
-	          0,
-	          &segment_index,
-	          NULL,
+	          100,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2150,21 +8153,24 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_get_segment_at_offset function
+/* Tests the libfdata_stream_set_read_segment_data_batch_function function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_get_segment_at_offset(
+int fdata_test_stream_set_read_segment_data_batch_function(
      void )
 {
-	libcerror_error_t *error    = NULL;
-	libfdata_stream_t *stream   = NULL;
-	size64_t segment_size       = 0;
-	off64_t segment_data_offset = 0;
-	off64_t segment_offset      = 0;
-	uint32_t segment_flags      = 0;
-	int result                  = 0;
-	int segment_file_index      = 0;
-	int segment_index           = 0;
+	uint8_t buffer1[ 512 ];
+	uint8_t buffer2[ 64 ];
+
+	uint8_t *buffers[ 2 ]     = { buffer1, buffer2 };
+	size_t buffer_sizes[ 2 ]  = { 512, 64 };
+	off64_t offsets[ 2 ]      = { 768, 1536 };
+	ssize_t read_counts[ 2 ]  = { 0, 0 };
+	libcerror_error_t *error  = NULL;
+	libfdata_stream_t *stream = NULL;
+	int index                 = 0;
+	int result                = 0;
+	int segment_index         = 0;
 
 	/* Initialize test
 	 */
@@ -2196,9 +8202,9 @@ int fdata_test_stream_get_segment_at_offset(
 	result = libfdata_stream_append_segment(
 	          stream,
 	          &segment_index,
-	          1,
+	          0,
+	          0,
 	          1024,
-	          2048,
 	          0,
 	          &error );
 
@@ -2211,17 +8217,13 @@ int fdata_test_stream_get_segment_at_offset(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	result = libfdata_stream_get_segment_at_offset(
+	result = libfdata_stream_append_segment(
 	          stream,
-	          0,
 	          &segment_index,
-	          &segment_data_offset,
-	          &segment_file_index,
-	          &segment_offset,
-	          &segment_size,
-	          &segment_flags,
+	          0,
+	          2048,
+	          1024,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2229,122 +8231,118 @@ int fdata_test_stream_get_segment_at_offset(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "segment_index",
-	 segment_index,
-	 0 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT64(
-	 "segment_data_offset",
-	 (int64_t) segment_data_offset,
-	 (int64_t) 0 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "segment_file_index",
-	 segment_file_index,
-	 1 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT64(
-	 "segment_offset",
-	 (int64_t) segment_offset,
-	 (int64_t) 1024 );
-
-	FDATA_TEST_ASSERT_EQUAL_UINT64(
-	 "segment_size",
-	 (uint64_t) segment_size,
-	 (uint64_t) 2048 );
-
-	FDATA_TEST_ASSERT_EQUAL_UINT32(
-	 "segment_flags",
-	 (uint32_t) segment_flags,
-	 (uint32_t) 0 );
-
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-#ifdef TODO
-/* TODO fix libfdata_stream_get_segment_at_offset
- * libcdata_array_get_entry_by_index: invalid entry index value out of bounds.
- */
-	result = libfdata_stream_get_segment_at_offset(
+	/* Test that a batch read fails without a read segment data (batch) function
+	 */
+	result = libfdata_stream_read_buffers_at_offsets(
 	          stream,
-	          4096,
-	          &segment_index,
-	          &segment_data_offset,
-	          &segment_file_index,
-	          &segment_offset,
-	          &segment_size,
-	          &segment_flags,
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          2,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
-	FDATA_TEST_ASSERT_IS_NULL(
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
-#endif
 
-	/* Test error cases
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
 	 */
-	result = libfdata_stream_get_segment_at_offset(
-	          NULL,
-	          0,
-	          &segment_index,
-	          &segment_data_offset,
-	          &segment_file_index,
-	          &segment_offset,
-	          &segment_size,
-	          &segment_flags,
+	result = libfdata_stream_set_read_segment_data_batch_function(
+	          stream,
+	          &fdata_test_stream_read_segment_data_batch_function,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	fdata_test_stream_number_of_read_batch_calls    = 0;
+	fdata_test_stream_number_of_batch_segment_reads = 0;
 
-	result = libfdata_stream_get_segment_at_offset(
+	result = libfdata_stream_read_buffers_at_offsets(
 	          stream,
-	          -1,
-	          &segment_index,
-	          &segment_data_offset,
-	          &segment_file_index,
-	          &segment_offset,
-	          &segment_size,
-	          &segment_flags,
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          2,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_read_batch_calls",
+	 fdata_test_stream_number_of_read_batch_calls,
+	 1 );
 
-	result = libfdata_stream_get_segment_at_offset(
-	          stream,
-	          0,
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_stream_number_of_batch_segment_reads",
+	 fdata_test_stream_number_of_batch_segment_reads,
+	 3 );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 0 ]",
+	 read_counts[ 0 ],
+	 (ssize_t) 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 1 ]",
+	 read_counts[ 1 ],
+	 (ssize_t) 64 );
+
+	for( index = 0;
+	     index < 512;
+	     index++ )
+	{
+		if( buffer1[ index ] != ( ( index < 256 ) ? 1 : 2 ) )
+		{
+			break;
+		}
+	}
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "index",
+	 index,
+	 512 );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer2[ 0 ]",
+	 buffer2[ 0 ],
+	 (uint8_t) 2 );
+
+	/* Test error cases
+	 */
+	result = libfdata_stream_set_read_segment_data_batch_function(
 	          NULL,
-	          &segment_data_offset,
-	          &segment_file_index,
-	          &segment_offset,
-	          &segment_size,
-	          &segment_flags,
+	          &fdata_test_stream_read_segment_data_batch_function,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2395,14 +8393,12 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_read_buffer function
+/* Tests the libfdata_stream_seek_offset function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_read_buffer(
+int fdata_test_stream_seek_offset(
      void )
 {
-	uint8_t data[ 32 ];
-
 	libcerror_error_t *error  = NULL;
 	libfdata_stream_t *stream = NULL;
 	int result                = 0;
@@ -2459,12 +8455,10 @@ int fdata_test_stream_read_buffer(
 
 	/* Test error cases
 	 */
-	result = libfdata_stream_read_buffer(
-	          NULL,
+	result = libfdata_stream_seek_offset(
 	          NULL,
-	          data,
-	          32,
 	          0,
+	          SEEK_SET,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2479,12 +8473,10 @@ int fdata_test_stream_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_read_buffer(
+	result = libfdata_stream_seek_offset(
 	          stream,
-	          NULL,
-	          NULL,
-	          32,
-	          0,
+	          -1,
+	          SEEK_SET,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2499,12 +8491,10 @@ int fdata_test_stream_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_read_buffer(
+	result = libfdata_stream_seek_offset(
 	          stream,
-	          NULL,
-	          data,
-	          (size_t) SSIZE_MAX + 1,
 	          0,
+	          -1,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2555,16 +8545,15 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_read_buffer_at_offset function
+/* Tests the libfdata_stream_get_offset function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_read_buffer_at_offset(
+int fdata_test_stream_get_offset(
      void )
 {
-	uint8_t data[ 32 ];
-
 	libcerror_error_t *error  = NULL;
 	libfdata_stream_t *stream = NULL;
+	off64_t offset            = 0;
 	int result                = 0;
 	int segment_index         = 0;
 
@@ -2615,59 +8604,30 @@ int fdata_test_stream_read_buffer_at_offset(
 
 	/* Test regular cases
 	 */
-/* TODO implement */
-
-	/* Test error cases
-	 */
-	result = libfdata_stream_read_buffer_at_offset(
-	          NULL,
-	          NULL,
-	          data,
-	          32,
-	          0,
-	          0,
-	          &error );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	result = libfdata_stream_read_buffer_at_offset(
+	result = libfdata_stream_get_offset(
 	          stream,
-	          NULL,
-	          NULL,
-	          32,
-	          0,
-	          0,
+	          &offset,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libfdata_stream_read_buffer_at_offset(
-	          stream,
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_offset(
 	          NULL,
-	          data,
-	          (size_t) SSIZE_MAX + 1,
-	          0,
-	          0,
+	          &offset,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2682,13 +8642,9 @@ int fdata_test_stream_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_read_buffer_at_offset(
+	result = libfdata_stream_get_offset(
 	          stream,
 	          NULL,
-	          data,
-	          32,
-	          -1,
-	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2739,14 +8695,15 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_seek_offset function
+/* Tests the libfdata_stream_get_size function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_seek_offset(
+int fdata_test_stream_get_size(
      void )
 {
 	libcerror_error_t *error  = NULL;
 	libfdata_stream_t *stream = NULL;
+	size64_t size             = 0;
 	int result                = 0;
 	int segment_index         = 0;
 
@@ -2797,32 +8754,30 @@ int fdata_test_stream_seek_offset(
 
 	/* Test regular cases
 	 */
-/* TODO implement */
-
-	/* Test error cases
-	 */
-	result = libfdata_stream_seek_offset(
-	          NULL,
-	          0,
-	          SEEK_SET,
+	result = libfdata_stream_get_size(
+	          stream,
+	          &size,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 2048 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libfdata_stream_seek_offset(
-	          stream,
-	          -1,
-	          SEEK_SET,
+	/* Test error cases
+	 */
+	result = libfdata_stream_get_size(
+	          NULL,
+	          &size,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2837,10 +8792,9 @@ int fdata_test_stream_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_seek_offset(
+	result = libfdata_stream_get_size(
 	          stream,
-	          0,
-	          -1,
+	          NULL,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2891,29 +8845,42 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_get_offset function
+/* Tests the libfdata_stream_get_io_statistics and libfdata_stream_reset_io_statistics functions
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_get_offset(
+int fdata_test_stream_get_io_statistics(
      void )
 {
-	libcerror_error_t *error  = NULL;
-	libfdata_stream_t *stream = NULL;
-	off64_t offset            = 0;
-	int result                = 0;
-	int segment_index         = 0;
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error            = NULL;
+	libfdata_stream_t *stream           = NULL;
+	uint64_t number_of_bytes_read       = 0;
+	uint64_t number_of_bytes_requested  = 0;
+	uint64_t number_of_read_calls       = 0;
+	uint64_t number_of_seek_calls       = 0;
+	uint64_t number_of_segment_switches = 0;
+	uint64_t number_of_short_reads      = 0;
+	ssize_t read_count                  = 0;
+	int expected_result                 = 0;
+	int result                          = 0;
+	int segment_index                   = 0;
+
+#if defined( HAVE_IO_STATISTICS )
+	expected_result = 1;
+#endif
 
 	/* Initialize test
 	 */
 	result = libfdata_stream_initialize(
 	          &stream,
 	          NULL,
-	          &fdata_test_stream_data_handle_free_function,
-	          &fdata_test_stream_data_handle_clone_function,
 	          NULL,
 	          NULL,
 	          NULL,
+	          &fdata_test_stream_read_segment_data_function,
 	          NULL,
+	          &fdata_test_stream_seek_segment_offset_function,
 	          0,
 	          &error );
 
@@ -2933,9 +8900,27 @@ int fdata_test_stream_get_offset(
 	result = libfdata_stream_append_segment(
 	          stream,
 	          &segment_index,
-	          1,
-	          1024,
-	          2048,
+	          0,
+	          0,
+	          16,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_append_segment(
+	          stream,
+	          &segment_index,
+	          0,
+	          64,
+	          16,
 	          0,
 	          &error );
 
@@ -2950,30 +8935,147 @@ int fdata_test_stream_get_offset(
 
 	/* Test regular cases
 	 */
-	result = libfdata_stream_get_offset(
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              data,
+	              24,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 24 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reading beyond the end of the stream only counts the requested bytes
+	 */
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              data,
+	              32,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_io_statistics(
 	          stream,
-	          &offset,
+	          &number_of_read_calls,
+	          &number_of_seek_calls,
+	          &number_of_segment_switches,
+	          &number_of_bytes_requested,
+	          &number_of_bytes_read,
+	          &number_of_short_reads,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 expected_result );
 
-	FDATA_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 (int64_t) offset,
-	 (int64_t) 0 );
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( expected_result == 1 )
+	{
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_read_calls",
+		 number_of_read_calls,
+		 (uint64_t) 3 );
+
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_seek_calls",
+		 number_of_seek_calls,
+		 (uint64_t) 3 );
+
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_segment_switches",
+		 number_of_segment_switches,
+		 (uint64_t) 1 );
+
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_bytes_requested",
+		 number_of_bytes_requested,
+		 (uint64_t) 56 );
+
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_bytes_read",
+		 number_of_bytes_read,
+		 (uint64_t) 32 );
+
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_short_reads",
+		 number_of_short_reads,
+		 (uint64_t) 0 );
+	}
+	result = libfdata_stream_reset_io_statistics(
+	          stream,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 expected_result );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_io_statistics(
+	          stream,
+	          &number_of_read_calls,
+	          &number_of_seek_calls,
+	          &number_of_segment_switches,
+	          &number_of_bytes_requested,
+	          &number_of_bytes_read,
+	          &number_of_short_reads,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 expected_result );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	if( expected_result == 1 )
+	{
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_read_calls",
+		 number_of_read_calls,
+		 (uint64_t) 0 );
+
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_bytes_requested",
+		 number_of_bytes_requested,
+		 (uint64_t) 0 );
+	}
 	/* Test error cases
 	 */
-	result = libfdata_stream_get_offset(
-	          NULL,
-	          &offset,
+	result = libfdata_stream_get_io_statistics(
+	          NULL,
+	          &number_of_read_calls,
+	          &number_of_seek_calls,
+	          &number_of_segment_switches,
+	          &number_of_bytes_requested,
+	          &number_of_bytes_read,
+	          &number_of_short_reads,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2988,8 +9090,29 @@ int fdata_test_stream_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_get_offset(
+	result = libfdata_stream_get_io_statistics(
 	          stream,
+	          NULL,
+	          &number_of_seek_calls,
+	          &number_of_segment_switches,
+	          &number_of_bytes_requested,
+	          &number_of_bytes_read,
+	          &number_of_short_reads,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_reset_io_statistics(
 	          NULL,
 	          &error );
 
@@ -3041,29 +9164,39 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_stream_get_size function
+/* Tests the libfdata_stream_get_read_latency_histogram function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_stream_get_size(
+int fdata_test_stream_get_read_latency_histogram(
      void )
 {
+	uint64_t histogram[ LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+	uint8_t data[ 32 ];
+
 	libcerror_error_t *error  = NULL;
 	libfdata_stream_t *stream = NULL;
-	size64_t size             = 0;
+	uint64_t number_of_reads  = 0;
+	ssize_t read_count        = 0;
+	int bucket_index          = 0;
+	int expected_result       = 0;
 	int result                = 0;
 	int segment_index         = 0;
 
+#if defined( HAVE_IO_STATISTICS )
+	expected_result = 1;
+#endif
+
 	/* Initialize test
 	 */
 	result = libfdata_stream_initialize(
 	          &stream,
 	          NULL,
-	          &fdata_test_stream_data_handle_free_function,
-	          &fdata_test_stream_data_handle_clone_function,
 	          NULL,
 	          NULL,
 	          NULL,
+	          &fdata_test_stream_read_segment_data_function,
 	          NULL,
+	          &fdata_test_stream_seek_segment_offset_function,
 	          0,
 	          &error );
 
@@ -3083,9 +9216,9 @@ int fdata_test_stream_get_size(
 	result = libfdata_stream_append_segment(
 	          stream,
 	          &segment_index,
-	          1,
-	          1024,
-	          2048,
+	          0,
+	          0,
+	          16,
 	          0,
 	          &error );
 
@@ -3098,11 +9231,13 @@ int fdata_test_stream_get_size(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	result = libfdata_stream_get_size(
+	result = libfdata_stream_append_segment(
 	          stream,
-	          &size,
+	          &segment_index,
+	          0,
+	          64,
+	          16,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -3110,20 +9245,106 @@ int fdata_test_stream_get_size(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_EQUAL_UINT64(
-	 "size",
-	 (uint64_t) size,
-	 (uint64_t) 2048 );
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libfdata_stream_read_buffer(
+	              stream,
+	              NULL,
+	              data,
+	              24,
+	              0,
+	              &error );
+
+	FDATA_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 24 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_get_read_latency_histogram(
+	          stream,
+	          histogram,
+	          LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 expected_result );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	if( expected_result == 1 )
+	{
+		/* Every read segment data function call is recorded in exactly one bucket
+		 */
+		for( bucket_index = 0;
+		     bucket_index < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS;
+		     bucket_index++ )
+		{
+			number_of_reads += histogram[ bucket_index ];
+		}
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_reads",
+		 number_of_reads,
+		 (uint64_t) 2 );
+
+		result = libfdata_stream_reset_io_statistics(
+		          stream,
+		          &error );
+
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfdata_stream_get_read_latency_histogram(
+		          stream,
+		          histogram,
+		          LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+		          &error );
+
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		number_of_reads = 0;
+
+		for( bucket_index = 0;
+		     bucket_index < LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS;
+		     bucket_index++ )
+		{
+			number_of_reads += histogram[ bucket_index ];
+		}
+		FDATA_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_reads",
+		 number_of_reads,
+		 (uint64_t) 0 );
+	}
 	/* Test error cases
 	 */
-	result = libfdata_stream_get_size(
+	result = libfdata_stream_get_read_latency_histogram(
 	          NULL,
-	          &size,
+	          histogram,
+	          LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -3138,9 +9359,28 @@ int fdata_test_stream_get_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_stream_get_size(
+	result = libfdata_stream_get_read_latency_histogram(
 	          stream,
 	          NULL,
+	          LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_stream_get_read_latency_histogram(
+	          stream,
+	          histogram,
+	          LIBFDATA_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -3218,6 +9458,14 @@ int main(
 	 "libfdata_stream_clone",
 	 fdata_test_stream_clone );
 
+	FDATA_TEST_RUN(
+	 "libfdata_stream_initialize_slice",
+	 fdata_test_stream_initialize_slice );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_initialize_composed",
+	 fdata_test_stream_initialize_composed );
+
 	FDATA_TEST_RUN(
 	 "libfdata_stream_empty",
 	 fdata_test_stream_empty );
@@ -3252,6 +9500,10 @@ int main(
 	 "libfdata_stream_set_mapped_size",
 	 fdata_test_stream_set_mapped_size );
 
+	FDATA_TEST_RUN(
+	 "libfdata_stream_set_create_segment_run_function",
+	 fdata_test_stream_set_create_segment_run_function );
+
 	FDATA_TEST_RUN(
 	 "libfdata_stream_get_segment_mapped_range",
 	 fdata_test_stream_get_segment_mapped_range );
@@ -3264,6 +9516,18 @@ int main(
 	 "libfdata_stream_get_segment_at_offset",
 	 fdata_test_stream_get_segment_at_offset );
 
+	FDATA_TEST_RUN(
+	 "libfdata_stream_get_data_offset",
+	 fdata_test_stream_get_data_offset );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_get_hole_offset",
+	 fdata_test_stream_get_hole_offset );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_get_extent_at_offset",
+	 fdata_test_stream_get_extent_at_offset );
+
 	FDATA_TEST_RUN(
 	 "libfdata_stream_read_buffer",
 	 fdata_test_stream_read_buffer );
@@ -3272,7 +9536,37 @@ int main(
 	 "libfdata_stream_read_buffer_at_offset",
 	 fdata_test_stream_read_buffer_at_offset );
 
-	/* TODO: add tests for libfdata_stream_write_buffer */
+	FDATA_TEST_RUN(
+	 "libfdata_stream_read_buffers_at_offsets",
+	 fdata_test_stream_read_buffers_at_offsets );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_find_patterns",
+	 fdata_test_stream_find_patterns );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_find_all_patterns",
+	 fdata_test_stream_find_all_patterns );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_write_buffer",
+	 fdata_test_stream_write_buffer );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_flush_write_buffer",
+	 fdata_test_stream_flush_write_buffer );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_set_maximum_read_ahead_size",
+	 fdata_test_stream_set_maximum_read_ahead_size );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_set_read_alignment",
+	 fdata_test_stream_set_read_alignment );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_set_read_segment_data_batch_function",
+	 fdata_test_stream_set_read_segment_data_batch_function );
 
 	FDATA_TEST_RUN(
 	 "libfdata_stream_seek_offset",
@@ -3286,6 +9580,14 @@ int main(
 	 "libfdata_stream_get_size",
 	 fdata_test_stream_get_size );
 
+	FDATA_TEST_RUN(
+	 "libfdata_stream_get_io_statistics",
+	 fdata_test_stream_get_io_statistics );
+
+	FDATA_TEST_RUN(
+	 "libfdata_stream_get_read_latency_histogram",
+	 fdata_test_stream_get_read_latency_histogram );
+
 	return( EXIT_SUCCESS );
 
 on_error:
@@ -30,6 +30,8 @@
 #endif
 
 #include "fdata_test_libcerror.h"
+#include "fdata_test_libcthreads.h"
+#include "fdata_test_libfcache.h"
 #include "fdata_test_libfdata.h"
 #include "fdata_test_macros.h"
 #include "fdata_test_memory.h"
@@ -41,6 +43,11 @@ int fdata_test_vector_data_handle_free_function_return_value   = 1;
 int fdata_test_vector_data_handle_clone_function_return_value  = 1;
 int fdata_test_vector_element_value_free_function_return_value = 1;
 
+int fdata_test_vector_read_block_data_number_of_calls          = 0;
+int fdata_test_vector_read_element_data_free_element_value     = 0;
+
+libfdata_vector_t *fdata_test_vector_nested_vector             = NULL;
+
 /* Test data handle free function
  * Returns 1 if successful or -1 on error
  */
@@ -82,6 +89,29 @@ int fdata_test_vector_element_value_free_function(
 	return( fdata_test_vector_element_value_free_function_return_value );
 }
 
+/* Test element value free function that frees the element value
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_element_value_memory_free_function(
+     intptr_t **element_value,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( element_value == NULL )
+	{
+		return( -1 );
+	}
+	if( *element_value != NULL )
+	{
+		memory_free(
+		 *element_value );
+
+		*element_value = NULL;
+	}
+	return( 1 );
+}
+
 /* Reads element data
  * Callback function for the vector
  * Returns 1 if successful or -1 on error
@@ -102,6 +132,10 @@ int fdata_test_vector_read_element_data(
 	uint8_t *element_value = NULL;
 	static char *function  = "fdata_test_vector_read_element_data";
 
+	int (*free_element_value)(
+	       intptr_t **element_value,
+	       libcerror_error_t **error ) = &fdata_test_vector_element_value_free_function;
+
 	if( data_handle != NULL )
 	{
 		libcerror_error_set(
@@ -198,13 +232,18 @@ int fdata_test_vector_read_element_data(
 	 element_value,
 	 element_index );
 
+	if( fdata_test_vector_read_element_data_free_element_value != 0 )
+	{
+		free_element_value = &fdata_test_vector_element_value_memory_free_function;
+	}
+
 	if( libfdata_vector_set_element_value_by_index(
 	     vector,
 	     file_io_handle,
 	     cache,
 	     element_index,
 	     (intptr_t *) element_value,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &fdata_test_vector_element_value_free_function,
+	     free_element_value,
 	     LIBFDATA_VECTOR_ELEMENT_VALUE_FLAG_MANAGED,
 	     error ) != 1 )
 	{
@@ -229,6 +268,330 @@ on_error:
 	return( -1 );
 }
 
+/* Stores an element value that contains the element index
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_store_element_value(
+     libfdata_vector_t *vector,
+     intptr_t *file_io_handle,
+     libfdata_cache_t *cache,
+     int element_index,
+     uint8_t write_flags,
+     libcerror_error_t **error )
+{
+	uint8_t *element_value = NULL;
+	static char *function  = "fdata_test_vector_store_element_value";
+
+	element_value = (uint8_t *) memory_allocate(
+	                             sizeof( uint32_t ) );
+
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create element value.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 element_value,
+	 element_index );
+
+	if( libfdata_vector_set_element_value_by_index(
+	     vector,
+	     file_io_handle,
+	     cache,
+	     element_index,
+	     (intptr_t *) element_value,
+	     &fdata_test_vector_element_value_memory_free_function,
+	     write_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set element value: %d.",
+		 function,
+		 element_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( element_value != NULL )
+	{
+		memory_free(
+		 element_value );
+	}
+	return( -1 );
+}
+
+/* Reads element data and clears the cache
+ * The element value is not managed by the cache, hence it is not freed by clearing the cache
+ * Callback function for the vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_read_element_data_and_clear_cache(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t element_data_offset FDATA_TEST_ATTRIBUTE_UNUSED,
+     size64_t element_data_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t element_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_offset )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_size )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+
+	if( fdata_test_vector_store_element_value(
+	     vector,
+	     file_io_handle,
+	     cache,
+	     element_index,
+	     0,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libfcache_cache_clear(
+	     (libfcache_cache_t *) cache,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads element data and stores the value of the next element as well
+ * Callback function for the vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_read_element_data_and_store_next_value(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t element_data_offset FDATA_TEST_ATTRIBUTE_UNUSED,
+     size64_t element_data_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t element_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_offset )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_size )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+
+	if( fdata_test_vector_store_element_value(
+	     vector,
+	     file_io_handle,
+	     cache,
+	     element_index,
+	     LIBFDATA_VECTOR_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( fdata_test_vector_store_element_value(
+	     vector,
+	     file_io_handle,
+	     cache,
+	     element_index + 1,
+	     LIBFDATA_VECTOR_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads element data and, for even element indexes, reads the next element
+ * of fdata_test_vector_nested_vector, using the same cache
+ * Callback function for the vector
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_read_element_data_and_read_nested(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t element_data_offset FDATA_TEST_ATTRIBUTE_UNUSED,
+     size64_t element_data_size FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint32_t element_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	intptr_t *nested_element_value = NULL;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_offset )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_size )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_flags )
+
+	if( fdata_test_vector_store_element_value(
+	     vector,
+	     file_io_handle,
+	     cache,
+	     element_index,
+	     LIBFDATA_VECTOR_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( ( element_index % 2 ) != 0 )
+	{
+		return( 1 );
+	}
+	if( libfdata_vector_get_element_value_by_index(
+	     fdata_test_vector_nested_vector,
+	     file_io_handle,
+	     cache,
+	     element_index + 1,
+	     &nested_element_value,
+	     read_flags,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Test block value free function
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_block_value_free_function(
+     intptr_t **block_value,
+     libcerror_error_t **error FDATA_TEST_ATTRIBUTE_UNUSED )
+{
+	FDATA_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( *block_value != NULL )
+	{
+		memory_free(
+		 *block_value );
+
+		*block_value = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads block data
+ * Callback function for the vector in block mode
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_read_block_data(
+     intptr_t *data_handle FDATA_TEST_ATTRIBUTE_UNUSED,
+     intptr_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfdata_cache_t *cache,
+     int element_index,
+     int element_data_file_index FDATA_TEST_ATTRIBUTE_UNUSED,
+     off64_t element_data_offset FDATA_TEST_ATTRIBUTE_UNUSED,
+     size64_t element_data_size,
+     uint32_t element_data_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     uint8_t read_flags FDATA_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint8_t *block_value    = NULL;
+	static char *function   = "fdata_test_vector_read_block_data";
+	int block_element_index = 0;
+	int number_of_elements  = 0;
+
+	FDATA_TEST_UNREFERENCED_PARAMETER( data_handle )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_file_index )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_offset )
+	FDATA_TEST_UNREFERENCED_PARAMETER( element_data_flags )
+	FDATA_TEST_UNREFERENCED_PARAMETER( read_flags )
+
+	if( ( element_data_size == 0 )
+	 || ( ( element_data_size % 128 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_elements = (int) ( element_data_size / 128 );
+
+	block_value = (uint8_t *) memory_allocate(
+	                           sizeof( uint32_t ) * number_of_elements );
+
+	if( block_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block value.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_element_index = 0;
+	     block_element_index < number_of_elements;
+	     block_element_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( block_value[ block_element_index * sizeof( uint32_t ) ] ),
+		 element_index + block_element_index );
+	}
+	if( libfdata_vector_set_element_value_by_index(
+	     vector,
+	     file_io_handle,
+	     cache,
+	     element_index,
+	     (intptr_t *) block_value,
+	     &fdata_test_vector_block_value_free_function,
+	     LIBFDATA_VECTOR_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set block value: %d.",
+		 function,
+		 element_index );
+
+		goto on_error;
+	}
+	fdata_test_vector_read_block_data_number_of_calls++;
+
+	return( 1 );
+
+on_error:
+	if( block_value != NULL )
+	{
+		memory_free(
+		 block_value );
+	}
+	return( -1 );
+}
+
 /* Tests the libfdata_vector_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -488,16 +851,165 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_vector_free function
- * Returns 1 if successful or 0 if not
+#if defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) && defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define FDATA_TEST_VECTOR_NUMBER_OF_THREADS		4
+#define FDATA_TEST_VECTOR_NUMBER_OF_VECTORS_PER_THREAD	256
+
+/* Thread function that creates vectors and records their cache timestamps
+ * Returns 1 if successful or -1 on error
  */
-int fdata_test_vector_free(
-     void )
+int fdata_test_vector_initialize_thread_function(
+     void *arguments )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libfdata_vector_t *vector = NULL;
+	int64_t *timestamps       = NULL;
+	int vector_index          = 0;
 
-	/* Test error cases
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	timestamps = (int64_t *) arguments;
+
+	for( vector_index = 0;
+	     vector_index < FDATA_TEST_VECTOR_NUMBER_OF_VECTORS_PER_THREAD;
+	     vector_index++ )
+	{
+		if( libfdata_vector_initialize(
+		     &vector,
+		     128,
+		     NULL,
+		     NULL,
+		     NULL,
+		     &fdata_test_vector_read_element_data,
+		     NULL,
+		     0,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		timestamps[ vector_index ] = ( (libfdata_internal_vector_t *) vector )->timestamp;
+
+		if( libfdata_vector_free(
+		     &vector,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the libfdata_vector_initialize function with multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_initialize_threaded(
+     void )
+{
+	int64_t timestamps[ FDATA_TEST_VECTOR_NUMBER_OF_THREADS * FDATA_TEST_VECTOR_NUMBER_OF_VECTORS_PER_THREAD ];
+	libcthreads_thread_t *threads[ FDATA_TEST_VECTOR_NUMBER_OF_THREADS ];
+
+	libcerror_error_t *error = NULL;
+	int compare_index        = 0;
+	int number_of_timestamps = FDATA_TEST_VECTOR_NUMBER_OF_THREADS * FDATA_TEST_VECTOR_NUMBER_OF_VECTORS_PER_THREAD;
+	int result               = 0;
+	int thread_index         = 0;
+	int timestamp_index      = 0;
+
+	for( thread_index = 0;
+	     thread_index < FDATA_TEST_VECTOR_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	/* Test that containers created by different threads get unique timestamps
+	 */
+	for( thread_index = 0;
+	     thread_index < FDATA_TEST_VECTOR_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &fdata_test_vector_initialize_thread_function,
+		          (void *) &( timestamps[ thread_index * FDATA_TEST_VECTOR_NUMBER_OF_VECTORS_PER_THREAD ] ),
+		          &error );
+
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < FDATA_TEST_VECTOR_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( timestamp_index = 0;
+	     timestamp_index < number_of_timestamps;
+	     timestamp_index++ )
+	{
+		for( compare_index = timestamp_index + 1;
+		     compare_index < number_of_timestamps;
+		     compare_index++ )
+		{
+			FDATA_TEST_ASSERT_NOT_EQUAL_INT64(
+			 "timestamp",
+			 timestamps[ timestamp_index ],
+			 timestamps[ compare_index ] );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < FDATA_TEST_VECTOR_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) && defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Tests the libfdata_vector_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
 	 */
 	result = libfdata_vector_free(
 	          NULL,
@@ -784,24 +1296,96 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_vector_empty function
+#if defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) && defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Thread function that clones and frees vectors that share a segments table
+ * Returns 1 if successful or -1 on error
+ */
+int fdata_test_vector_clone_thread_function(
+     void *arguments )
+{
+	libfdata_vector_t *destination_vector = NULL;
+	libfdata_vector_t *source_vector      = NULL;
+	int iteration                         = 0;
+	int segment_index                     = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	source_vector = (libfdata_vector_t *) arguments;
+
+	for( iteration = 0;
+	     iteration < 256;
+	     iteration++ )
+	{
+		if( libfdata_vector_clone(
+		     &destination_vector,
+		     source_vector,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		/* Modifying the clone makes its segments table writable, which releases
+		 * its reference to the shared segments table on every other iteration
+		 */
+		if( ( iteration % 2 ) == 0 )
+		{
+			if( libfdata_vector_append_segment(
+			     destination_vector,
+			     &segment_index,
+			     0,
+			     1024,
+			     1024,
+			     0,
+			     NULL ) != 1 )
+			{
+				libfdata_vector_free(
+				 &destination_vector,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libfdata_vector_free(
+		     &destination_vector,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the libfdata_vector_clone and libfdata_vector_free functions with multiple threads
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_vector_empty(
+int fdata_test_vector_clone_threaded(
      void )
 {
-	libcerror_error_t *error  = NULL;
-	libfdata_vector_t *vector = NULL;
-	int result                = 0;
+	libcthreads_thread_t *threads[ FDATA_TEST_VECTOR_NUMBER_OF_THREADS ];
+
+	libcerror_error_t *error              = NULL;
+	libfdata_vector_t *destination_vector = NULL;
+	libfdata_vector_t *source_vector      = NULL;
+	int result                            = 0;
+	int segment_index                     = 0;
+	int thread_index                      = 0;
 
+	for( thread_index = 0;
+	     thread_index < FDATA_TEST_VECTOR_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
 	/* Initialize test
 	 */
 	result = libfdata_vector_initialize(
-	          &vector,
+	          &source_vector,
 	          128,
 	          NULL,
-	          &fdata_test_vector_data_handle_free_function,
-	          &fdata_test_vector_data_handle_clone_function,
+	          NULL,
+	          NULL,
 	          &fdata_test_vector_read_element_data,
 	          NULL,
 	          0,
@@ -813,17 +1397,20 @@ int fdata_test_vector_empty(
 	 1 );
 
 	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "vector",
-	 vector );
+	 "source_vector",
+	 source_vector );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	result = libfdata_vector_empty(
-	          vector,
+	result = libfdata_vector_append_segment(
+	          source_vector,
+	          &segment_index,
+	          0,
+	          0,
+	          1024,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -835,28 +1422,85 @@ int fdata_test_vector_empty(
 	 "error",
 	 error );
 
-	/* Test error cases
+	/* Clone the vector once so that the mapped ranges are calculated before
+	 * the threads share the segments table
 	 */
-	result = libfdata_vector_empty(
-	          NULL,
+	result = libfdata_vector_clone(
+	          &destination_vector,
+	          source_vector,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libfdata_vector_free(
+	          &destination_vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the segments table references are counted correctly when
+	 * vectors that share it are cloned and freed by different threads
+	 */
+	for( thread_index = 0;
+	     thread_index < FDATA_TEST_VECTOR_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &fdata_test_vector_clone_thread_function,
+		          (void *) source_vector,
+		          &error );
+
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < FDATA_TEST_VECTOR_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_references",
+	 ( (libfdata_internal_vector_t *) source_vector )->segments_table->number_of_references,
+	 1 );
 
 	/* Clean up
 	 */
 	result = libfdata_vector_free(
-	          &vector,
+	          &source_vector,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -865,8 +1509,8 @@ int fdata_test_vector_empty(
 	 1 );
 
 	FDATA_TEST_ASSERT_IS_NULL(
-	 "vector",
-	 vector );
+	 "source_vector",
+	 source_vector );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -880,19 +1524,38 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( vector != NULL )
+	for( thread_index = 0;
+	     thread_index < FDATA_TEST_VECTOR_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( destination_vector != NULL )
 	{
 		libfdata_vector_free(
-		 &vector,
+		 &destination_vector,
+		 NULL );
+	}
+	if( source_vector != NULL )
+	{
+		libfdata_vector_free(
+		 &source_vector,
 		 NULL );
 	}
 	return( 0 );
 }
 
-/* Tests the libfdata_vector_resize function
+#endif /* defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) && defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Tests the libfdata_vector_empty function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_vector_resize(
+int fdata_test_vector_empty(
      void )
 {
 	libcerror_error_t *error  = NULL;
@@ -927,9 +1590,8 @@ int fdata_test_vector_resize(
 
 	/* Test regular cases
 	 */
-	result = libfdata_vector_resize(
+	result = libfdata_vector_empty(
 	          vector,
-	          10,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -943,26 +1605,8 @@ int fdata_test_vector_resize(
 
 	/* Test error cases
 	 */
-	result = libfdata_vector_resize(
+	result = libfdata_vector_empty(
 	          NULL,
-	          10,
-	          &error );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	result = libfdata_vector_resize(
-	          vector,
-	          -1,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1013,17 +1657,15 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_vector_get_number_of_segments function
+/* Tests the libfdata_vector_resize function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_vector_get_number_of_segments(
+int fdata_test_vector_resize(
      void )
 {
 	libcerror_error_t *error  = NULL;
 	libfdata_vector_t *vector = NULL;
-	int number_of_segments    = 0;
 	int result                = 0;
-	int segment_index         = 0;
 
 	/* Initialize test
 	 */
@@ -1053,9 +1695,9 @@ int fdata_test_vector_get_number_of_segments(
 
 	/* Test regular cases
 	 */
-	result = libfdata_vector_get_number_of_segments(
+	result = libfdata_vector_resize(
 	          vector,
-	          &number_of_segments,
+	          10,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -1063,20 +1705,146 @@ int fdata_test_vector_get_number_of_segments(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "number_of_segments",
-	 number_of_segments,
-	 0 );
-
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Initialize test
+	/* Test error cases
 	 */
-	result = libfdata_vector_append_segment(
-	          vector,
-	          &segment_index,
+	result = libfdata_vector_resize(
+	          NULL,
+	          10,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_resize(
+	          vector,
+	          -1,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_vector_get_number_of_segments function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_get_number_of_segments(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_vector_t *vector = NULL;
+	int number_of_segments    = 0;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_vector_get_number_of_segments(
+	          vector,
+	          &number_of_segments,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = libfdata_vector_append_segment(
+	          vector,
+	          &segment_index,
 	          1,
 	          1024,
 	          2048,
@@ -2066,28 +2834,47 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_vector_get_element_index_at_offset function
+/* Tests the libfdata_vector_set_number_of_elements_per_block function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_vector_get_element_index_at_offset(
+int fdata_test_vector_set_number_of_elements_per_block(
      void )
 {
-	libcerror_error_t *error    = NULL;
-	libfdata_vector_t *vector   = NULL;
-	off64_t element_data_offset = 0;
-	int element_index           = 0;
-	int result                  = 0;
-	int segment_index           = 0;
+	libcerror_error_t *error  = NULL;
+	libfdata_cache_t *cache   = NULL;
+	libfdata_vector_t *vector = NULL;
+	intptr_t *element_value   = NULL;
+	uint32_t value_32bit      = 0;
+	int result                = 0;
+	int segment_index         = 0;
 
 	/* Initialize test
 	 */
+	result = libfdata_cache_initialize(
+	          &cache,
+	          16,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfdata_vector_initialize(
 	          &vector,
 	          128,
 	          NULL,
 	          &fdata_test_vector_data_handle_free_function,
 	          &fdata_test_vector_data_handle_clone_function,
-	          &fdata_test_vector_read_element_data,
+	          &fdata_test_vector_read_block_data,
 	          NULL,
 	          0,
 	          &error );
@@ -2125,14 +2912,10 @@ int fdata_test_vector_get_element_index_at_offset(
 
 	/* Test regular cases
 	 */
-	element_index       = -1;
-	element_data_offset = -1;
-
-	result = libfdata_vector_get_element_index_at_offset(
+	result = libfdata_vector_set_number_of_elements_per_block(
 	          vector,
-	          128 + 64,
-	          &element_index,
-	          &element_data_offset,
+	          4,
+	          sizeof( uint32_t ),
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2140,101 +2923,1609 @@ int fdata_test_vector_get_element_index_at_offset(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "element_index",
-	 element_index,
-	 1 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT64(
-	 "element_data_offset",
-	 (int64_t) element_data_offset,
-	 (int64_t) 64 );
-
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	element_index       = -1;
-	element_data_offset = -1;
+	fdata_test_vector_read_block_data_number_of_calls = 0;
 
-#ifdef TODO
-/* TODO fix libfdata_vector_get_element_index_at_offset
- */
-	result = libfdata_vector_get_element_index_at_offset(
+	result = libfdata_vector_get_element_value_by_index(
 	          vector,
-	          4096,
-	          &element_index,
-	          &element_data_offset,
+	          NULL,
+	          cache,
+	          5,
+	          &element_value,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "element_index",
-	 element_index,
-	 -1 );
+	 1 );
 
-	FDATA_TEST_ASSERT_EQUAL_INT64(
-	 "element_data_offset",
-	 (int64_t) element_data_offset,
-	 (int64_t) -1 );
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
 
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
-#endif
 
-	/* Test error cases
-	 */
-	element_index       = -1;
-	element_data_offset = -1;
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
 
-	result = libfdata_vector_get_element_index_at_offset(
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 5 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_vector_read_block_data_number_of_calls",
+	 fdata_test_vector_read_block_data_number_of_calls,
+	 1 );
+
+	/* Elements in the same block are retrieved from the cached block
+	 */
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
 	          NULL,
+	          cache,
+	          7,
+	          &element_value,
 	          0,
-	          &element_index,
-	          &element_data_offset,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
 
-	result = libfdata_vector_get_element_index_at_offset(
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 7 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_vector_read_block_data_number_of_calls",
+	 fdata_test_vector_read_block_data_number_of_calls,
+	 1 );
+
+	result = libfdata_vector_get_element_value_by_index(
 	          vector,
-	          -1,
-	          &element_index,
-	          &element_data_offset,
+	          NULL,
+	          cache,
+	          15,
+	          &element_value,
+	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 15 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_vector_read_block_data_number_of_calls",
+	 fdata_test_vector_read_block_data_number_of_calls,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libfdata_vector_set_number_of_elements_per_block(
+	          NULL,
+	          4,
+	          sizeof( uint32_t ),
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_set_number_of_elements_per_block(
+	          vector,
+	          0,
+	          sizeof( uint32_t ),
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_set_number_of_elements_per_block(
+	          vector,
+	          4,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_free(
+	          &cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_vector_get_element_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_get_element_index_at_offset(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libfdata_vector_t *vector   = NULL;
+	off64_t element_data_offset = 0;
+	int element_index           = 0;
+	int result                  = 0;
+	int segment_index           = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_append_segment(
+	          vector,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	element_index       = -1;
+	element_data_offset = -1;
+
+	result = libfdata_vector_get_element_index_at_offset(
+	          vector,
+	          128 + 64,
+	          &element_index,
+	          &element_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "element_index",
+	 element_index,
+	 1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "element_data_offset",
+	 (int64_t) element_data_offset,
+	 (int64_t) 64 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	element_index       = -1;
+	element_data_offset = -1;
+
+#ifdef TODO
+/* TODO fix libfdata_vector_get_element_index_at_offset
+ */
+	result = libfdata_vector_get_element_index_at_offset(
+	          vector,
+	          4096,
+	          &element_index,
+	          &element_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "element_index",
+	 element_index,
+	 -1 );
+
+	FDATA_TEST_ASSERT_EQUAL_INT64(
+	 "element_data_offset",
+	 (int64_t) element_data_offset,
+	 (int64_t) -1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#endif
+
+	/* Test error cases
+	 */
+	element_index       = -1;
+	element_data_offset = -1;
+
+	result = libfdata_vector_get_element_index_at_offset(
+	          NULL,
+	          0,
+	          &element_index,
+	          &element_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_get_element_index_at_offset(
+	          vector,
+	          -1,
+	          &element_index,
+	          &element_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_get_element_index_at_offset(
+	          vector,
+	          0,
+	          NULL,
+	          &element_data_offset,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_get_element_index_at_offset(
+	          vector,
+	          0,
+	          &element_index,
+	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_vector_get_element_value_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_get_element_value_by_index(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_cache_t *cache   = NULL;
+	libfdata_vector_t *vector = NULL;
+	intptr_t *element_value   = NULL;
+	int result                = 0;
+	int segment_index         = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_cache_initialize(
+	          &cache,
+	          16,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_append_segment(
+	          vector,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 element_value );
+
+	element_value = NULL;
+
+	/* Test error cases
+	 */
+	result = libfdata_vector_get_element_value_by_index(
+	          NULL,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_free(
+	          &cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_vector_get_element_value_by_index function with values stored by the read element data function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_get_element_value_by_index_read_element_value(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfdata_cache_t *cache          = NULL;
+	libfdata_cache_t *single_cache   = NULL;
+	libfdata_vector_t *nested_vector = NULL;
+	libfdata_vector_t *vector        = NULL;
+	intptr_t *element_value          = NULL;
+	uint32_t value_32bit             = 0;
+	int result                       = 0;
+	int segment_index                = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_cache_initialize(
+	          &cache,
+	          16,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_initialize(
+	          &single_cache,
+	          1,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "single_cache",
+	 single_cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the value stored by the read element data function is returned
+	 * without looking it up in the cache, which was cleared after it was stored
+	 */
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data_and_clear_cache,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_append_segment(
+	          vector,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          cache,
+	          0,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0 );
+
+	memory_free(
+	 element_value );
+
+	element_value = NULL;
+
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the value is looked up in the cache after another value was stored
+	 */
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data_and_store_next_value,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_append_segment(
+	          vector,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          cache,
+	          0,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0 );
+
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a nested read of the same vector
+	 */
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data_and_read_nested,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_append_segment(
+	          vector,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fdata_test_vector_nested_vector = vector;
+
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          cache,
+	          0,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0 );
+
+	/* Test a nested read of the same vector that evicts the value
+	 */
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          single_cache,
+	          2,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a nested read of another vector that shares the cache
+	 */
+	fdata_test_vector_read_element_data_free_element_value = 1;
+
+	result = libfdata_vector_initialize(
+	          &nested_vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "nested_vector",
+	 nested_vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_append_segment(
+	          nested_vector,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	fdata_test_vector_nested_vector = nested_vector;
+
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          cache,
+	          4,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 (uint8_t *) element_value,
+	 value_32bit );
+
+	FDATA_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 4 );
+
+	/* Test a nested read of another vector that shares the cache and evicts the value
+	 */
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          single_cache,
+	          6,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	fdata_test_vector_nested_vector                        = NULL;
+	fdata_test_vector_read_element_data_free_element_value = 0;
+
+	/* Clean up
+	 */
+	result = libfdata_vector_free(
+	          &nested_vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "nested_vector",
+	 nested_vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_free(
+	          &single_cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "single_cache",
+	 single_cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_free(
+	          &cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	fdata_test_vector_nested_vector                        = NULL;
+	fdata_test_vector_read_element_data_free_element_value = 0;
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( nested_vector != NULL )
+	{
+		libfdata_vector_free(
+		 &nested_vector,
+		 NULL );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	if( single_cache != NULL )
+	{
+		libfdata_cache_free(
+		 &single_cache,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_vector_get_element_value_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_get_element_value_at_offset(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libfdata_cache_t *cache     = NULL;
+	libfdata_vector_t *vector   = NULL;
+	intptr_t *element_value     = NULL;
+	off64_t element_data_offset = 0;
+	int result                  = 0;
+	int segment_index           = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_cache_initialize(
+	          &cache,
+	          16,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_append_segment(
+	          vector,
+	          &segment_index,
+	          1,
+	          1024,
+	          2048,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_at_offset(
+	          vector,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_data_offset,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 element_value );
+
+	element_value = NULL;
+
+	/* Test error cases
+	 */
+	result = libfdata_vector_get_element_value_at_offset(
+	          NULL,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_data_offset,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_get_element_value_at_offset(
+	          vector,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          NULL,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_get_element_value_at_offset(
+	          vector,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_data_offset,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_cache_free(
+	          &cache,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	if( cache != NULL )
+	{
+		libfdata_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_vector_set_element_value_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_set_element_value_by_index(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_vector_t *vector = NULL;
+	int result                = 0;
+	int value1                = 1;
+
+	/* Initialize test
+	 */
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data,
+	          NULL,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libfdata_vector_set_element_value_by_index(
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          (intptr_t *) &value1,
+	          &fdata_test_vector_element_value_free_function,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
 	 &error );
 
-	result = libfdata_vector_get_element_index_at_offset(
-	          vector,
+	/* Clean up
+	 */
+	result = libfdata_vector_free(
+	          &vector,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( vector != NULL )
+	{
+		libfdata_vector_free(
+		 &vector,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfdata_vector_set_element_value_pool function
+ * Returns 1 if successful or 0 if not
+ */
+int fdata_test_vector_set_element_value_pool(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libfdata_vector_t *vector = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libfdata_vector_initialize(
+	          &vector,
+	          128,
+	          NULL,
+	          &fdata_test_vector_data_handle_free_function,
+	          &fdata_test_vector_data_handle_clone_function,
+	          &fdata_test_vector_read_element_data,
+	          NULL,
 	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "vector",
+	 vector );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_vector_set_element_value_pool(
 	          NULL,
-	          &element_data_offset,
+	          4,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2249,11 +4540,44 @@ int fdata_test_vector_get_element_index_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_vector_get_element_index_at_offset(
+	result = libfdata_vector_set_element_value_pool(
 	          vector,
 	          0,
-	          &element_index,
-	          NULL,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libfdata_vector_set_element_value_pool(
+	          vector,
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfdata_vector_set_element_value_pool(
+	          vector,
+	          4,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2304,10 +4628,10 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_vector_get_element_value_by_index function
+/* Tests the libfdata_vector_get_recycled_element_value function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_vector_get_element_value_by_index(
+int fdata_test_vector_get_recycled_element_value(
      void )
 {
 	libcerror_error_t *error  = NULL;
@@ -2321,7 +4645,7 @@ int fdata_test_vector_get_element_value_by_index(
 	 */
 	result = libfdata_cache_initialize(
 	          &cache,
-	          16,
+	          1,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2379,17 +4703,107 @@ int fdata_test_vector_get_element_value_by_index(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
+	/* The recycled element values are freed by the value pool
+	 */
+	fdata_test_vector_read_element_data_free_element_value = 1;
+
+	/* Test regular cases
+	 */
+	result = libfdata_vector_get_recycled_element_value(
+	          vector,
+	          &element_value,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_set_element_value_pool(
+	          vector,
+	          4,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_get_recycled_element_value(
+	          vector,
+	          &element_value,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reading element 1 evicts element 0 from the single entry cache
+	 */
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	element_value = NULL;
+
+	result = libfdata_vector_get_element_value_by_index(
+	          vector,
+	          NULL,
+	          (libfdata_cache_t *) cache,
+	          1,
+	          &element_value,
+	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "element_value",
+	 element_value );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	element_value = NULL;
 
-	result = libfdata_vector_get_element_value_by_index(
+	result = libfdata_vector_get_recycled_element_value(
 	          vector,
-	          NULL,
-	          (libfdata_cache_t *) cache,
-	          0,
 	          &element_value,
-	          0,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2410,15 +4824,42 @@ int fdata_test_vector_get_element_value_by_index(
 
 	element_value = NULL;
 
+	result = libfdata_vector_get_recycled_element_value(
+	          vector,
+	          &element_value,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FDATA_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test error cases
 	 */
-	result = libfdata_vector_get_element_value_by_index(
-	          NULL,
+	result = libfdata_vector_get_recycled_element_value(
 	          NULL,
-	          (libfdata_cache_t *) cache,
-	          0,
 	          &element_value,
-	          0,
+	          &error );
+
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FDATA_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfdata_vector_get_recycled_element_value(
+	          vector,
+	          NULL,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2469,6 +4910,8 @@ int fdata_test_vector_get_element_value_by_index(
 	 "error",
 	 error );
 
+	fdata_test_vector_read_element_data_free_element_value = 0;
+
 	return( 1 );
 
 on_error:
@@ -2489,22 +4932,24 @@ on_error:
 		 &cache,
 		 NULL );
 	}
+	fdata_test_vector_read_element_data_free_element_value = 0;
+
 	return( 0 );
 }
 
-/* Tests the libfdata_vector_get_element_value_at_offset function
+/* Tests the libfdata_vector_invalidate_cached_range function
  * Returns 1 if successful or 0 if not
  */
-int fdata_test_vector_get_element_value_at_offset(
+int fdata_test_vector_invalidate_cached_range(
      void )
 {
-	libcerror_error_t *error    = NULL;
-	libfdata_cache_t *cache     = NULL;
-	libfdata_vector_t *vector   = NULL;
-	intptr_t *element_value     = NULL;
-	off64_t element_data_offset = 0;
-	int result                  = 0;
-	int segment_index           = 0;
+	libcerror_error_t *error  = NULL;
+	libfdata_cache_t *cache   = NULL;
+	libfdata_vector_t *vector = NULL;
+	intptr_t *element_value   = NULL;
+	int element_index         = 0;
+	int result                = 0;
+	int segment_index         = 0;
 
 	/* Initialize test
 	 */
@@ -2532,7 +4977,7 @@ int fdata_test_vector_get_element_value_at_offset(
 	          NULL,
 	          &fdata_test_vector_data_handle_free_function,
 	          &fdata_test_vector_data_handle_clone_function,
-	          &fdata_test_vector_read_element_data,
+	          &fdata_test_vector_read_block_data,
 	          NULL,
 	          0,
 	          &error );
@@ -2568,18 +5013,43 @@ int fdata_test_vector_get_element_value_at_offset(
 	 "error",
 	 error );
 
+	fdata_test_vector_read_block_data_number_of_calls = 0;
+
+	for( element_index = 0;
+	     element_index < 3;
+	     element_index++ )
+	{
+		result = libfdata_vector_get_element_value_by_index(
+		          vector,
+		          NULL,
+		          cache,
+		          element_index,
+		          &element_value,
+		          0,
+		          &error );
+
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_vector_read_block_data_number_of_calls",
+	 fdata_test_vector_read_block_data_number_of_calls,
+	 3 );
+
 	/* Test regular cases
 	 */
-	element_value = NULL;
-
-	result = libfdata_vector_get_element_value_at_offset(
+	result = libfdata_vector_invalidate_cached_range(
 	          vector,
-	          NULL,
-	          (libfdata_cache_t *) cache,
-	          0,
-	          &element_data_offset,
-	          &element_value,
-	          0,
+	          cache,
+	          1,
+	          1024 + 200,
+	          8,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2587,29 +5057,47 @@ int fdata_test_vector_get_element_value_at_offset(
 	 result,
 	 1 );
 
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "element_value",
-	 element_value );
-
 	FDATA_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	memory_free(
-	 element_value );
+	/* Only the value of element 1 overlaps with the invalidated range
+	 */
+	for( element_index = 0;
+	     element_index < 3;
+	     element_index++ )
+	{
+		result = libfdata_vector_get_element_value_by_index(
+		          vector,
+		          NULL,
+		          cache,
+		          element_index,
+		          &element_value,
+		          0,
+		          &error );
 
-	element_value = NULL;
+		FDATA_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FDATA_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FDATA_TEST_ASSERT_EQUAL_INT(
+	 "fdata_test_vector_read_block_data_number_of_calls",
+	 fdata_test_vector_read_block_data_number_of_calls,
+	 4 );
 
 	/* Test error cases
 	 */
-	result = libfdata_vector_get_element_value_at_offset(
-	          NULL,
+	result = libfdata_vector_invalidate_cached_range(
 	          NULL,
-	          (libfdata_cache_t *) cache,
-	          0,
-	          &element_data_offset,
-	          &element_value,
-	          0,
+	          cache,
+	          1,
+	          1024,
+	          128,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2624,14 +5112,12 @@ int fdata_test_vector_get_element_value_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_vector_get_element_value_at_offset(
+	result = libfdata_vector_invalidate_cached_range(
 	          vector,
 	          NULL,
-	          (libfdata_cache_t *) cache,
-	          0,
-	          NULL,
-	          &element_value,
-	          0,
+	          1,
+	          1024,
+	          128,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2646,14 +5132,12 @@ int fdata_test_vector_get_element_value_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libfdata_vector_get_element_value_at_offset(
+	result = libfdata_vector_invalidate_cached_range(
 	          vector,
-	          NULL,
-	          (libfdata_cache_t *) cache,
-	          0,
-	          &element_data_offset,
-	          NULL,
-	          0,
+	          cache,
+	          1,
+	          -1,
+	          128,
 	          &error );
 
 	FDATA_TEST_ASSERT_EQUAL_INT(
@@ -2727,107 +5211,6 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfdata_vector_set_element_value_by_index function
- * Returns 1 if successful or 0 if not
- */
-int fdata_test_vector_set_element_value_by_index(
-     void )
-{
-	libcerror_error_t *error  = NULL;
-	libfdata_vector_t *vector = NULL;
-	int result                = 0;
-	int value1                = 1;
-
-	/* Initialize test
-	 */
-	result = libfdata_vector_initialize(
-	          &vector,
-	          128,
-	          NULL,
-	          &fdata_test_vector_data_handle_free_function,
-	          &fdata_test_vector_data_handle_clone_function,
-	          &fdata_test_vector_read_element_data,
-	          NULL,
-	          0,
-	          &error );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "vector",
-	 vector );
-
-	FDATA_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
-	/* Test regular cases
-	 */
-/* TODO implement */
-
-	/* Test error cases
-	 */
-	result = libfdata_vector_set_element_value_by_index(
-	          NULL,
-	          NULL,
-	          NULL,
-	          0,
-	          (intptr_t *) &value1,
-	          &fdata_test_vector_element_value_free_function,
-	          0,
-	          &error );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	FDATA_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	/* Clean up
-	 */
-	result = libfdata_vector_free(
-	          &vector,
-	          &error );
-
-	FDATA_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	FDATA_TEST_ASSERT_IS_NULL(
-	 "vector",
-	 vector );
-
-	FDATA_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( vector != NULL )
-	{
-		libfdata_vector_free(
-		 &vector,
-		 NULL );
-	}
-	return( 0 );
-}
-
 /* Tests the libfdata_vector_get_size function
  * Returns 1 if successful or 0 if not
  */
@@ -2996,6 +5379,14 @@ int main(
 	 "libfdata_vector_initialize",
 	 fdata_test_vector_initialize );
 
+#if defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) && defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	FDATA_TEST_RUN(
+	 "libfdata_vector_initialize_threaded",
+	 fdata_test_vector_initialize_threaded );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) && defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	FDATA_TEST_RUN(
 	 "libfdata_vector_free",
 	 fdata_test_vector_free );
@@ -3004,6 +5395,14 @@ int main(
 	 "libfdata_vector_clone",
 	 fdata_test_vector_clone );
 
+#if defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) && defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	FDATA_TEST_RUN(
+	 "libfdata_vector_clone_threaded",
+	 fdata_test_vector_clone_threaded );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFDATA_DLL_IMPORT ) && defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	FDATA_TEST_RUN(
 	 "libfdata_vector_empty",
 	 fdata_test_vector_empty );
@@ -3040,6 +5439,10 @@ int main(
 	 "libfdata_vector_get_number_of_elements",
 	 fdata_test_vector_get_number_of_elements );
 
+	FDATA_TEST_RUN(
+	 "libfdata_vector_set_number_of_elements_per_block",
+	 fdata_test_vector_set_number_of_elements_per_block );
+
 	FDATA_TEST_RUN(
 	 "libfdata_vector_get_element_index_at_offset",
 	 fdata_test_vector_get_element_index_at_offset );
@@ -3048,6 +5451,10 @@ int main(
 	 "libfdata_vector_get_element_value_by_index",
 	 fdata_test_vector_get_element_value_by_index );
 
+	FDATA_TEST_RUN(
+	 "libfdata_vector_get_element_value_by_index_read_element_value",
+	 fdata_test_vector_get_element_value_by_index_read_element_value );
+
 	FDATA_TEST_RUN(
 	 "libfdata_vector_get_element_value_at_offset",
 	 fdata_test_vector_get_element_value_at_offset );
@@ -3056,6 +5463,18 @@ int main(
 	 "libfdata_vector_set_element_value_by_index",
 	 fdata_test_vector_set_element_value_by_index );
 
+	FDATA_TEST_RUN(
+	 "libfdata_vector_set_element_value_pool",
+	 fdata_test_vector_set_element_value_pool );
+
+	FDATA_TEST_RUN(
+	 "libfdata_vector_get_recycled_element_value",
+	 fdata_test_vector_get_recycled_element_value );
+
+	FDATA_TEST_RUN(
+	 "libfdata_vector_invalidate_cached_range",
+	 fdata_test_vector_invalidate_cached_range );
+
 	FDATA_TEST_RUN(
 	 "libfdata_vector_get_size",
 	 fdata_test_vector_get_size );
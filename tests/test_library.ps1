@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "area cache error list list_element mapped_range notify range range_list stream support vector"
+$LibraryTests = "allocator area cache error list list_element mapped_range notify range range_list stream support vector"
 $LibraryTestsWithInput = ""
 $OptionSets = ""
 